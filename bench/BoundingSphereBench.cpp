@@ -0,0 +1,137 @@
+// BoundingSphereBench.cpp
+//
+// Compares Ritter's bounding sphere (Object3D::bsphere) with the minimum
+// bounding sphere (Object3D::tighten_bsphere, geometry::BoundingSphere) on
+// data/humanoid.geo and generated meshes: construction time, radius, and how
+// many placements of the mesh around a frustum each sphere culls, against the
+// placements where every vertex is behind the same plane.
+// Run from the repository root so that data/humanoid.geo is found.
+
+#include "bench.h"
+#include "scene/Object3D.hpp"
+#include "scene/Frustum.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace scene;
+
+static std::vector<Point<real, 3>> load( const std::string & name )
+{
+    std::vector<Point<real, 3>> points;
+    std::ifstream file( name );
+    std::size_t count { 0 };
+    file >> count;
+    for( std::size_t i { 0 }; i < count && file; ++i )
+    {
+        real x, y, z;
+        file >> x >> y >> z;
+        points.push_back( Point<real, 3> { x, y, z } );
+    }
+    return points;
+}
+
+//! Points on an ellipsoid of axes 3, 1 and 0.5, pushed out by up to 10%.
+static std::vector<Point<real, 3>> ellipsoid( const std::size_t count )
+{
+    std::mt19937 random { 1 };
+    std::normal_distribution<real> normal;
+    std::uniform_real_distribution<real> noise { 1, 1.1f };
+    std::vector<Point<real, 3>> points;
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        const real x { normal( random ) }, y { normal( random ) }, z { normal( random ) };
+        const real scale { noise( random ) / std::sqrt( x * x + y * y + z * z ) };
+        points.push_back( Point<real, 3> { 3 * x * scale, y * scale, 0.5f * z * scale } );
+    }
+    return points;
+}
+
+//! Points filling a box, with a few outliers along one diagonal.
+static std::vector<Point<real, 3>> box( const std::size_t count )
+{
+    std::mt19937 random { 2 };
+    std::uniform_real_distribution<real> uniform { -1, 1 };
+    std::vector<Point<real, 3>> points;
+    for( std::size_t i { 0 }; i < count; ++i )
+        points.push_back( i % 1000 == 0 ? Point<real, 3> { 1.5f, 1.5f, uniform( random ) }
+                                        : Point<real, 3> { uniform( random ), 2 * uniform( random ), uniform( random ) } );
+    return points;
+}
+
+static void compare( const std::string & name, const std::vector<Point<real, 3>> & points )
+{
+    std::cout << name << ", " << points.size() << " vertices" << std::endl;
+    if( points.empty() )
+    {
+        std::cout << "  no vertex, skipped" << std::endl << std::endl;
+        return;
+    }
+
+    Sphere<real> ritter, tight;
+    const double loose = run_bench( "ritter", 5, [&]() {
+        Object3D o( const_cast<std::vector<Point<real, 3>> &>( points ) );
+        ritter = o.bsphere();
+        keep( ritter );
+    } );
+    const double exact = run_bench( "minimum sphere", 5, [&]() {
+        Object3D o( const_cast<std::vector<Point<real, 3>> &>( points ) );
+        o.tighten_bsphere();
+        tight = o.bsphere();
+        keep( tight );
+    } );
+    std::cout << "  radius : " << ritter.getRadius() << " -> " << tight.getRadius() << " (volume x"
+              << std::pow( tight.getRadius() / ritter.getRadius(), 3 ) << ")" << std::endl;
+    print_gain( "minimum sphere", loose, exact );
+
+    // Placements du maillage sur une grille qui deborde du champ de vision
+    const real size { tight.getRadius() };
+    const Frustum f {
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0, -1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, -40 * size }, Direction<real, 3> { 0, 0, 1 } ),
+        Plane<real>( Point<real, 3> { -8 * size, 0, 0 }, Direction<real, 3> { 1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 8 * size, 0, 0 }, Direction<real, 3> { -1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 0, 8 * size, 0 }, Direction<real, 3> { 0, -1, 0 } ),
+        Plane<real>( Point<real, 3> { 0, -8 * size, 0 }, Direction<real, 3> { 0, 1, 0 } )
+    };
+    float eq[24];
+    f.equations( eq );
+
+    const std::size_t step { std::max<std::size_t>( 1, points.size() / 4096 ) };
+    std::size_t placements { 0 }, offscreen { 0 }, ritterCulled { 0 }, tightCulled { 0 };
+    for( int i { -120 }; i <= 120; ++i )
+        for( int j { -120 }; j <= 120; ++j )
+        {
+            const math::Vector<real, 3> offset { 0.1f * size * i, 0.1f * size * j, -20 * size };
+            ++placements;
+            ritterCulled += f.outside( Sphere<real>( ritter.getCenter() + offset, ritter.getRadius() ) );
+            tightCulled += f.outside( Sphere<real>( tight.getCenter() + offset, tight.getRadius() ) );
+
+            // Hors champ si tous les sommets (un sur step) sont derriere un meme plan
+            bool behind { false };
+            for( int k { 0 }; k < 6 && !behind; ++k )
+            {
+                behind = true;
+                for( std::size_t v { 0 }; v < points.size() && behind; v += step )
+                    behind = eq[4 * k] * ( points[v][0] + offset[0] ) + eq[4 * k + 1] * ( points[v][1] + offset[1] )
+                             + eq[4 * k + 2] * ( points[v][2] + offset[2] ) + eq[4 * k + 3] < 0;
+            }
+            offscreen += behind;
+        }
+    std::cout << "  culled placements : ritter " << ritterCulled << ", minimum sphere " << tightCulled
+              << ", off-screen (sampled vertices) " << offscreen << " of " << placements << std::endl << std::endl;
+}
+
+int main()
+{
+    compare( "humanoid.geo", load( "data/humanoid.geo" ) );
+    compare( "ellipsoid", ellipsoid( 20000 ) );
+    compare( "box with outliers", box( 20000 ) );
+    compare( "ellipsoid", ellipsoid( 1000000 ) );
+    compare( "box with outliers", box( 1000000 ) );
+
+    return 0;
+}
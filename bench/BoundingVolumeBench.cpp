@@ -0,0 +1,220 @@
+// BoundingVolumeBench.cpp
+//
+// Compares the bounding volumes tested against a frustum: the sphere, the
+// axis-aligned box (geometry::AABB) and the oriented box (geometry::OBB),
+// the boxes being tested against the six planes at once in SIMD lanes.
+// Reports the time per test, then, on data/humanoid.geo and generated meshes
+// tilted in the world, how many placements of the mesh around a frustum each
+// volume culls, against the placements where every vertex is behind the same
+// plane. Run from the repository root so that data/humanoid.geo is found.
+
+#include "bench.h"
+#include "scene/Object3D.hpp"
+#include "scene/Frustum.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace scene;
+
+static Frustum view( const real size )
+{
+    return Frustum {
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0, -1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, -40 * size }, Direction<real, 3> { 0, 0, 1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0.8f, 0, -0.6f } ),
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { -0.8f, 0, -0.6f } ),
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, -0.8f, -0.6f } ),
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0.8f, -0.6f } )
+    };
+}
+
+//! Former Sphere::behind, testing the two corners of the box along (1, 1, 1).
+static bool corners_behind( const Sphere<real> & s, const Plane<real> & p )
+{
+    const Point<real, 3> c { s.getCenter() };
+    const real r { s.getRadius() };
+    return p.isFrontOf( Point<real, 3> { c[0] - r, c[1] - r, c[2] - r } ) && p.isFrontOf( Point<real, 3> { c[0] + r, c[1] + r, c[2] + r } );
+}
+
+static void time_tests()
+{
+    const std::size_t count { 4096 };
+    const Frustum f { view( 1 ) };
+    std::mt19937 random { 1 };
+    std::uniform_real_distribution<real> position { -30, 30 }, size { 0.1f, 2 }, axis { -1, 1 };
+
+    std::vector<Sphere<real>> spheres;
+    std::vector<AABB<real>> boxes;
+    std::vector<OBB<real>> oriented;
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        const Point<real, 3> c { position( random ), position( random ), position( random ) - 20 };
+        const math::Vector<real, 3> e { size( random ), size( random ), size( random ) };
+        const Direction<real, 3> u { Direction<real, 3> { axis( random ), axis( random ), axis( random ) }.to_unit() };
+        const Direction<real, 3> v { Direction<real, 3> { -u[1], u[0], 0 }.to_unit() };
+        const Direction<real, 3> w { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+        spheres.push_back( Sphere<real>( c, std::sqrt( real( e * e ) ) ) );
+        boxes.push_back( AABB<real>( c, e ) );
+        oriented.push_back( OBB<real>( c, u, v, w, e ) );
+    }
+
+    std::vector<std::uint8_t> result( count );
+    std::cout << "Frustum tests, ns per volume" << std::endl;
+    const auto per = [&]( const std::string & name, std::function<void()> f ) {
+        const double ns { run_bench( name, 200, f ) / count };
+        std::cout << "    " << ns << " ns per test" << std::endl;
+        return ns;
+    };
+
+    const double corners { per( "sphere, two corners (former behind)", [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            result[i] = corners_behind( spheres[i], f.GetNear() ) || corners_behind( spheres[i], f.GetFar() )
+                        || corners_behind( spheres[i], f.GetLeft() ) || corners_behind( spheres[i], f.GetRight() )
+                        || corners_behind( spheres[i], f.GetTop() ) || corners_behind( spheres[i], f.GetBottom() );
+        keep( result );
+    } ) };
+    const double exact { per( "sphere, exact behind", [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            result[i] = f.outside( spheres[i] );
+        keep( result );
+    } ) };
+    per( "sphere, batched kernel", [&]() {
+        f.outside( spheres.data(), count, result.data() );
+        keep( result );
+    } );
+    const double box { per( "aabb, one at a time", [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            result[i] = f.outside( boxes[i] );
+        keep( result );
+    } ) };
+    const double boxBatch { per( "aabb, batched", [&]() {
+        f.outside( boxes.data(), count, result.data() );
+        keep( result );
+    } ) };
+    const double obbBatch { per( "obb, batched", [&]() {
+        f.outside( oriented.data(), count, result.data() );
+        keep( result );
+    } ) };
+    print_gain( "exact sphere over two corners", corners, exact );
+    print_gain( "batched aabb over one at a time", box, boxBatch );
+    print_gain( "batched obb over exact sphere", exact, obbBatch );
+}
+
+static std::vector<Point<real, 3>> load( const std::string & name )
+{
+    std::vector<Point<real, 3>> points;
+    std::ifstream file( name );
+    std::size_t count { 0 };
+    file >> count;
+    for( std::size_t i { 0 }; i < count && file; ++i )
+    {
+        real x, y, z;
+        file >> x >> y >> z;
+        points.push_back( Point<real, 3> { x, y, z } );
+    }
+    return points;
+}
+
+//! Points on a rod of length 10 and radius 0.3.
+static std::vector<Point<real, 3>> rod( const std::size_t count )
+{
+    std::mt19937 random { 2 };
+    std::uniform_real_distribution<real> along { -5, 5 }, angle { 0, 6.2831853f };
+    std::vector<Point<real, 3>> points;
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        const real a { angle( random ) };
+        points.push_back( Point<real, 3> { along( random ), 0.3f * std::cos( a ), 0.3f * std::sin( a ) } );
+    }
+    return points;
+}
+
+//! Points filling a flat slab of 6 x 6 x 0.2.
+static std::vector<Point<real, 3>> slab( const std::size_t count )
+{
+    std::mt19937 random { 3 };
+    std::uniform_real_distribution<real> side { -3, 3 }, thickness { -0.1f, 0.1f };
+    std::vector<Point<real, 3>> points;
+    for( std::size_t i { 0 }; i < count; ++i )
+        points.push_back( Point<real, 3> { side( random ), side( random ), thickness( random ) } );
+    return points;
+}
+
+static void cull( const std::string & name, const std::vector<Point<real, 3>> & mesh )
+{
+    std::cout << name << ", " << mesh.size() << " vertices, tilted" << std::endl;
+    if( mesh.empty() )
+    {
+        std::cout << "  no vertex, skipped" << std::endl << std::endl;
+        return;
+    }
+
+    // Le maillage est penche dans le monde, ce qui grossit sa boite alignee
+    const Affine3x4<real> tilt { Quaternion<real>( 35, Direction<real, 3> { 1, 2, 0.5f }.to_unit() ) };
+    std::vector<Point<real, 3>> points;
+    for( const Point<real, 3> & p : mesh )
+        points.push_back( tilt.transform( p ) );
+
+    Object3D o( points );
+    o.tighten_bsphere();
+    const Sphere<real> sphere { o.bsphere() };
+    const AABB<real> box { o.aabb() };
+    const OBB<real> oriented { o.obb() };
+    const char * names[] = { "sphere", "aabb", "obb" };
+    std::cout << "  volume : sphere " << 4 * std::acos( -1.f ) / 3 * std::pow( sphere.getRadius(), 3 ) << ", aabb " << box.volume()
+              << ", obb " << oriented.volume() << ", tightest " << names[o.tightest_volume()] << std::endl;
+
+    const real size { sphere.getRadius() };
+    const Frustum f { view( size ) };
+    float eq[24];
+    f.equations( eq );
+
+    const std::size_t step { std::max<std::size_t>( 1, points.size() / 4096 ) };
+    std::size_t placements { 0 }, offscreen { 0 }, sphereCulled { 0 }, boxCulled { 0 }, orientedCulled { 0 }, tightestCulled { 0 };
+    for( int i { -60 }; i <= 60; ++i )
+        for( int j { -60 }; j <= 60; ++j )
+        {
+            const Affine3x4<real> move { Affine3x4<real>::createTranslation( 0.25f * size * i, 0.25f * size * j, -8 * size ) };
+            ++placements;
+            const bool bySphere { f.outside( move.transform( sphere ) ) };
+            const bool byBox { f.outside( box.transform( move ) ) };
+            const bool byOriented { f.outside( oriented.transform( move ) ) };
+            sphereCulled += bySphere;
+            boxCulled += byBox;
+            orientedCulled += byOriented;
+            const bool culled[] = { bySphere, byBox, byOriented };
+            tightestCulled += culled[o.tightest_volume()];
+
+            // Hors champ si tous les sommets (un sur step) sont derriere un meme plan
+            bool behind { false };
+            for( int k { 0 }; k < 6 && !behind; ++k )
+            {
+                behind = true;
+                for( std::size_t v { 0 }; v < points.size() && behind; v += step )
+                {
+                    const Point<real, 3> p { move.transform( points[v] ) };
+                    behind = eq[4 * k] * p[0] + eq[4 * k + 1] * p[1] + eq[4 * k + 2] * p[2] + eq[4 * k + 3] < 0;
+                }
+            }
+            offscreen += behind;
+        }
+    std::cout << "  culled placements : sphere " << sphereCulled << ", aabb " << boxCulled << ", obb " << orientedCulled
+              << ", tightest " << tightestCulled << ", off-screen (sampled vertices) " << offscreen << " of " << placements
+              << std::endl << std::endl;
+}
+
+int main()
+{
+    time_tests();
+
+    cull( "humanoid.geo", load( "data/humanoid.geo" ) );
+    cull( "rod", rod( 20000 ) );
+    cull( "slab", slab( 20000 ) );
+
+    return 0;
+}
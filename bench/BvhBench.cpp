@@ -0,0 +1,89 @@
+// BvhBench.cpp
+//
+// Compares frustum culling of 100k bounding spheres one batch at a time
+// (Frustum::outside over the whole array) with the traversal of a Bvh built
+// over the same spheres, for a narrow and a wide field of view, and measures
+// the cost of building and refitting the hierarchy.
+
+#include "bench.h"
+#include "scene/Bvh.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace scene;
+
+static Frustum box( const real half )
+{
+    return Frustum {
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0, -1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, -500 }, Direction<real, 3> { 0, 0, 1 } ),
+        Plane<real>( Point<real, 3> { -half, 0, 0 }, Direction<real, 3> { 1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { half, 0, 0 }, Direction<real, 3> { -1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 0, half, 0 }, Direction<real, 3> { 0, -1, 0 } ),
+        Plane<real>( Point<real, 3> { 0, -half, 0 }, Direction<real, 3> { 0, 1, 0 } )
+    };
+}
+
+static real random( const real min, const real max )
+{
+    return min + ( max - min ) * std::rand() / static_cast<real>( RAND_MAX );
+}
+
+int main()
+{
+    const std::size_t objects { 100000 };
+
+    std::vector<Sphere<real>> spheres;
+    for( std::size_t i { 0 }; i < objects; ++i )
+        spheres.push_back( Sphere<real>( Point<real, 3> { random( -500, 500 ), random( -500, 500 ), random( -1000, 0 ) },
+                                         random( 0.5f, 2 ) ) );
+
+    std::cout << objects << " objects" << std::endl;
+
+    Bvh bvh;
+    run_bench( "build", 5, [&]() {
+        bvh.build( spheres.data(), spheres.size() );
+        keep( bvh.num_nodes() );
+    } );
+    std::cout << bvh.num_nodes() << " nodes" << std::endl;
+
+    std::size_t moved { 0 };
+    run_bench( "refit 1000 moved objects", 20, [&]() {
+        for( std::size_t i { 0 }; i < 1000; ++i, moved = ( moved + 97 ) % objects )
+        {
+            Sphere<real> s = spheres[moved];
+            s.setCenter( s.getCenter() + math::Vector<real, 3> { 0.01f, 0, 0 } );
+            bvh.refit( moved, s );
+        }
+        keep( moved );
+    } );
+    bvh.build( spheres.data(), spheres.size() );
+
+    std::vector<std::uint8_t> outside( objects );
+    std::vector<std::size_t> visible;
+    for( const real half : { 20.f, 400.f } )
+    {
+        const Frustum f { box( half ) };
+        std::size_t seen { 0 };
+
+        const double linear = run_bench( "linear", 20, [&]() {
+            f.outside( spheres.data(), spheres.size(), outside.data() );
+            visible.clear();
+            for( std::size_t i { 0 }; i < objects; ++i )
+                if( !outside[i] )
+                    visible.push_back( i );
+            keep( visible.size() );
+        } );
+        seen = visible.size();
+
+        const double hierarchy = run_bench( "bvh", 20, [&]() {
+            bvh.cull( f, visible );
+            keep( visible.size() );
+        } );
+        std::cout << "field of view +/-" << half << ": " << seen << " visible, " << visible.size() << " found by the bvh" << std::endl;
+        print_gain( "bvh", linear, hierarchy );
+    }
+
+    return 0;
+}
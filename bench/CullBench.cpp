@@ -0,0 +1,76 @@
+// CullBench.cpp
+//
+// Compares the two ways of testing the instances of a shared mesh against the
+// camera frustum: transforming the mesh vertices of every instance into world
+// space, or transforming the six frustum planes into each instance's local
+// space (Frustum::local) and testing the untransformed vertices.
+
+#include "bench.h"
+#include "scene/Frustum.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace scene;
+
+int main()
+{
+    const std::size_t vertices { 2048 }, instances { 256 };
+
+    const Frustum f {
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0, -1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, -100 }, Direction<real, 3> { 0, 0, 1 } ),
+        Plane<real>( Point<real, 3> { -20, 0, 0 }, Direction<real, 3> { 1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 20, 0, 0 }, Direction<real, 3> { -1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 0, 20, 0 }, Direction<real, 3> { 0, -1, 0 } ),
+        Plane<real>( Point<real, 3> { 0, -20, 0 }, Direction<real, 3> { 0, 1, 0 } )
+    };
+
+    VertexStream<real> mesh( vertices ), moved;
+    for( std::size_t i { 0 }; i < vertices; ++i )
+        mesh.set( i, Point<real, 3> { std::rand() / static_cast<real>( RAND_MAX ) - 0.5f,
+                                      std::rand() / static_cast<real>( RAND_MAX ) - 0.5f,
+                                      std::rand() / static_cast<real>( RAND_MAX ) - 0.5f } );
+
+    std::vector<Affine3x4<real>> worlds;
+    for( std::size_t i { 0 }; i < instances; ++i )
+        worlds.push_back( Affine3x4<real>( Quaternion<real>( 7.f * i, Direction<real, 3> { 0, 1, 0 } ) )
+                              .concat( Affine3x4<real>::createTranslation( 0.2f * ( i % 16 ) - 1.5f, 0.2f * ( i / 16 ) - 1.5f, -10 ) ) );
+
+    std::cout << instances << " instances of a " << vertices << " vertex mesh" << std::endl;
+    double world = run_bench( "to world space", 20, [&]() {
+        for( const Affine3x4<real> &w : worlds )
+            w.transform( mesh, moved );
+        keep( moved.x()[0] );
+    } );
+    double local = run_bench( "frustum to local space", 20, [&]() {
+        Frustum l;
+        for( const Affine3x4<real> &w : worlds )
+            l = f.local( w );
+        keep( l );
+    } );
+    print_gain( "frustum to local space", world, local );
+
+    std::size_t seen { 0 };
+    world = run_bench( "vertex tests, world space", 5, [&]() {
+        for( const Affine3x4<real> &w : worlds )
+        {
+            w.transform( mesh, moved );
+            for( std::size_t v { 0 }; v < vertices; ++v )
+                seen += f.outside( moved[v] ) ? 0 : 1;
+        }
+        keep( seen );
+    } );
+    local = run_bench( "vertex tests, local space", 5, [&]() {
+        for( const Affine3x4<real> &w : worlds )
+        {
+            const Frustum l = f.local( w );
+            for( std::size_t v { 0 }; v < vertices; ++v )
+                seen += l.outside( mesh[v] ) ? 0 : 1;
+        }
+        keep( seen );
+    } );
+    print_gain( "vertex tests, local space", world, local );
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+// ExpressionBench.cpp
+//
+// Compares fused vector expressions with the equivalent code that builds
+// a Vector for every intermediate result.
+
+#include "bench.h"
+#include "scene/Object3D.hpp"
+#include "scene/Camera.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace math;
+using namespace geometry;
+using namespace scene;
+
+//! Ritter growth pass where every intermediate result is materialized.
+void grow_sphere_eager( const std::vector<Point<float, 3>> & vertex, Sphere<float> & s )
+{
+    for( unsigned int i { 0 }; i < vertex.size(); ++i )
+    {
+        Vec3r center( s.getCenter() );
+        Vec3r vec( vertex[i] - center );
+        float dist2 = dot( vec, vec );
+
+        if( dist2 > s.getRadius() * s.getRadius() )
+        {
+            float dist = std::sqrt( dist2 );
+            float newRadius = ( s.getRadius() + dist ) * 0.5f;
+            float k = ( newRadius - s.getRadius() ) / dist;
+
+            Vec3r offset( vec * k );
+            Vec3r newCenter( center + offset );
+            s.setRadius( newRadius );
+            s.setCenter( newCenter );
+        }
+    }
+}
+
+//! Ritter growth pass written with fused expressions, as in Object3D.
+void grow_sphere_fused( const std::vector<Point<float, 3>> & vertex, Sphere<float> & s )
+{
+    for( unsigned int i { 0 }; i < vertex.size(); ++i )
+    {
+        Vec3r vec = vertex[i] - s.getCenter();
+        float dist2 = dot( vec, vec );
+
+        if( dist2 > s.getRadius() * s.getRadius() )
+        {
+            float dist = std::sqrt( dist2 );
+            float newRadius = ( s.getRadius() + dist ) * 0.5f;
+            float k = ( newRadius - s.getRadius() ) / dist;
+
+            s.setRadius( newRadius );
+            s.setCenter( s.getCenter() + ( vec * k ) );
+        }
+    }
+}
+
+std::vector<Point<float, 3>> random_points( unsigned int count )
+{
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<float> coord( -100.0f, 100.0f );
+    std::vector<Point<float, 3>> points;
+
+    for( unsigned int i { 0 }; i < count; ++i )
+    {
+        points.push_back( Point<float, 3> { coord( gen ), coord( gen ), coord( gen ) } );
+    }
+    return points;
+}
+
+int main()
+{
+    std::vector<Point<float, 3>> points = random_points( 100000 );
+    Object3D object( points );
+    Sphere<float> start = object.bsphere();
+
+    std::cout << "Ritter growth (100k vertices)" << std::endl;
+    double eager = run_bench( "eager", 50, [&]() {
+        Sphere<float> s( start.getCenter(), 0 );
+        grow_sphere_eager( points, s );
+        keep( s );
+    } );
+    double fused = run_bench( "fused", 50, [&]() {
+        Sphere<float> s( start.getCenter(), 0 );
+        grow_sphere_fused( points, s );
+        keep( s );
+    } );
+    print_gain( "Ritter growth", eager, fused );
+
+    Direction<real, 3> orientation { 0, 0, -1 };
+    Vec3r position { 1, 2, 3 };
+    real distanceProj = 1;
+    real focalLength = 2;
+
+    std::cout << "Frustum plane points" << std::endl;
+    eager = run_bench( "eager", 1000000, [&]() {
+        Vec3r nearOffset( orientation * distanceProj );
+        Vec3r nearPoint( nearOffset + position );
+        Vec3r farOffset( orientation * ( distanceProj + focalLength ) );
+        Vec3r farPoint( farOffset + position );
+        Vec3r farNormal( -orientation );
+        keep( nearPoint );
+        keep( farPoint );
+        keep( farNormal );
+    } );
+    fused = run_bench( "fused", 1000000, [&]() {
+        Point<real, 3> nearPoint( orientation * distanceProj + position );
+        Point<real, 3> farPoint( orientation * ( distanceProj + focalLength ) + position );
+        Direction<real, 3> farNormal( -orientation );
+        keep( nearPoint );
+        keep( farPoint );
+        keep( farNormal );
+    } );
+    print_gain( "Frustum plane points", eager, fused );
+
+    std::cout << "Frustum generation" << std::endl;
+    run_bench( "Camera", 100000, [&]() {
+        Camera camera( 1024, 768, distanceProj, orientation );
+        keep( camera );
+    } );
+
+    return 0;
+}
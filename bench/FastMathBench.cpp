@@ -0,0 +1,69 @@
+// FastMathBench.cpp
+//
+// Compares the standard library functions (StdMath) with the approximations
+// of FastMath: sine and cosine, and normalization of an array of Vec3r.
+
+#include "bench.h"
+#include "math/Vector.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace math;
+
+int main()
+{
+    const std::size_t count = 100000;
+    std::vector<float> angles( count );
+    std::vector<Vec3r> v( count ), unit( count );
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        angles[i] = -6.0f + 12.0f * std::rand() / RAND_MAX;
+        v[i] = Vec3r { 1.0f + std::rand() % 100, -50.0f + std::rand() % 100, 0.5f * ( std::rand() % 10 ) };
+    }
+
+    std::cout << "sincos of " << count << " angles" << std::endl;
+    double std_sincos = run_bench( "StdMath::sincos", 200, [&]() {
+        float acc { 0 };
+        for( std::size_t i { 0 }; i < count; ++i )
+        {
+            float s, c;
+            StdMath::sincos( angles[i], s, c );
+            acc += s * c;
+        }
+        keep( acc );
+    } );
+    double fast_sincos = run_bench( "FastMath::sincos", 200, [&]() {
+        float acc { 0 };
+        for( std::size_t i { 0 }; i < count; ++i )
+        {
+            float s, c;
+            FastMath::sincos( angles[i], s, c );
+            acc += s * c;
+        }
+        keep( acc );
+    } );
+    print_gain( "FastMath::sincos", std_sincos, fast_sincos );
+
+    // The batched versions normalize in place; after the first run they keep
+    // renormalizing unit vectors, which costs the same.
+    unit = v;
+    std::cout << "Normalization of " << count << " Vec3r" << std::endl;
+    double to_unit = run_bench( "to_unit() per vector", 200, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            unit[i] = v[i].to_unit();
+        keep( unit[count - 1] );
+    } );
+    double std_batch = run_bench( "StdMath::normalize", 200, [&]() {
+        StdMath::normalize( unit[0].data(), count, sizeof( Vec3r ) / sizeof( float ) );
+        keep( unit[count - 1] );
+    } );
+    double fast_batch = run_bench( "FastMath::normalize", 200, [&]() {
+        FastMath::normalize( unit[0].data(), count, sizeof( Vec3r ) / sizeof( float ) );
+        keep( unit[count - 1] );
+    } );
+    print_gain( "StdMath::normalize", to_unit, std_batch );
+    print_gain( "FastMath::normalize", to_unit, fast_batch );
+
+    return 0;
+}
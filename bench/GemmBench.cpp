@@ -0,0 +1,91 @@
+// GemmBench.cpp
+//
+// Square DynMatrix products from 256 to 4096: the naive i-k-j loop (up to
+// 1024), the cache-blocked GEMM on one thread, and the same GEMM spread over
+// ThreadPool::global(). Results are reported in GFLOP/s (2 n^3 operations).
+
+#include "bench.h"
+#include "math/DynMatrix.hpp"
+
+#include <cstdlib>
+
+using namespace math;
+
+template<class T>
+DynMatrix<T> random_matrix( const std::size_t n )
+{
+    DynMatrix<T> res( n, n );
+    for( std::size_t i { 0 }; i < n; ++i )
+        for( std::size_t j { 0 }; j < n; ++j )
+            res( i, j ) = std::rand() / static_cast<T>( RAND_MAX ) - T( 0.5 );
+    return res;
+}
+
+template<class T>
+void naive( const DynMatrix<T> & a, const DynMatrix<T> & b, DynMatrix<T> & res )
+{
+    for( std::size_t i { 0 }; i < a.rows(); ++i )
+    {
+        T * r = res.row( i );
+        for( std::size_t j { 0 }; j < b.cols(); ++j )
+            r[j] = T();
+        for( std::size_t k { 0 }; k < a.cols(); ++k )
+        {
+            const T aik = a( i, k );
+            const T * bk = b.row( k );
+            for( std::size_t j { 0 }; j < b.cols(); ++j )
+                r[j] += aik * bk[j];
+        }
+    }
+}
+
+void print_gflops( double ns, std::size_t n )
+{
+    std::cout << "    " << 2.0 * n * n * n / ns << " GFLOP/s" << std::endl;
+}
+
+template<class T>
+void bench_type( const char * name )
+{
+    ThreadPool & pool = ThreadPool::global();
+
+    for( std::size_t n { 256 }; n <= 4096; n *= 2 )
+    {
+        const DynMatrix<T> a = random_matrix<T>( n ), b = random_matrix<T>( n );
+        DynMatrix<T> res( n, n );
+        const unsigned int iterations = n <= 512 ? 10 : 1;
+
+        std::cout << name << " " << n << "x" << n << std::endl;
+        double reference = 0;
+        if( n <= 1024 )
+        {
+            reference = run_bench( "naive", iterations, [&]() {
+                naive( a, b, res );
+                keep( res );
+            } );
+            print_gflops( reference, n );
+        }
+        double blocked = run_bench( "blocked", iterations, [&]() {
+            DynMatrix<T>::multiply( a, b, res );
+            keep( res );
+        } );
+        print_gflops( blocked, n );
+        double parallel = run_bench( "blocked, " + std::to_string( pool.size() ) + " threads", iterations, [&]() {
+            DynMatrix<T>::multiply( a, b, res, pool );
+            keep( res );
+        } );
+        print_gflops( parallel, n );
+
+        if( n <= 1024 )
+            print_gain( "blocked", reference, blocked );
+        print_gain( "parallel", blocked, parallel );
+    }
+}
+
+int main()
+{
+    bench_type<float>( "float" );
+    bench_type<double>( "double" );
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// InverseBench.cpp
+//
+// Compares the 4x4 inversion paths of Matrix: Gauss-Jordan, cofactors,
+// and the affine and rigid fast paths.
+
+#include "bench.h"
+#include "math/Matrix.hpp"
+
+#include <cmath>
+
+using namespace math;
+
+int main()
+{
+    // Camera-like transform: rotation of 30 degrees around y, then a translation.
+    const float c = std::cos( 0.5235988f );
+    const float s = std::sin( 0.5235988f );
+    Mat44r rigid {
+        { c, 0, s, 1.5f },
+        { 0, 1, 0, -2.0f },
+        { -s, 0, c, 10.0f },
+        { 0, 0, 0, 1 }
+    };
+    Mat44r perspective {
+        { 1.2f, 0, 0, 0 },
+        { 0, 1.6f, 0, 0 },
+        { 0, 0, -1.002f, -0.2002f },
+        { 0, 0, -1, 0 }
+    };
+
+    std::cout << "Rigid transform" << std::endl;
+    double gauss = run_bench( "gauss_jordan_inverse", 1000000, [&]() {
+        Mat44r inv = rigid.gauss_jordan_inverse();
+        keep( inv );
+    } );
+    double cofactor = run_bench( "cofactor_inverse", 1000000, [&]() {
+        Mat44r inv = rigid.cofactor_inverse();
+        keep( inv );
+    } );
+    double affine = run_bench( "inverse_affine", 1000000, [&]() {
+        Mat44r inv = rigid.inverse_affine();
+        keep( inv );
+    } );
+    double fast = run_bench( "inverse_rigid", 1000000, [&]() {
+        Mat44r inv = rigid.inverse_rigid();
+        keep( inv );
+    } );
+    run_bench( "inverse_transpose", 1000000, [&]() {
+        Mat44r inv = rigid.inverse_transpose();
+        keep( inv );
+    } );
+    print_gain( "cofactor_inverse", gauss, cofactor );
+    print_gain( "inverse_affine", gauss, affine );
+    print_gain( "inverse_rigid", gauss, fast );
+
+    std::cout << "Perspective projection" << std::endl;
+    gauss = run_bench( "gauss_jordan_inverse", 1000000, [&]() {
+        Mat44r inv = perspective.gauss_jordan_inverse();
+        keep( inv );
+    } );
+    cofactor = run_bench( "cofactor_inverse", 1000000, [&]() {
+        Mat44r inv = perspective.cofactor_inverse();
+        keep( inv );
+    } );
+    print_gain( "cofactor_inverse", gauss, cofactor );
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// MatrixViewBench.cpp
+//
+// Measures 4x4 multiply and transpose throughput of Matrix against the
+// previous storage, whose operator[] returned each row by value.
+
+#include "bench.h"
+#include "math/Matrix.hpp"
+
+#include <array>
+
+using namespace math;
+
+//! Previous Matrix layout: array of rows, rows returned by copy.
+struct RowCopyMatrix
+{
+    std::array<std::array<float, 4>, 4> mat;
+
+    std::array<float, 4> operator[]( const int i ) const
+    {
+        return mat[i];
+    }
+
+    std::array<float, 4> & operator[]( const int i )
+    {
+        return mat[i];
+    }
+
+    RowCopyMatrix operator*( const RowCopyMatrix & m2 ) const
+    {
+        RowCopyMatrix res {};
+
+        for( int i { 0 }; i < 4; ++i )
+            for( int j { 0 }; j < 4; ++j )
+                for( int k { 0 }; k < 4; ++k )
+                    res[i][j] += mat[i][k] * m2[k][j];
+
+        return res;
+    }
+
+    RowCopyMatrix transpose() const
+    {
+        RowCopyMatrix res {};
+
+        for( int i { 0 }; i < 4; ++i )
+            for( int j { 0 }; j < 4; ++j )
+                res[i][j] = (*this)[j][i];
+
+        return res;
+    }
+};
+
+int main()
+{
+    RowCopyMatrix a { { { { 1, 0, 2, 0 }, { 0, 2, 0, 1 }, { 0, 0, 4, 0 }, { 1, 0, 0, 2 } } } };
+    RowCopyMatrix b { { { { 0, -1, 0, 1 }, { 1, 0, 0, 2 }, { 0, 0, 1, 3 }, { 0, 0, 0, 1 } } } };
+    Mat44r va { { 1, 0, 2, 0 }, { 0, 2, 0, 1 }, { 0, 0, 4, 0 }, { 1, 0, 0, 2 } };
+    Mat44r vb { { 0, -1, 0, 1 }, { 1, 0, 0, 2 }, { 0, 0, 1, 3 }, { 0, 0, 0, 1 } };
+
+    std::cout << "4x4 multiply" << std::endl;
+    double copy = run_bench( "row copy", 10000000, [&]() {
+        RowCopyMatrix r = a * b;
+        keep( r );
+    } );
+    double view = run_bench( "row view", 10000000, [&]() {
+        Mat44r r = va * vb;
+        keep( r );
+    } );
+    print_gain( "4x4 multiply", copy, view );
+
+    std::cout << "4x4 transpose" << std::endl;
+    copy = run_bench( "row copy", 10000000, [&]() {
+        RowCopyMatrix r = a.transpose();
+        keep( r );
+    } );
+    view = run_bench( "column view", 10000000, [&]() {
+        Mat44r r = va.transpose();
+        keep( r );
+    } );
+    print_gain( "4x4 transpose", copy, view );
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+// OctreeBench.cpp
+//
+// One frame of a dynamic scene: a fraction of the objects moves, then the
+// visible ones are found. Compares a linear scan (Frustum::outside over every
+// bounding sphere, nothing to maintain), a LooseOctree (move() then cull())
+// and a Bvh (refit() then cull()), as the object count and motion rate vary.
+
+#include "bench.h"
+#include "scene/Bvh.hpp"
+#include "scene/LooseOctree.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace scene;
+
+static real random( const real min, const real max )
+{
+    return min + ( max - min ) * std::rand() / static_cast<real>( RAND_MAX );
+}
+
+int main()
+{
+    const Frustum f {
+        Plane<real>( Point<real, 3> { 0, 0, 0 }, Direction<real, 3> { 0, 0, -1 } ),
+        Plane<real>( Point<real, 3> { 0, 0, -500 }, Direction<real, 3> { 0, 0, 1 } ),
+        Plane<real>( Point<real, 3> { -100, 0, 0 }, Direction<real, 3> { 1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 100, 0, 0 }, Direction<real, 3> { -1, 0, 0 } ),
+        Plane<real>( Point<real, 3> { 0, 100, 0 }, Direction<real, 3> { 0, -1, 0 } ),
+        Plane<real>( Point<real, 3> { 0, -100, 0 }, Direction<real, 3> { 0, 1, 0 } )
+    };
+
+    for( const std::size_t objects : { 10000, 100000 } )
+    {
+        std::vector<Sphere<real>> spheres;
+        for( std::size_t i { 0 }; i < objects; ++i )
+            spheres.push_back( Sphere<real>( Point<real, 3> { random( -500, 500 ), random( -500, 500 ), random( -1000, 0 ) },
+                                             random( 0.5f, 2 ) ) );
+
+        LooseOctree octree( Point<real, 3> { 0, 0, -500 }, 512, objects < 50000 ? 4 : 5 );
+        for( std::size_t i { 0 }; i < objects; ++i )
+            octree.insert( i, spheres[i] );
+        Bvh bvh( spheres.data(), spheres.size() );
+
+        std::vector<std::uint8_t> outside( objects );
+        std::vector<std::size_t> visible;
+
+        for( const std::size_t percent : { 1, 10, 100 } )
+        {
+            const std::size_t moving { objects * percent / 100 };
+            std::cout << objects << " objects, " << percent << "% moving each frame" << std::endl;
+
+            // Les objets se deplacent d'un peu moins d'une unite par image
+            std::size_t frame { 0 };
+            auto step = [&]( std::size_t i ) {
+                const real dx { ( frame + i ) % 2 ? 0.7f : -0.7f };
+                spheres[i].setCenter( spheres[i].getCenter() + math::Vector<real, 3> { dx, 0.3f, 0 } );
+            };
+
+            const double linear = run_bench( "linear", 10, [&]() {
+                for( std::size_t i { 0 }; i < moving; ++i )
+                    step( i );
+                f.outside( spheres.data(), spheres.size(), outside.data() );
+                visible.clear();
+                for( std::size_t i { 0 }; i < objects; ++i )
+                    if( !outside[i] )
+                        visible.push_back( i );
+                keep( visible.size() );
+                ++frame;
+            } );
+            const double loose = run_bench( "octree", 10, [&]() {
+                for( std::size_t i { 0 }; i < moving; ++i )
+                {
+                    step( i );
+                    octree.move( i, spheres[i] );
+                }
+                octree.cull( f, visible );
+                keep( visible.size() );
+                ++frame;
+            } );
+            const double hierarchy = run_bench( "bvh refit", 10, [&]() {
+                for( std::size_t i { 0 }; i < moving; ++i )
+                {
+                    step( i );
+                    bvh.refit( i, spheres[i] );
+                }
+                bvh.cull( f, visible );
+                keep( visible.size() );
+                ++frame;
+            } );
+            print_gain( "octree", linear, loose );
+            print_gain( "bvh refit", linear, hierarchy );
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+// PackedQuaternionBench.cpp
+//
+// Prints the storage cost of one rotation as a Quaternion<float>, a
+// PackedQuaternion48 and a PackedQuaternion32, then compares the decoding
+// throughput of the batched geometry::unpack with the per-element one, and with
+// a plain copy of uncompressed quaternions, on 4096 rotations.
+
+#include "bench.h"
+#include "geometry/PackedQuaternion.hpp"
+
+#include <vector>
+
+using namespace geometry;
+
+template<class Packed>
+void bench_unpack( const char *name, const std::vector<Quaternion<real>> &q, std::vector<Quaternion<real>> &r, const double copy )
+{
+    const std::size_t count { q.size() };
+    std::vector<Packed> packed( count );
+    pack( q.data(), packed.data(), count );
+
+    std::cout << name << ", " << sizeof( Packed ) << " bytes per rotation" << std::endl;
+    const double single = run_bench( "unpack(Packed)", 5000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            r[i] = unpack<real>( packed[i] );
+        keep( r[0] );
+    } );
+    const double batched = run_bench( "unpack(Packed *)", 5000, [&]() {
+        unpack( packed.data(), r.data(), count );
+        keep( r[0] );
+    } );
+    print_gain( "unpack", single, batched );
+    std::cout << "  " << count / batched << " rotations per ns, "
+              << batched / copy << " times the time of the copy" << std::endl;
+
+    run_bench( "pack(Quaternion *)", 5000, [&]() {
+        pack( q.data(), packed.data(), count );
+        keep( packed[0] );
+    } );
+}
+
+int main()
+{
+    const std::size_t count { 4096 };
+
+    std::vector<Quaternion<real>> q, r( count, Quaternion<real>( math::Vec4r { 1, 0, 0, 0 } ) );
+    for( std::size_t i { 0 }; i < count; ++i )
+        q.push_back( Quaternion<real>( 0.5f * i, Direction<real, 3> { 0.6f, 0.1f * ( i % 7 ), 0.8f } ) );
+
+    std::cout << "Quaternion<float>, " << sizeof( Quaternion<real> ) << " bytes per rotation" << std::endl;
+    const double copy = run_bench( "copy", 5000, [&]() {
+        std::copy( q.begin(), q.end(), r.begin() );
+        keep( r[0] );
+    } );
+
+    bench_unpack<PackedQuaternion48>( "PackedQuaternion48", q, r, copy );
+    bench_unpack<PackedQuaternion32>( "PackedQuaternion32", q, r, copy );
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// ProductBench.cpp
+//
+// Compares the compile-time unrolled Matrix products (matrix * matrix,
+// vector * matrix, matrix * vector) with hand-written code, for 3x3 and
+// 4x4 float and double matrices.
+
+#include "bench.h"
+#include "math/Matrix.hpp"
+
+using namespace math;
+
+//! Hand-written products of row-major matrices and vectors, used as the reference.
+template<class T>
+void hand_mul44( const T * a, const T * b, T * r )
+{
+    r[0]  = a[0]  * b[0] + a[1]  * b[4] + a[2]  * b[8]  + a[3]  * b[12];
+    r[1]  = a[0]  * b[1] + a[1]  * b[5] + a[2]  * b[9]  + a[3]  * b[13];
+    r[2]  = a[0]  * b[2] + a[1]  * b[6] + a[2]  * b[10] + a[3]  * b[14];
+    r[3]  = a[0]  * b[3] + a[1]  * b[7] + a[2]  * b[11] + a[3]  * b[15];
+    r[4]  = a[4]  * b[0] + a[5]  * b[4] + a[6]  * b[8]  + a[7]  * b[12];
+    r[5]  = a[4]  * b[1] + a[5]  * b[5] + a[6]  * b[9]  + a[7]  * b[13];
+    r[6]  = a[4]  * b[2] + a[5]  * b[6] + a[6]  * b[10] + a[7]  * b[14];
+    r[7]  = a[4]  * b[3] + a[5]  * b[7] + a[6]  * b[11] + a[7]  * b[15];
+    r[8]  = a[8]  * b[0] + a[9]  * b[4] + a[10] * b[8]  + a[11] * b[12];
+    r[9]  = a[8]  * b[1] + a[9]  * b[5] + a[10] * b[9]  + a[11] * b[13];
+    r[10] = a[8]  * b[2] + a[9]  * b[6] + a[10] * b[10] + a[11] * b[14];
+    r[11] = a[8]  * b[3] + a[9]  * b[7] + a[10] * b[11] + a[11] * b[15];
+    r[12] = a[12] * b[0] + a[13] * b[4] + a[14] * b[8]  + a[15] * b[12];
+    r[13] = a[12] * b[1] + a[13] * b[5] + a[14] * b[9]  + a[15] * b[13];
+    r[14] = a[12] * b[2] + a[13] * b[6] + a[14] * b[10] + a[15] * b[14];
+    r[15] = a[12] * b[3] + a[13] * b[7] + a[14] * b[11] + a[15] * b[15];
+}
+
+template<class T>
+void hand_mul33( const T * a, const T * b, T * r )
+{
+    r[0] = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+    r[1] = a[0] * b[1] + a[1] * b[4] + a[2] * b[7];
+    r[2] = a[0] * b[2] + a[1] * b[5] + a[2] * b[8];
+    r[3] = a[3] * b[0] + a[4] * b[3] + a[5] * b[6];
+    r[4] = a[3] * b[1] + a[4] * b[4] + a[5] * b[7];
+    r[5] = a[3] * b[2] + a[4] * b[5] + a[5] * b[8];
+    r[6] = a[6] * b[0] + a[7] * b[3] + a[8] * b[6];
+    r[7] = a[6] * b[1] + a[7] * b[4] + a[8] * b[7];
+    r[8] = a[6] * b[2] + a[7] * b[5] + a[8] * b[8];
+}
+
+template<class T>
+void hand_vec_mul44( const T * v, const T * m, T * r )
+{
+    r[0] = v[0] * m[0] + v[1] * m[4] + v[2] * m[8]  + v[3] * m[12];
+    r[1] = v[0] * m[1] + v[1] * m[5] + v[2] * m[9]  + v[3] * m[13];
+    r[2] = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + v[3] * m[14];
+    r[3] = v[0] * m[3] + v[1] * m[7] + v[2] * m[11] + v[3] * m[15];
+}
+
+template<class T>
+void hand_mul_vec44( const T * m, const T * v, T * r )
+{
+    r[0] = m[0]  * v[0] + m[1]  * v[1] + m[2]  * v[2] + m[3]  * v[3];
+    r[1] = m[4]  * v[0] + m[5]  * v[1] + m[6]  * v[2] + m[7]  * v[3];
+    r[2] = m[8]  * v[0] + m[9]  * v[1] + m[10] * v[2] + m[11] * v[3];
+    r[3] = m[12] * v[0] + m[13] * v[1] + m[14] * v[2] + m[15] * v[3];
+}
+
+template<class T>
+void bench_type( const char * name )
+{
+    typedef Matrix<T, 4, 4> M4;
+    typedef Matrix<T, 3, 3> M3;
+    typedef Vector<T, 4> V4;
+
+    M4 a { { 1, 0, 2, 0 }, { 0, 2, 0, 1 }, { 0, 0, 4, 0 }, { 1, 0, 0, 2 } };
+    M4 b { { 0, -1, 0, 1 }, { 1, 0, 0, 2 }, { 0, 0, 1, 3 }, { 0, 0, 0, 1 } };
+    M3 c { { 1, 2, 0 }, { 0, 1, 3 }, { 2, 0, 1 } };
+    M3 d { { 0, 1, 1 }, { 1, 0, 2 }, { 3, 1, 0 } };
+    V4 v { 1, 2, 3, 1 };
+
+    std::cout << name << " 4x4 * 4x4" << std::endl;
+    double hand = run_bench( "hand-written", 10000000, [&]() {
+        alignas( 16 ) T r[16];
+        hand_mul44( a.data(), b.data(), r );
+        keep( r );
+        keep( a );
+    } );
+    double unrolled = run_bench( "Matrix", 10000000, [&]() {
+        M4 r = a * b;
+        keep( r );
+        keep( a );
+    } );
+    print_gain( "Matrix 4x4", hand, unrolled );
+
+    std::cout << name << " 3x3 * 3x3" << std::endl;
+    hand = run_bench( "hand-written", 10000000, [&]() {
+        T r[9];
+        hand_mul33( c.data(), d.data(), r );
+        keep( r );
+        keep( c );
+    } );
+    unrolled = run_bench( "Matrix", 10000000, [&]() {
+        M3 r = c * d;
+        keep( r );
+        keep( c );
+    } );
+    print_gain( "Matrix 3x3", hand, unrolled );
+
+    std::cout << name << " vector * 4x4" << std::endl;
+    hand = run_bench( "hand-written", 10000000, [&]() {
+        alignas( 16 ) T r[4];
+        hand_vec_mul44( v.data(), a.data(), r );
+        keep( r );
+        keep( v );
+    } );
+    unrolled = run_bench( "Matrix", 10000000, [&]() {
+        V4 r = v * a;
+        keep( r );
+        keep( v );
+    } );
+    print_gain( "vector * Matrix", hand, unrolled );
+
+    std::cout << name << " 4x4 * vector" << std::endl;
+    hand = run_bench( "hand-written", 10000000, [&]() {
+        alignas( 16 ) T r[4];
+        hand_mul_vec44( a.data(), v.data(), r );
+        keep( r );
+        keep( v );
+    } );
+    unrolled = run_bench( "Matrix", 10000000, [&]() {
+        Matrix<T, 4, 1> r = a * v;
+        keep( r );
+        keep( v );
+    } );
+    print_gain( "Matrix * vector", hand, unrolled );
+}
+
+int main()
+{
+    bench_type<float>( "float" );
+    bench_type<double>( "double" );
+
+    return 0;
+}
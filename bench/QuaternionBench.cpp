@@ -0,0 +1,112 @@
+// QuaternionBench.cpp
+//
+// Compares the per-element Quaternion operations with the batched ones
+// (Quaternion::multiply, Quaternion::rotate on arrays, Quaternion::to_matrices,
+// Quaternion::slerp and nlerp on arrays) on 1024 float quaternions, points or
+// directions.
+
+#include "bench.h"
+#include "geometry/Quaternion.hpp"
+#include "geometry/Transformation.hpp"
+
+#include <vector>
+
+using namespace geometry;
+
+int main()
+{
+    const std::size_t count { 1024 };
+
+    std::vector<Quaternion<real>> a, b, r( count, Quaternion<real>( math::Vec4r { 1, 0, 0, 0 } ) );
+    std::vector<Point<real, 3>> points, moved( count );
+    std::vector<Direction<real, 3>> directions, turned( count );
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        a.push_back( Quaternion<real>( 0.5f * i, Direction<real, 3> { 0.6f, 0, 0.8f } ) );
+        b.push_back( Quaternion<real>( -0.25f * i, Direction<real, 3> { 0, 1, 0 } ) );
+        points.push_back( Point<real, 3> { 0.5f * i, 1.f - i, 2 } );
+        directions.push_back( Direction<real, 3> { 0, 0.5f, -0.25f * i } );
+    }
+    const Quaternion<real> q { 30.f, Direction<real, 3> { 0.6f, 0.8f, 0 } };
+    std::vector<math::Mat44r> mats( count );
+
+    std::cout << "multiply, " << count << " quaternions" << std::endl;
+    double single = run_bench( "operator*", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            r[i] = a[i] * b[i];
+        keep( r[0] );
+    } );
+    double batched = run_bench( "Quaternion::multiply", 20000, [&]() {
+        Quaternion<real>::multiply( a.data(), b.data(), r.data(), count );
+        keep( r[0] );
+    } );
+    print_gain( "multiply", single, batched );
+
+    std::cout << "rotate, " << count << " points" << std::endl;
+    single = run_bench( "rotate(Point)", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            moved[i] = q.rotate( points[i] );
+        keep( moved[0] );
+    } );
+    batched = run_bench( "rotate(Point *)", 20000, [&]() {
+        q.rotate( points.data(), moved.data(), count );
+        keep( moved[0] );
+    } );
+    print_gain( "rotate points", single, batched );
+
+    std::cout << "rotate, " << count << " directions" << std::endl;
+    single = run_bench( "rotate(Direction)", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            turned[i] = q.rotate( directions[i] );
+        keep( turned[0] );
+    } );
+    batched = run_bench( "rotate(Direction *)", 20000, [&]() {
+        q.rotate( directions.data(), turned.data(), count );
+        keep( turned[0] );
+    } );
+    print_gain( "rotate directions", single, batched );
+
+    std::cout << "to matrix, " << count << " quaternions" << std::endl;
+    single = run_bench( "Transformation(Quaternion)", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+        {
+            Transformation<real> t { a[i] };
+            keep( t );
+        }
+    } );
+    batched = run_bench( "Quaternion::to_matrices", 20000, [&]() {
+        Quaternion<real>::to_matrices( a.data(), mats.data(), count );
+        keep( mats[0] );
+    } );
+    print_gain( "to matrix", single, batched );
+
+    std::vector<real> t;
+    for( std::size_t i { 0 }; i < count; ++i )
+        t.push_back( ( i % 101 ) / 100.0f );
+
+    std::cout << "slerp, " << count << " quaternions" << std::endl;
+    single = run_bench( "Quaternion::slerp(q, t)", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            r[i] = a[i].slerp( b[i], t[i] );
+        keep( r[0] );
+    } );
+    batched = run_bench( "Quaternion::slerp(a, b, t)", 20000, [&]() {
+        Quaternion<real>::slerp( a.data(), b.data(), t.data(), r.data(), count );
+        keep( r[0] );
+    } );
+    print_gain( "slerp", single, batched );
+
+    std::cout << "nlerp, " << count << " quaternions" << std::endl;
+    single = run_bench( "Quaternion::nlerp(q, t)", 20000, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+            r[i] = a[i].nlerp( b[i], t[i] );
+        keep( r[0] );
+    } );
+    batched = run_bench( "Quaternion::nlerp(a, b, t)", 20000, [&]() {
+        Quaternion<real>::nlerp( a.data(), b.data(), t.data(), r.data(), count );
+        keep( r[0] );
+    } );
+    print_gain( "nlerp", single, batched );
+
+    return 0;
+}
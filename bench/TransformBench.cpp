@@ -0,0 +1,106 @@
+// TransformBench.cpp
+//
+// Compares point transformation throughput: the previous per-point path,
+// which built a homogeneous vector and multiplied it by the matrix, against
+// the batched AoS and SoA overloads of Transformation::transform, and the
+// SoA path against 16-bit quantized vertices decoded inside the kernel, and
+// the 4x4 Transformation against the compact Affine3x4 for AoS points and
+// composition.
+
+#include "bench.h"
+#include "geometry/Transformation.hpp"
+#include "geometry/Affine3x4.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace math;
+using namespace geometry;
+
+int main()
+{
+    const std::size_t count = 100000;
+    Mat44r m {
+        { 0.866f, 0, -0.5f, 0 },
+        { 0, 1, 0, 0 },
+        { 0.5f, 0, 0.866f, 0 },
+        { 1.5f, -2.0f, 10.0f, 1 }
+    };
+    Transformation<real> t { m };
+
+    std::vector<Point<real, 3>> points( count ), result( count );
+    std::vector<real> x( count ), y( count ), z( count );
+    std::vector<real> outX( count ), outY( count ), outZ( count );
+    for( std::size_t i { 0 }; i < count; ++i )
+    {
+        x[i] = std::rand() / static_cast<real>( RAND_MAX );
+        y[i] = std::rand() / static_cast<real>( RAND_MAX );
+        z[i] = std::rand() / static_cast<real>( RAND_MAX );
+        points[i] = Point<real, 3> { x[i], y[i], z[i] };
+    }
+
+    std::cout << "Transform of " << count << " points" << std::endl;
+    double single = run_bench( "per point", 200, [&]() {
+        for( std::size_t i { 0 }; i < count; ++i )
+        {
+            Vec4r v { points[i][0], points[i][1], points[i][2], 1 };
+            v = v * m;
+            result[i] = Point<real, 3> { v[0], v[1], v[2] };
+        }
+        keep( result[count - 1] );
+    } );
+    double aos = run_bench( "batched AoS", 200, [&]() {
+        t.transform( points.data(), result.data(), count );
+        keep( result[count - 1] );
+    } );
+    double soa = run_bench( "batched SoA", 200, [&]() {
+        t.transform( x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), count );
+        keep( outX[count - 1] );
+    } );
+    print_gain( "batched AoS", single, aos );
+    print_gain( "batched SoA", single, soa );
+
+    const Affine3x4<real> affine { t };
+    std::cout << "Affine3x4, " << sizeof( affine ) << " bytes instead of " << sizeof( t ) << std::endl;
+    double compact = run_bench( "batched AoS, Affine3x4", 200, [&]() {
+        affine.transform( points.data(), result.data(), count );
+        keep( result[count - 1] );
+    } );
+    print_gain( "batched AoS, Affine3x4", aos, compact );
+
+    std::vector<Transformation<real>> chain( 1000, t );
+    std::vector<Affine3x4<real>> affineChain( 1000, affine );
+    double full = run_bench( "concat, 4x4 product", 2000, [&]() {
+        Mat44r acc = chain[0].getMatrix();
+        for( std::size_t i { 1 }; i < chain.size(); ++i )
+            acc = acc * chain[i].getMatrix();
+        keep( acc );
+    } );
+    compact = run_bench( "concat, Affine3x4", 2000, [&]() {
+        Affine3x4<real> acc = affineChain[0];
+        for( std::size_t i { 1 }; i < affineChain.size(); ++i )
+            acc = acc.concat( affineChain[i] );
+        keep( acc );
+    } );
+    print_gain( "concat, Affine3x4", full, compact );
+
+    // Large enough to stream from memory rather than from the caches.
+    const std::size_t large = 4000000;
+    VertexStream<real> stream( large ), streamOut;
+    for( std::size_t i { 0 }; i < large; ++i )
+        stream.set( i, points[i % count] );
+    QuantizedVertexStream<real> quantized { stream };
+
+    std::cout << "Vertex streams of " << large << " points" << std::endl;
+    double floats = run_bench( "float", 20, [&]() {
+        t.transform( stream, streamOut );
+        keep( streamOut.x()[large - 1] );
+    } );
+    double packed = run_bench( "quantized 16-bit", 20, [&]() {
+        t.transform( quantized, streamOut );
+        keep( streamOut.x()[large - 1] );
+    } );
+    print_gain( "quantized 16-bit", floats, packed );
+
+    return 0;
+}
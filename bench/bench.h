@@ -0,0 +1,41 @@
+// bench.h
+//
+// Micro-benchmarks.
+
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+//! Prevents the compiler from discarding a computation whose result is unused.
+template<class T>
+inline void keep( const T & value )
+{
+    asm volatile( "" : : "g"( &value ) : "memory" );
+}
+
+//! Runs f the given number of times and prints the mean time per iteration.
+//! @return Mean time per iteration, in nanoseconds.
+template<class F>
+double run_bench( const std::string & name, unsigned int iterations, F f )
+{
+    f();
+
+    auto start = std::chrono::steady_clock::now();
+    for( unsigned int i { 0 }; i < iterations; ++i )
+    {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>( end - start ).count() / iterations;
+    std::cout << "  " << name << " : " << ns << " ns" << std::endl;
+    return ns;
+}
+
+//! Prints the speedup of an optimized run over a reference run.
+inline void print_gain( const std::string & name, double reference, double optimized )
+{
+    std::cout << name << " : x" << reference / optimized << std::endl << std::endl;
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include "geometry/Affine3x4.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace CppUnit;
+
+#define AFFINE_TEST_EPSILON 1e-5f /**< Tolerance sur les calculs en simple precision */
+
+/**
+ * @class Affine3x4Test
+ * @file Affine3x4Test.hpp
+ * @brief Test unitaire pour les transformations affines compactes
+ */
+class Affine3x4Test : public TestFixture
+{
+public:
+
+    /**
+     * @brief Verifie que deux points sont egaux a la tolerance pres
+     */
+    static void checkPoint(const geometry::Point<real, 3> &expected, const geometry::Point<real, 3> &actual)
+    {
+        for (int c = 0; c < 3; ++c)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[c], actual[c], AFFINE_TEST_EPSILON);
+    }
+
+    /**
+     * @brief Test des constructeurs et de la conversion depuis et vers Transformation
+     */
+    void testConstructor()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::size_t(48), sizeof(geometry::Affine3x4<float>));
+
+        const geometry::Point<real, 3> p{1, 2, 3};
+        CPPUNIT_ASSERT_EQUAL(p, geometry::Affine3x4<real>().transform(p));
+
+        const geometry::Quaternion<real> q(90.f, geometry::Direction<real, 3>{0, 0, 1});
+        checkPoint(q.rotate(p), geometry::Affine3x4<real>(q).transform(p));
+
+        const geometry::Transformation<real> t{math::Mat44r{
+            {0, 2, 0, 0},
+            {-1, 0, 0, 0},
+            {0, 0, 0.5f, 0},
+            {3, -2, 1, 1}
+        }};
+        const geometry::Affine3x4<real> affine(t);
+        CPPUNIT_ASSERT_EQUAL(t.transform(p), affine.transform(p));
+        CPPUNIT_ASSERT_EQUAL(3.f, affine(0, 3));
+        CPPUNIT_ASSERT_EQUAL(affine, geometry::Affine3x4<real>(affine.toTransformation()));
+
+        bool thrown = false;
+        try
+        {
+            affine(3, 0);
+        }
+        catch (std::out_of_range &e)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+    }
+
+    /**
+     * @brief Test des transformations de points, de directions et de spheres
+     */
+    void testTransform()
+    {
+        const geometry::Affine3x4<real> t = geometry::Affine3x4<real>(geometry::Quaternion<real>(30.f, geometry::Direction<real, 3>{0.6f, 0, 0.8f}))
+            .concat(geometry::Affine3x4<real>::createTranslation(1, -2, 0.5f));
+
+        std::vector<geometry::Point<real, 3>> points, result;
+        for (int n = 0; n < 11; ++n)
+            points.push_back(geometry::Point<real, 3>{0.5f * n, real(2 - n), 0.25f * n});
+        t.transform(points, result);
+
+        // Le noyau par paquets de quatre et le calcul point par point donnent le meme resultat
+        CPPUNIT_ASSERT_EQUAL(points.size(), result.size());
+        for (std::size_t n = 0; n < points.size(); ++n)
+            CPPUNIT_ASSERT_EQUAL(t.transform(points[n]), result[n]);
+
+        std::vector<real> x, y, z;
+        for (std::size_t n = 0; n < points.size(); ++n)
+        {
+            x.push_back(points[n][0]);
+            y.push_back(points[n][1]);
+            z.push_back(points[n][2]);
+        }
+        t.transform(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), x.size());
+        for (std::size_t n = 0; n < points.size(); ++n)
+            checkPoint(result[n], geometry::Point<real, 3>{x[n], y[n], z[n]});
+
+        const geometry::Direction<real, 3> d = geometry::Affine3x4<real>::createTranslation(5, 5, 5).transform(geometry::Direction<real, 3>{0, 1, 0});
+        CPPUNIT_ASSERT_EQUAL((geometry::Direction<real, 3>{0, 1, 0}), d);
+
+        const geometry::Sphere<real> s = geometry::Affine3x4<real>::createScaling(2, 3, 2).concat(t).transform(geometry::Sphere<real>(geometry::Point<real, 3>{0, 0, 0}, 1));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(3.f, s.getRadius(), AFFINE_TEST_EPSILON);
+        checkPoint(geometry::Point<real, 3>{1, -2, 0.5f}, geometry::Point<real, 3>(s.getCenter()));
+
+        // Une rotation suivie d'une mise a l'echelle non uniforme etire la sphere
+        // selon un axe qui n'est pas celui d'une colonne de A
+        const geometry::Affine3x4<real> turns[] = {
+            geometry::Affine3x4<real>(geometry::Quaternion<real>(45.f, geometry::Direction<real, 3>{0, 0, 1}))
+                .concat(geometry::Affine3x4<real>::createScaling(2, 1, 1)),
+            t.concat(geometry::Affine3x4<real>::createScaling(3, 1, 0.5f))
+        };
+        for (const geometry::Affine3x4<real> &turn : turns)
+        {
+            const geometry::Sphere<real> unit = turn.transform(geometry::Sphere<real>(geometry::Point<real, 3>{0, 0, 0}, 1));
+            const geometry::Point<real, 3> center = unit.getCenter();
+            for (int a = 0; a < 36; ++a)
+                for (int b = 0; b <= 18; ++b)
+                {
+                    const float theta = a * 3.14159265f / 18, phi = b * 3.14159265f / 18;
+                    const geometry::Point<real, 3> p = turn.transform(geometry::Point<real, 3>{
+                        std::sin(phi) * std::cos(theta), std::sin(phi) * std::sin(theta), std::cos(phi)});
+                    const math::Vector<real, 3> d = p - center;
+                    CPPUNIT_ASSERT(std::sqrt(real(d * d)) <= unit.getRadius() * (1 + AFFINE_TEST_EPSILON));
+                }
+        }
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2.f, turns[0].transform(geometry::Sphere<real>(geometry::Point<real, 3>{0, 0, 0}, 1)).getRadius(),
+                                     AFFINE_TEST_EPSILON);
+    }
+
+    /**
+     * @brief Test de la concatenation et des inverses
+     */
+    void testConcatInverse()
+    {
+        const geometry::Affine3x4<real> scaling = geometry::Affine3x4<real>::createScaling(2, 4, 0.5f);
+        const geometry::Affine3x4<real> translation = geometry::Affine3x4<real>::createTranslation(1, 1, 1);
+        const geometry::Point<real, 3> p{1, 1, 1};
+
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3>{3, 5, 1.5f}), scaling.concat(translation).transform(p));
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3>{4, 8, 1}), translation.concat(scaling).transform(p));
+
+        const geometry::Affine3x4<real> rotation(geometry::Quaternion<real>(75.f, geometry::Direction<real, 3>{0, 1, 0}));
+        const geometry::Affine3x4<real> rigid = rotation.concat(translation);
+        const geometry::Affine3x4<real> any = scaling.concat(rigid);
+        const geometry::Point<real, 3> q{-2, 0.5f, 3};
+
+        checkPoint(q, rigid.inverseRigid().transform(rigid.transform(q)));
+        checkPoint(q, rigid.inverse().transform(rigid.transform(q)));
+        checkPoint(q, any.inverse().transform(any.transform(q)));
+        checkPoint(q, any.concat(any.inverse()).transform(q));
+
+        // Meme composition que le produit des matrices 4x4, avec la convention du vecteur ligne
+        const math::Mat44r product = any.toTransformation().getMatrix() * translation.toTransformation().getMatrix();
+        checkPoint(geometry::Transformation<real>(product).transform(q), any.concat(translation).transform(q));
+
+        bool thrown = false;
+        try
+        {
+            geometry::Affine3x4<real>::createScaling(1, 0, 1).inverse();
+        }
+        catch (std::domain_error &e)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+    }
+
+    /**
+     * @brief Prepare la suite de tests pour les transformations affines
+     * @return La suite de tests pour les transformations affines
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<Affine3x4Test>("testConstructor", &Affine3x4Test::testConstructor));
+        suit->addTest(new TestCaller<Affine3x4Test>("testTransform", &Affine3x4Test::testTransform));
+        suit->addTest(new TestCaller<Affine3x4Test>("testConcatInverse", &Affine3x4Test::testConcatInverse));
+
+        return suit;
+    }
+};
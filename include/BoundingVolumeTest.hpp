@@ -0,0 +1,249 @@
+#pragma once
+#include "scene/Frustum.hpp"
+#include "scene/Object3D.hpp"
+#include "TestHelpers.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+using namespace scene;
+using namespace CppUnit;
+
+/**
+ * @class BoundingVolumeTest
+ * @file BoundingVolumeTest.hpp
+ * @brief Test unitaire pour les boites englobantes et leur rejet par le champ de vision
+ */
+class BoundingVolumeTest : public TestFixture
+{
+private:
+    static Frustum initView()
+    {
+        Plane<real> near(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0, 0, -1});
+        Plane<real> far(Point<real, 3>{0, 0, -10}, Direction<real, 3>{0, 0, 1});
+        Plane<real> left(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0.7071068f, 0, -0.7071068f});
+        Plane<real> right(Point<real, 3>{0, 0, 0}, Direction<real, 3>{-0.7071068f, 0, -0.7071068f});
+        Plane<real> top(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0, -0.7071068f, -0.7071068f});
+        Plane<real> bottom(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0, 0.7071068f, -0.7071068f});
+
+        return Frustum(near, far, left, right, top, bottom);
+    }
+
+    /**
+     * @brief Points repartis le long d'une barre penchee, de longueur 10 et d'epaisseur 0.2
+     */
+    static std::vector<Point<float, 3>> tiltedBar()
+    {
+        const Direction<float, 3> axis = Direction<float, 3>{1, 1, 1}.to_unit();
+        std::vector<Point<float, 3>> points;
+
+        std::srand(5);
+        for (int i = 0; i < 500; ++i)
+        {
+            const float t = helpers::random(-5, 5);
+            points.push_back(Point<float, 3>{t * axis[0] + helpers::random(-0.1f, 0.1f), t * axis[1] + helpers::random(-0.1f, 0.1f),
+                                             t * axis[2] + helpers::random(-0.1f, 0.1f)});
+        }
+        return points;
+    }
+
+    /**
+     * @brief Reference scalaire : un volume de centre c et de projection reach(n)
+     * sur la normale n est en dehors s'il est derriere l'un des six plans
+     * @return 1 si en dehors, 0 si dedans, -1 si trop proche d'un plan pour conclure
+     */
+    template <class Reach>
+    static int reference(const Frustum &f, const Point<real, 3> &c, const Reach &reach)
+    {
+        const Plane<real> *planes[] = {&f.GetNear(), &f.GetFar(), &f.GetLeft(), &f.GetRight(), &f.GetTop(), &f.GetBottom()};
+        int result = 0;
+
+        for (const Plane<real> *p : planes)
+        {
+            const math::Vector<real, 4> &eq = p->GetEquation();
+            const double margin = p->positionFrom(c) + reach(eq);
+            if (std::fabs(margin) < 1e-4)
+                return -1;
+            if (margin < 0)
+                result = 1;
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Test des boites alignees
+     */
+    void testAABB()
+    {
+        const std::vector<Point<float, 3>> points{Point<float, 3>{-1, 0, 2}, Point<float, 3>{3, 1, 0}, Point<float, 3>{0, 4, 1}};
+        const AABB<float> box = AABB<float>::fromPoints(VertexStream<float>(points));
+
+        CPPUNIT_ASSERT_EQUAL((Point<float, 3>{1, 2, 1}), box.getCenter());
+        CPPUNIT_ASSERT_EQUAL((math::Vector<float, 3>{2, 2, 1}), box.getExtent());
+        CPPUNIT_ASSERT_EQUAL((Point<float, 3>{-1, 0, 0}), box.min());
+        CPPUNIT_ASSERT_EQUAL((Point<float, 3>{3, 4, 2}), box.max());
+        CPPUNIT_ASSERT_EQUAL(32.f, box.volume());
+        for (const Point<float, 3> &p : points)
+            CPPUNIT_ASSERT(box.contains(p));
+        CPPUNIT_ASSERT(!box.contains(Point<float, 3>{0, 0, 3}));
+
+        // Un quart de tour autour de z echange les demi-cotes en x et en y
+        const AABB<float> turned = box.transform(Affine3x4<float>(Quaternion<float>(90, Direction<float, 3>{0, 0, 1})));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2, turned.getExtent()[0], 1e-5);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2, turned.getExtent()[1], 1e-5);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1, turned.getExtent()[2], 1e-5);
+
+        CPPUNIT_ASSERT_EQUAL(0.f, AABB<float>::fromPoints(VertexStream<float>()).volume());
+    }
+
+    /**
+     * @brief Test des boites orientees
+     */
+    void testOBB()
+    {
+        const std::vector<Point<float, 3>> points = tiltedBar();
+        const VertexStream<float> stream(points);
+        const OBB<float> box = OBB<float>::fromPoints(stream);
+
+        for (unsigned int a = 0; a < 3; ++a)
+        {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(1, box.getAxis(a) * box.getAxis(a), 1e-5);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0, box.getAxis(a) * box.getAxis((a + 1) % 3), 1e-5);
+        }
+        for (const Point<float, 3> &p : points)
+            CPPUNIT_ASSERT(box.contains(p, 1e-4f));
+
+        // La barre penchee remplit mal sa boite alignee
+        CPPUNIT_ASSERT(box.volume() < AABB<float>::fromPoints(stream).volume() / 20);
+
+        const Affine3x4<float> world = Affine3x4<float>(Quaternion<float>(30, Direction<float, 3>{0, 1, 0}))
+                                           .concat(Affine3x4<float>::createScaling(2, 2, 2))
+                                           .concat(Affine3x4<float>::createTranslation(1, -2, 3));
+        const OBB<float> moved = box.transform(world);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(8 * box.volume(), moved.volume(), 1e-3 * box.volume());
+        for (const Point<float, 3> &p : points)
+            CPPUNIT_ASSERT(moved.contains(world.transform(p), 1e-3f));
+
+        try
+        {
+            box.getAxis(3);
+            CPPUNIT_FAIL("An OBB has three axes");
+        }
+        catch (const std::out_of_range &)
+        {
+        }
+    }
+
+    /**
+     * @brief Test du rejet des volumes par le champ de vision, compare a une reference scalaire
+     */
+    void testFrustum()
+    {
+        const Frustum f = initView();
+
+        std::srand(11);
+        std::vector<AABB<real>> boxes;
+        std::vector<OBB<real>> oriented;
+        std::vector<Sphere<real>> spheres;
+        for (int i = 0; i < 2000; ++i)
+        {
+            const Point<real, 3> c{helpers::random(-15, 15), helpers::random(-15, 15), helpers::random(-15, 5)};
+            const math::Vector<real, 3> e{helpers::random(0, 3), helpers::random(0, 3), helpers::random(0, 3)};
+            const Direction<real, 3> u = Direction<real, 3>{helpers::random(-1, 1), helpers::random(-1, 1), helpers::random(-1, 1)}.to_unit();
+            const math::Vector<real, 3> t{helpers::random(-1, 1), helpers::random(-1, 1), helpers::random(-1, 1)};
+            const math::Vector<real, 3> orthogonal = t - u * real(u * t);
+            const Direction<real, 3> v = orthogonal.to_unit();
+            const Direction<real, 3> w{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+
+            boxes.push_back(AABB<real>(c, e));
+            oriented.push_back(OBB<real>(c, u, v, w, e));
+            spheres.push_back(Sphere<real>(c, e[0]));
+        }
+
+        std::vector<std::uint8_t> boxesOut(boxes.size()), orientedOut(oriented.size());
+        f.outside(boxes.data(), boxes.size(), boxesOut.data());
+        f.outside(oriented.data(), oriented.size(), orientedOut.data());
+
+        int inside = 0, outside = 0;
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            const math::Vector<real, 3> &e = boxes[i].getExtent();
+            const int expected = reference(f, boxes[i].getCenter(), [&](const math::Vector<real, 4> &n) {
+                return std::fabs(n[0]) * e[0] + std::fabs(n[1]) * e[1] + std::fabs(n[2]) * e[2];
+            });
+            if (expected >= 0)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected == 1, f.outside(boxes[i]));
+                CPPUNIT_ASSERT_EQUAL(expected, int(boxesOut[i]));
+                ++(expected ? outside : inside);
+            }
+
+            const OBB<real> &o = oriented[i];
+            const int orientedExpected = reference(f, o.getCenter(), [&](const math::Vector<real, 4> &n) {
+                double r = 0;
+                for (unsigned int a = 0; a < 3; ++a)
+                    r += o.getExtent()[a] * std::fabs(n[0] * o.getAxis(a)[0] + n[1] * o.getAxis(a)[1] + n[2] * o.getAxis(a)[2]);
+                return r;
+            });
+            if (orientedExpected >= 0)
+            {
+                CPPUNIT_ASSERT_EQUAL(orientedExpected == 1, f.outside(o));
+                CPPUNIT_ASSERT_EQUAL(orientedExpected, int(orientedOut[i]));
+            }
+
+            const real r = spheres[i].getRadius();
+            const int sphereExpected = reference(f, spheres[i].getCenter(), [&](const math::Vector<real, 4> &) { return r; });
+            if (sphereExpected >= 0)
+                CPPUNIT_ASSERT_EQUAL(sphereExpected == 1, f.outside(spheres[i]));
+        }
+        CPPUNIT_ASSERT(inside > 100 && outside > 100);
+
+        // Le centre est derriere le plan de gauche, mais la sphere le traverse
+        CPPUNIT_ASSERT(!f.outside(Sphere<real>(Point<real, 3>{-1, 0, 0}, 1)));
+    }
+
+    /**
+     * @brief Test du choix du volume englobant le plus petit d'un objet
+     */
+    void testTightest()
+    {
+        std::vector<Point<float, 3>> bar = tiltedBar();
+        scene::Object3D tilted{bar};
+        CPPUNIT_ASSERT_EQUAL(scene::Object3D::oriented_box_volume, tilted.tightest_volume());
+        CPPUNIT_ASSERT(tilted.obb().volume() < tilted.aabb().volume());
+
+        std::vector<Point<float, 3>> corners;
+        for (int i = 0; i < 8; ++i)
+            corners.push_back(Point<float, 3>{float(i & 1), float((i >> 1) & 1), 4.f * ((i >> 2) & 1)});
+        scene::Object3D slab{corners};
+        CPPUNIT_ASSERT(slab.tightest_volume() != scene::Object3D::sphere_volume);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(4, slab.aabb().volume(), 1e-5);
+
+        scene::Object3D empty;
+        CPPUNIT_ASSERT_EQUAL(scene::Object3D::sphere_volume, empty.tightest_volume());
+    }
+
+    /**
+     * @brief Prepare la suite de test et la retourne
+     * @return La suite de test pour les boites englobantes
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<BoundingVolumeTest>("testAABB", &BoundingVolumeTest::testAABB));
+        suit->addTest(new TestCaller<BoundingVolumeTest>("testOBB", &BoundingVolumeTest::testOBB));
+        suit->addTest(new TestCaller<BoundingVolumeTest>("testFrustum", &BoundingVolumeTest::testFrustum));
+        suit->addTest(new TestCaller<BoundingVolumeTest>("testTightest", &BoundingVolumeTest::testTightest));
+
+        return suit;
+    }
+};
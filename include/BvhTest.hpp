@@ -0,0 +1,136 @@
+#pragma once
+#include "scene/Bvh.hpp"
+#include "TestHelpers.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+using namespace scene;
+using namespace CppUnit;
+
+/**
+ * @class BvhTest
+ * @file BvhTest.hpp
+ * @brief Test unitaire pour la hierarchie de volumes englobants
+ */
+class BvhTest : public TestFixture
+{
+private:
+    /**
+     * @brief Verifie que la hierarchie trouve les memes objets visibles que le test de chaque sphere
+     */
+    static void checkCull(const scene::Bvh &bvh, const std::vector<Sphere<real>> &spheres, const Frustum &f)
+    {
+        std::vector<std::size_t> visible, expected;
+        for (std::size_t i = 0; i < spheres.size(); ++i)
+            if (!f.outside(spheres[i]))
+                expected.push_back(i);
+
+        bvh.cull(f, visible);
+        std::sort(visible.begin(), visible.end());
+        CPPUNIT_ASSERT(!expected.empty() && expected.size() < spheres.size());
+        CPPUNIT_ASSERT(visible == expected);
+    }
+
+public:
+
+    /**
+     * @brief Test du rejet par le champ de vision
+     */
+    void testCull()
+    {
+        std::srand(7);
+        std::vector<Sphere<real>> spheres;
+        for (int i = 0; i < 5000; ++i)
+            spheres.push_back(helpers::randomSphere(3, 0.2f));
+
+        // Quelques objets confondus, que la decoupe ne peut pas separer
+        for (int i = 0; i < 20; ++i)
+            spheres.push_back(Sphere<real>(Point<real, 3>{0.5f, 0.5f, -0.5f}, 0.1f));
+
+        const scene::Bvh bvh(spheres.data(), spheres.size());
+        CPPUNIT_ASSERT_EQUAL(spheres.size(), bvh.num_objects());
+        CPPUNIT_ASSERT(bvh.num_nodes() > spheres.size() / scene::Bvh::leafSize);
+        checkCull(bvh, spheres, helpers::boxView());
+
+        std::vector<std::size_t> visible;
+        const scene::Bvh empty;
+        empty.cull(helpers::boxView(), visible);
+        CPPUNIT_ASSERT(visible.empty());
+    }
+
+    /**
+     * @brief Test de la mise a jour des objets deplaces
+     */
+    void testRefit()
+    {
+        std::srand(11);
+        std::vector<Sphere<real>> spheres;
+        for (int i = 0; i < 2000; ++i)
+            spheres.push_back(helpers::randomSphere(3, 0.2f));
+
+        scene::Bvh bvh(spheres.data(), spheres.size());
+        for (std::size_t i = 0; i < spheres.size(); i += 3)
+        {
+            spheres[i] = helpers::randomSphere(3, 0.2f);
+            bvh.refit(i, spheres[i]);
+        }
+        checkCull(bvh, spheres, helpers::boxView());
+
+        bool thrown = false;
+        try
+        {
+            bvh.refit(spheres.size(), spheres[0]);
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+    }
+
+    /**
+     * @brief Test de centres groupes en deux valeurs voisines, que la position
+     * de la decoupe arrondie en simple precision ne separe pas
+     */
+    void testClustered()
+    {
+        for (int count : {10, 1000})
+        {
+            std::vector<Sphere<real>> spheres;
+            for (int i = 0; i < count; ++i)
+                spheres.push_back(Sphere<real>(Point<real, 3>{i % 2 ? 1000000.0625f : 1000000.0f, 0, 0}, 0.001f));
+
+            const scene::Bvh bvh(spheres.data(), spheres.size());
+            CPPUNIT_ASSERT_EQUAL(spheres.size(), bvh.num_objects());
+            CPPUNIT_ASSERT(bvh.num_nodes() > 1);
+            CPPUNIT_ASSERT(bvh.num_nodes() < 2 * spheres.size());
+
+            std::vector<std::size_t> visible;
+            bvh.cull(helpers::boxView(), visible);
+            CPPUNIT_ASSERT(visible.empty());
+        }
+    }
+
+    /**
+     * @brief Prepare la suite de test et la retourne
+     * @return La suite de test pour la hierarchie
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<BvhTest>("testCull", &BvhTest::testCull));
+        suit->addTest(new TestCaller<BvhTest>("testRefit", &BvhTest::testRefit));
+        suit->addTest(new TestCaller<BvhTest>("testClustered", &BvhTest::testClustered));
+
+        return suit;
+    }
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "math/DynMatrix.hpp"
+#include "math/ThreadPool.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+using namespace CppUnit;
+
+/**
+ * @class DynMatrixTest
+ * @file DynMatrixTest.hpp
+ * @brief Test unitaire pour les matrices de taille dynamique et leur produit
+ */
+class DynMatrixTest : public TestFixture
+{
+private:
+    /**
+     * @brief Remplit une matrice de valeurs entieres pseudo-aleatoires dans [-8, 8],
+     * exactement representables, pour comparer les produits sans tolerance
+     */
+    template<class T>
+    static math::DynMatrix<T> random(const std::size_t rows, const std::size_t cols)
+    {
+        math::DynMatrix<T> res(rows, cols);
+
+        for (std::size_t i = 0; i < rows; ++i)
+            for (std::size_t j = 0; j < cols; ++j)
+                res(i, j) = T(std::rand() % 17 - 8);
+
+        return res;
+    }
+
+    /**
+     * @brief Produit de reference par la triple boucle
+     */
+    template<class T>
+    static math::DynMatrix<T> naive(const math::DynMatrix<T> &a, const math::DynMatrix<T> &b)
+    {
+        math::DynMatrix<T> res(a.rows(), b.cols());
+
+        for (std::size_t i = 0; i < a.rows(); ++i)
+            for (std::size_t k = 0; k < a.cols(); ++k)
+                for (std::size_t j = 0; j < b.cols(); ++j)
+                    res(i, j) += a(i, k) * b(k, j);
+
+        return res;
+    }
+
+    template<class T>
+    static void checkProduct(const std::size_t rows, const std::size_t inner, const std::size_t cols)
+    {
+        const math::DynMatrix<T> a = random<T>(rows, inner), b = random<T>(inner, cols);
+        const math::DynMatrix<T> expected = naive(a, b);
+
+        math::DynMatrix<T> res(rows, cols);
+        math::DynMatrix<T>::multiply(a, b, res);
+        CPPUNIT_ASSERT(expected == res);
+
+        math::ThreadPool pool(3);
+        math::DynMatrix<T>::multiply(a, b, res, pool);
+        CPPUNIT_ASSERT(expected == res);
+    }
+
+    /**
+     * @brief Indique si f leve une exception de type E
+     */
+    template<class E, class F>
+    static bool throws(F f)
+    {
+        try {
+            f();
+        } catch (E &e) {
+            return true;
+        }
+
+        return false;
+    }
+
+public:
+
+    /**
+     * @brief Test de la construction, de l'alignement des lignes et de l'acces aux coefficients
+     */
+    void testLayout()
+    {
+        math::DynMatrix<float> m{{1, 2, 3}, {4, 5}};
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), m.rows());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), m.cols());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), m.stride() % math::DynMatrix<float>::padding());
+        CPPUNIT_ASSERT_EQUAL(5.f, m.at(1, 1));
+        CPPUNIT_ASSERT_EQUAL(0.f, m.at(1, 2));
+        CPPUNIT_ASSERT(throws<std::out_of_range>([&]() { m.at(2, 0); }));
+        CPPUNIT_ASSERT(throws<std::out_of_range>([&]() { m.at(0, 3); }));
+
+        math::DynMatrix<double> big(37, 129);
+        for (std::size_t i = 0; i < big.rows(); ++i)
+            CPPUNIT_ASSERT_EQUAL(std::uintptr_t(0), reinterpret_cast<std::uintptr_t>(big.row(i)) % DYN_MATRIX_ALIGNMENT);
+
+        math::DynMatrix<float> t = m.transpose();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), t.rows());
+        CPPUNIT_ASSERT_EQUAL(3.f, t(2, 0));
+
+        math::DynMatrix<float> sum = m + m;
+        sum *= 0.5f;
+        CPPUNIT_ASSERT(m == sum);
+        CPPUNIT_ASSERT(throws<std::invalid_argument>([&]() { m += t; }));
+    }
+
+    /**
+     * @brief Test de la recopie de blocs de taille fixe
+     */
+    void testBlock()
+    {
+        const math::Mat44r fixed{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+        const math::DynMatrix<float> copy{fixed};
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), copy.rows());
+        CPPUNIT_ASSERT(fixed == (copy.block<4, 4>(0, 0)));
+
+        math::DynMatrix<float> m(6, 7);
+        const math::Matrix<float, 2, 3> small{{1, 2, 3}, {4, 5, 6}};
+        m.set_block(4, 4, small);
+        CPPUNIT_ASSERT_EQUAL(6.f, m(5, 6));
+        CPPUNIT_ASSERT_EQUAL(0.f, m(3, 4));
+
+        const math::Matrix<float, 2, 2> sub = m.block<2, 2>(4, 5);
+        const math::Matrix<float, 2, 2> expected{{2, 3}, {5, 6}};
+        CPPUNIT_ASSERT(expected == sub);
+
+        CPPUNIT_ASSERT(throws<std::out_of_range>([&]() { m.block<2, 4>(4, 4); }));
+        CPPUNIT_ASSERT(throws<std::out_of_range>([&]() { m.set_block(5, 0, small); }));
+    }
+
+    /**
+     * @brief Test du produit sur des tailles qui ne sont pas des multiples des tuiles
+     * ni des blocs, en sequentiel et en parallele
+     */
+    void testProduct()
+    {
+        checkProduct<float>(1, 1, 1);
+        checkProduct<float>(37, 53, 29);
+        checkProduct<float>(130, 300, 70);
+        checkProduct<double>(5, 3, 9);
+        checkProduct<double>(67, 260, 131);
+        checkProduct<int>(19, 23, 17);
+
+        const math::Mat44r a{{1, 2, 0, 1}, {0, 1, 3, 0}, {2, 0, 1, 1}, {0, 0, 0, 1}};
+        const math::Mat44r b{{0, 1, 0, 2}, {1, 0, 0, 0}, {0, 0, 1, 3}, {1, 1, 1, 1}};
+        const math::Mat44r fixed = a * b;
+        const math::DynMatrix<float> product = math::DynMatrix<float>(a) * math::DynMatrix<float>(b);
+        CPPUNIT_ASSERT(fixed == (product.block<4, 4>(0, 0)));
+
+        const math::DynMatrix<float> id = math::DynMatrix<float>::identity(53);
+        const math::DynMatrix<float> r = random<float>(53, 40);
+        CPPUNIT_ASSERT(r == id * r);
+
+        math::DynMatrix<float> res(2, 2);
+        CPPUNIT_ASSERT(throws<std::invalid_argument>([&]() { math::DynMatrix<float>::multiply(r, r, res); }));
+    }
+
+    /**
+     * @brief Test du decoupage de parallel_for, des appels imbriques et des exceptions
+     */
+    void testThreadPool()
+    {
+        math::ThreadPool pool(3);
+        CPPUNIT_ASSERT_EQUAL(4u, pool.size());
+
+        std::vector<std::atomic<int>> hits(1000);
+        for (std::atomic<int> &h : hits)
+            h = 0;
+
+        pool.parallel_for(0, hits.size(), 10, [&](const std::size_t first, const std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+                ++hits[i];
+        });
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL(1, hits[i].load());
+
+        std::atomic<int> total(0);
+        pool.parallel_for(0, 8, 1, [&](const std::size_t first, const std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+                pool.parallel_for(0, 100, 1, [&](const std::size_t f, const std::size_t l) { total += int(l - f); });
+        });
+        CPPUNIT_ASSERT_EQUAL(800, total.load());
+
+        CPPUNIT_ASSERT(throws<std::runtime_error>([&]() {
+            pool.parallel_for(0, 100, 1, [](const std::size_t first, const std::size_t) {
+                if (first > 0)
+                    throw std::runtime_error("task failure");
+            });
+        }));
+    }
+
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<DynMatrixTest>("testLayout", &DynMatrixTest::testLayout));
+        suit->addTest(new TestCaller<DynMatrixTest>("testBlock", &DynMatrixTest::testBlock));
+        suit->addTest(new TestCaller<DynMatrixTest>("testProduct", &DynMatrixTest::testProduct));
+        suit->addTest(new TestCaller<DynMatrixTest>("testThreadPool", &DynMatrixTest::testThreadPool));
+
+        return suit;
+    }
+};
@@ -4,6 +4,7 @@
 #include "geometry/LineSegment.hpp"
 #include "geometry/Sphere.hpp"
 #include "geometry/Point.hpp"
+#include "TestHelpers.hpp"
 
 #include <TestCaller.h>
 #include <TestResult.h>
@@ -11,8 +12,10 @@
 #include <ui/text/TestRunner.h>
 #include <TestFixture.h>
 #include <TestSuite.h>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 using namespace scene;
@@ -28,22 +31,6 @@ using namespace CppUnit;
  */
 class FrustumTest : public TestFixture
 {
-private:
-    /**
-     * @brief Initialise le frustum et le retourne
-     * @return Un frustum initialise
-     */
-    static Frustum initBoxView()
-    {
-        Plane<real> near(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0, 0, -1});
-        Plane<real> far(Point<real, 3>{0, 0, -1}, Direction<real, 3>{0, 0, 1});
-        Plane<real> left(Point<real, 3>{-1, 0, -0.5f}, Direction<real, 3>{1, 0, 0});
-        Plane<real> right(Point<real, 3>{1, 0, -0.5f}, Direction<real, 3>{-1, 0, 0});
-        Plane<real> top(Point<real, 3>{0.5f, 1, -0.5f}, Direction<real, 3>{0, -1, 0});
-        Plane<real> bottom(Point<real, 3>{0.5f, -1, -0.5f}, Direction<real, 3>{0, 1, 0});
-        
-        return Frustum(near, far, left, right, top, bottom);
-    }
 public:
 
     /**
@@ -57,7 +44,7 @@ public:
          Point<real, 3> inside{0.5f, 0.5f, -0.5f};
          Point<real, 3> outside{2.f, 2.f, 2.f};
          
-         Frustum f = FrustumTest::initBoxView();
+         Frustum f = helpers::boxView();
          
          CPPUNIT_ASSERT(f.outside(outside));
          CPPUNIT_ASSERT(! f.outside(inside));
@@ -76,7 +63,7 @@ public:
     
     void testInter()
     {
-        Frustum f = FrustumTest::initBoxView();
+        Frustum f = helpers::boxView();
         
         LineSegment<real, 3> noIntersection(Point<real, 3>{2, 2, 2}, Point<real, 3>{3, 3, 3});
         LineSegment<real, 3> inside(Point<real, 3>{-0.5, 0, 0}, Point<real, 3>{0.5, 0, 0});
@@ -95,6 +82,89 @@ public:
         }
     }
 
+    /**
+     * @brief Test des versions par lots, pour chaque jeu d'instructions supporte
+     */
+    void testBatch()
+    {
+        Frustum f = helpers::boxView();
+        const math::dispatch::Isa initial = math::dispatch::kernels().isa;
+
+        for (math::dispatch::Isa isa : {math::dispatch::Isa::scalar, math::dispatch::Isa::sse2,
+                                        math::dispatch::Isa::avx2, math::dispatch::Isa::avx512})
+        {
+            if (!math::dispatch::select(isa))
+                continue;
+
+            std::vector<Sphere<real>> spheres;
+            for (int i = 0; i < 20; ++i)
+                spheres.push_back(Sphere<real>(Point<real, 3>{0.2f * i - 1, 0, -0.5f}, 0.25f));
+            std::vector<std::uint8_t> outside(spheres.size());
+            f.outside(spheres.data(), spheres.size(), outside.data());
+            for (int i = 0; i < 20; ++i)
+                CPPUNIT_ASSERT_EQUAL(i > 11, outside[i] != 0);
+
+            std::vector<LineSegment<real, 3>> segments(17, LineSegment<real, 3>(Point<real, 3>{-0.5, 0, -0.5f}, Point<real, 3>{0.5, 0, -0.5f}));
+            segments[3] = LineSegment<real, 3>(Point<real, 3>{2, 2, 2}, Point<real, 3>{3, 3, 3});
+            segments[9] = LineSegment<real, 3>(Point<real, 3>{0, 0, 2}, Point<real, 3>{0, 0, -0.5f});
+            std::vector<LineSegment<real, 3>> visible;
+            f.clip(segments, visible);
+
+            CPPUNIT_ASSERT_EQUAL(std::size_t(16), visible.size());
+            CPPUNIT_ASSERT_EQUAL(segments[0], visible[0]);
+            LineSegment<real, 3> expected{Point<real, 3>{0, 0, 0}, Point<real, 3>{0, 0, -0.5f}};
+            CPPUNIT_ASSERT_EQUAL(expected, visible[8]);
+        }
+
+        math::dispatch::select(initial);
+    }
+
+    /**
+     * @brief Test du champ de vision exprime dans le repere local d'un objet
+     */
+    void testLocal()
+    {
+        Frustum f = helpers::boxView();
+        const Affine3x4<real> world = Affine3x4<real>(Quaternion<real>(40.f, Direction<real, 3>{0.6f, 0, 0.8f}))
+            .concat(Affine3x4<real>::createScaling(0.5f, 0.5f, 0.5f))
+            .concat(Affine3x4<real>::createTranslation(0.3f, -0.2f, -0.5f));
+        const Frustum local = f.local(world);
+        const Plane<real> *planes[] = {&f.GetNear(), &f.GetFar(), &f.GetLeft(), &f.GetRight(), &f.GetTop(), &f.GetBottom()};
+
+        std::vector<Sphere<real>> localSpheres, worldSpheres;
+        int tested = 0;
+        for (int i = -6; i <= 6; ++i)
+            for (int j = -6; j <= 6; ++j)
+                for (int k = -6; k <= 6; ++k)
+                {
+                    const Point<real, 3> p{0.37f * i, 0.41f * j, 0.29f * k};
+                    const Point<real, 3> moved = world.transform(p);
+
+                    // Les points trop proches d'un plan, ou a la distance du rayon des spheres
+                    // testees, sont ignores, les arrondis pouvant differer
+                    bool nearPlane = false;
+                    for (const Plane<real> *plane : planes)
+                    {
+                        const double distance = std::fabs(plane->positionFrom(moved));
+                        nearPlane = nearPlane || distance < 1e-3 || std::fabs(distance - 0.05) < 1e-3;
+                    }
+                    if (nearPlane)
+                        continue;
+
+                    CPPUNIT_ASSERT_EQUAL(f.outside(moved), local.outside(p));
+                    ++tested;
+
+                    localSpheres.push_back(Sphere<real>(p, 0.1f));
+                    worldSpheres.push_back(world.transform(localSpheres.back()));
+                }
+        CPPUNIT_ASSERT(tested > 1000);
+
+        std::vector<std::uint8_t> localOutside(localSpheres.size()), worldOutside(worldSpheres.size());
+        local.outside(localSpheres.data(), localSpheres.size(), localOutside.data());
+        f.outside(worldSpheres.data(), worldSpheres.size(), worldOutside.data());
+        CPPUNIT_ASSERT(localOutside == worldOutside);
+    }
+
     /**
      * @brief Prepare la suite de test et la retourne
      * @return La suite de test pour le frustum
@@ -105,6 +175,8 @@ public:
         
         suit->addTest(new TestCaller<FrustumTest>("TestOutside", &FrustumTest::testOutside));
         suit->addTest(new TestCaller<FrustumTest>("TestInter", &FrustumTest::testInter));
+        suit->addTest(new TestCaller<FrustumTest>("TestBatch", &FrustumTest::testBatch));
+        suit->addTest(new TestCaller<FrustumTest>("TestLocal", &FrustumTest::testLocal));
         
         return suit;
     }
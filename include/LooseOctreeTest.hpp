@@ -0,0 +1,158 @@
+#pragma once
+#include "scene/LooseOctree.hpp"
+#include "TestHelpers.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+using namespace scene;
+using namespace CppUnit;
+
+/**
+ * @class LooseOctreeTest
+ * @file LooseOctreeTest.hpp
+ * @brief Test unitaire pour l'octree lache
+ */
+class LooseOctreeTest : public TestFixture
+{
+private:
+    /**
+     * @brief Sphere aleatoire, parfois grande ou hors du monde de l'octree
+     */
+    static Sphere<real> randomSphere()
+    {
+        const real extent = std::rand() % 50 == 0 ? 8 : 3;
+        return helpers::randomSphere(extent, std::rand() % 20 == 0 ? 2 : 0.2f);
+    }
+
+    static std::vector<std::size_t> sorted(std::vector<std::size_t> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    /**
+     * @brief Compare les requetes de l'octree au test de chaque objet indexe
+     */
+    static void checkQueries(const LooseOctree &octree, const std::vector<Sphere<real>> &spheres, const std::vector<bool> &indexed)
+    {
+        const Frustum f = helpers::boxView();
+        const Sphere<real> probe(Point<real, 3>{0.5f, -0.3f, 0.2f}, 0.8f);
+        const Point<real, 3> origin{-4, 0.1f, -0.3f};
+        const Direction<real, 3> direction{1, 0.05f, 0};
+
+        std::vector<std::size_t> visible, touching, hit, result;
+        for (std::size_t i = 0; i < spheres.size(); ++i)
+        {
+            if (!indexed[i])
+                continue;
+
+            if (!f.outside(spheres[i]))
+                visible.push_back(i);
+
+            const math::Vector<real, 3> v = spheres[i].getCenter() - probe.getCenter();
+            const real r = spheres[i].getRadius() + probe.getRadius();
+            if (dot(v, v) <= r * r)
+                touching.push_back(i);
+
+            const math::Vector<real, 3> w = spheres[i].getCenter() - origin;
+            const real along = std::max(0.f, dot(w, direction));
+            if (dot(w, w) - along * along / dot(direction, direction) <= spheres[i].getRadius() * spheres[i].getRadius())
+                hit.push_back(i);
+        }
+        CPPUNIT_ASSERT(!visible.empty() && !touching.empty() && !hit.empty());
+
+        octree.cull(f, result);
+        CPPUNIT_ASSERT(sorted(result) == visible);
+        octree.query(probe, result);
+        CPPUNIT_ASSERT(sorted(result) == touching);
+        octree.query(origin, direction, result);
+        CPPUNIT_ASSERT(sorted(result) == hit);
+    }
+
+public:
+
+    /**
+     * @brief Test des requetes apres insertion, deplacement et suppression d'objets
+     */
+    void testQueries()
+    {
+        std::srand(5);
+        LooseOctree octree(Point<real, 3>{0, 0, 0}, 4, 6);
+        std::vector<Sphere<real>> spheres;
+        std::vector<bool> indexed;
+
+        for (std::size_t i = 0; i < 3000; ++i)
+        {
+            spheres.push_back(randomSphere());
+            indexed.push_back(true);
+            octree.insert(i, spheres[i]);
+        }
+        CPPUNIT_ASSERT_EQUAL(spheres.size(), octree.size());
+        checkQueries(octree, spheres, indexed);
+
+        for (std::size_t i = 0; i < spheres.size(); i += 2)
+        {
+            spheres[i] = randomSphere();
+            octree.move(i, spheres[i]);
+        }
+        // Petits deplacements, qui laissent la plupart des objets dans leur cellule
+        for (std::size_t i = 1; i < spheres.size(); i += 2)
+        {
+            spheres[i].setCenter(spheres[i].getCenter() + math::Vector<real, 3>{0.05f, -0.02f, 0});
+            octree.move(i, spheres[i]);
+        }
+        for (std::size_t i = 1; i < spheres.size(); i += 5)
+        {
+            indexed[i] = false;
+            octree.remove(i);
+        }
+        CPPUNIT_ASSERT_EQUAL(spheres.size() - 600, octree.size());
+        CPPUNIT_ASSERT(!octree.contains(1) && octree.contains(2));
+        CPPUNIT_ASSERT_EQUAL(spheres[2].getCenter(), octree.bound(2).getCenter());
+        checkQueries(octree, spheres, indexed);
+
+        // Les objets retires peuvent etre indexes a nouveau
+        indexed[1] = true;
+        octree.insert(1, spheres[1]);
+        checkQueries(octree, spheres, indexed);
+    }
+
+    /**
+     * @brief Test des erreurs
+     */
+    void testErrors()
+    {
+        LooseOctree octree(Point<real, 3>{0, 0, 0}, 1);
+        const Sphere<real> s(Point<real, 3>{0, 0, 0}, 0.1f);
+        octree.insert(3, s);
+
+        int thrown = 0;
+        try { octree.insert(3, s); } catch (const std::invalid_argument &) { ++thrown; }
+        try { octree.remove(2); } catch (const std::out_of_range &) { ++thrown; }
+        try { octree.move(7, s); } catch (const std::out_of_range &) { ++thrown; }
+        try { LooseOctree(Point<real, 3>{0, 0, 0}, 0); } catch (const std::invalid_argument &) { ++thrown; }
+        CPPUNIT_ASSERT_EQUAL(4, thrown);
+    }
+
+    /**
+     * @brief Prepare la suite de test et la retourne
+     * @return La suite de test pour l'octree lache
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<LooseOctreeTest>("testQueries", &LooseOctreeTest::testQueries));
+        suit->addTest(new TestCaller<LooseOctreeTest>("testErrors", &LooseOctreeTest::testErrors));
+
+        return suit;
+    }
+};
@@ -9,6 +9,8 @@ class MatrixTest : public TestFixture
 public:
     void testAt();
     void testInverse();
+    void testInverse4x4();
+    void testInverseAffine();
     void testIsNull();
     void testIsOrtho();
     void testTranspose();
@@ -19,6 +21,7 @@ public:
     void testMultWithScalar();
     void testMulWithVector();
     void testMulWithMatrix();
+    void testRowColumnView();
     void testDirMulWithScalar();
     static TestSuite *suite();
 };
\ No newline at end of file
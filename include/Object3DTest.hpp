@@ -8,6 +8,8 @@
 #include <ui/text/TestRunner.h>
 #include <TestFixture.h>
 #include <TestSuite.h>
+#include <cmath>
+#include <cstdlib>
 #include <stdexcept>
 #include <iostream>
 
@@ -20,7 +22,126 @@ public:
      */
     void testBSphere()
     {
+        std::vector<Point<float, 3>> points{geometry::Point<float, 3>{-1, 0, 0}, geometry::Point<float, 3>{3, 1, 0},
+                                            geometry::Point<float, 3>{0, 2, -2}, geometry::Point<float, 3>{1, 1, 1}};
 
+        scene::Object3D o{points};
+
+        const Sphere<float> s = o.bsphere();
+        for (const Point<float, 3> &p : points)
+        {
+            const math::Vector<float, 3> v = p - s.getCenter();
+            CPPUNIT_ASSERT(dot(v, v) <= s.getRadius() * s.getRadius() * 1.0001f);
+        }
+
+        Point<float, 3> min, max;
+        o.bbox(min, max);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{-1, 0, -2}), min);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{3, 2, 1}), max);
+
+        // Les volumes en cache suivent l'objet dans le monde
+        const Affine3x4<float> world = Affine3x4<float>::createScaling(2, 2, 2).concat(Affine3x4<float>::createTranslation(0, 0, 5));
+        CPPUNIT_ASSERT_EQUAL(world.transform(s.getCenter()), o.bsphere(world).getCenter());
+        CPPUNIT_ASSERT_EQUAL(2 * s.getRadius(), o.bsphere(world).getRadius());
+
+        o.bbox(world, min, max);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{-2, 0, 1}), min);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{6, 4, 7}), max);
+
+        // La quantification invalide le cache, les volumes englobant les sommets decodes
+        o.quantize();
+        o.bbox(min, max);
+        for (unsigned int i = 0; i < o.num_vertices(); ++i)
+            for (int c = 0; c < 3; ++c)
+                CPPUNIT_ASSERT(min[c] <= o.vertex_at(i)[c] && o.vertex_at(i)[c] <= max[c]);
+
+        scene::Object3D empty;
+        CPPUNIT_ASSERT_EQUAL(0.f, empty.bsphere().getRadius());
+    }
+
+    /** \brief Test de la sphere englobante minimale
+     */
+    void testTightBSphere()
+    {
+        std::vector<Point<float, 3>> triangle{geometry::Point<float, 3>{-1, 0, 0}, geometry::Point<float, 3>{1, 0, 0},
+                                              geometry::Point<float, 3>{0, 0.5f, 0}, geometry::Point<float, 3>{0.2f, -0.3f, 0.4f}};
+        scene::Object3D small{triangle};
+        small.tighten_bsphere();
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{0, 0, 0}), small.bsphere().getCenter());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1, small.bsphere().getRadius(), 1e-6);
+
+        std::srand(3);
+        std::vector<Point<float, 3>> points;
+        for (int i = 0; i < 50000; ++i)
+            points.push_back(geometry::Point<float, 3>{2.f * std::rand() / RAND_MAX - 1, 2.f * std::rand() / RAND_MAX - 1, 1.f * std::rand() / RAND_MAX});
+
+        scene::Object3D o{points};
+        const Sphere<float> ritter = o.bsphere();
+        o.tighten_bsphere();
+        const Sphere<float> s = o.bsphere();
+        CPPUNIT_ASSERT(s.getRadius() <= ritter.getRadius());
+
+        // La distance au point le plus eloigne, convexe, ne diminue dans aucune direction autour du centre
+        auto farthest = [&](const Point<float, 3> &c) {
+            float d2 = 0;
+            for (const Point<float, 3> &p : points)
+            {
+                const math::Vector<float, 3> v = p - c;
+                d2 = std::max(d2, dot(v, v));
+            }
+            return std::sqrt(d2);
+        };
+        CPPUNIT_ASSERT(farthest(s.getCenter()) <= s.getRadius());
+        for (int dx = -1; dx <= 1; ++dx)
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dz = -1; dz <= 1; ++dz)
+                {
+                    const math::Vector<float, 3> step{1e-3f * dx, 1e-3f * dy, 1e-3f * dz};
+                    CPPUNIT_ASSERT(farthest(s.getCenter() + step) >= s.getRadius() - 1e-5f);
+                }
+
+        // Le calcul reparti entre plusieurs threads donne la meme sphere
+        math::ThreadPool pool(3);
+        const Sphere<float> parallel = BoundingSphere<float>::compute(o.vertices(), pool);
+        CPPUNIT_ASSERT_EQUAL(s.getCenter(), parallel.getCenter());
+        CPPUNIT_ASSERT_EQUAL(s.getRadius(), parallel.getRadius());
+    }
+
+    /** \brief Test de l'accesseur pour les sommets
+     */
+    void testVertices()
+    {
+        std::vector<Point<float, 3>> points{geometry::Point<float, 3>{0, 0, 0}, geometry::Point<float, 3>{1, 0, 0}, geometry::Point<float, 3>{0, 0, 1}};
+
+        scene::Object3D o{points};
+
+        CPPUNIT_ASSERT_EQUAL(points.size(), o.vertices().size());
+        CPPUNIT_ASSERT(points == o.vertices().points());
+    }
+
+    /** \brief Test du stockage quantifie des sommets
+     */
+    void testQuantize()
+    {
+        std::vector<Point<float, 3>> points{geometry::Point<float, 3>{0, 0, 0}, geometry::Point<float, 3>{1, 0, 0}, geometry::Point<float, 3>{0, 0, 1}};
+
+        scene::Object3D o{points};
+
+        o.quantize();
+
+        CPPUNIT_ASSERT(o.is_quantized());
+        CPPUNIT_ASSERT(o.vertices().empty());
+        CPPUNIT_ASSERT_EQUAL(3u, o.num_vertices());
+        CPPUNIT_ASSERT_EQUAL(points[1], o.vertex_at(1));
+
+        o.add_face(0, 1, 2);
+
+        CPPUNIT_ASSERT_EQUAL(points[2], o.face(0).get_p2());
+
+        VertexStream<float> moved;
+        o.transform_vertices(Transformation<float>::createScaling(2, 2, 2), moved);
+
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{2, 0, 0}), moved[1]);
     }
 
     /** \brief Test de l'accesseur pour les faces
@@ -103,6 +224,9 @@ public:
     {
         TestSuite *suit = new TestSuite();
         suit->addTest(new TestCaller<Object3DTest>("testBSphere", &Object3DTest::testBSphere));
+        suit->addTest(new TestCaller<Object3DTest>("testTightBSphere", &Object3DTest::testTightBSphere));
+        suit->addTest(new TestCaller<Object3DTest>("testVertices", &Object3DTest::testVertices));
+        suit->addTest(new TestCaller<Object3DTest>("testQuantize", &Object3DTest::testQuantize));
         suit->addTest(new TestCaller<Object3DTest>("testFace", &Object3DTest::testFace));
         suit->addTest(new TestCaller<Object3DTest>("testAddFace", &Object3DTest::testAddFace));
         suit->addTest(new TestCaller<Object3DTest>("testRemoveFace", &Object3DTest::testRemoveFace));
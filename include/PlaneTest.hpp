@@ -11,6 +11,7 @@
 #include <TestSuite.h>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
 
 using namespace CppUnit;
 
@@ -92,6 +93,28 @@ public:
         }
     }
 
+    void testPacket()
+    {
+        geometry::Point<float, 3> p{0, 0, 1};
+        geometry::Direction<float, 3> dir{0, 0, 2};
+
+        geometry::Plane<float> plane{p, dir};
+        const math::PlanePacket<float, 8> packet = plane.packet<8>();
+
+        std::vector<geometry::Point<float, 3>> points;
+        for (unsigned int i = 0; i < 8; ++i)
+            points.push_back(geometry::Point<float, 3>{float(i), -float(i), 0.5f * i - 1});
+
+        const math::Packet<float, 8> distances = packet.distance(math::Vec3x8::gather(points.data()));
+        const math::Mask<float, 8> behind = packet.behind(math::Vec3x8::gather(points.data()), 0.75f);
+
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(float(plane.positionFrom(points[i])), distances[i]);
+            CPPUNIT_ASSERT_EQUAL(plane.positionFrom(points[i]) < -0.75, behind[i]);
+        }
+    }
+
     static TestSuite *suite()
     {
         TestSuite *suit = new TestSuite();
@@ -100,6 +123,7 @@ public:
         suit->addTest(new TestCaller<PlaneTest>("testIsFrontOf", &PlaneTest::testIsFrontOf));
         suit->addTest(new TestCaller<PlaneTest>("testIntersectCoef", &PlaneTest::testIntersectCoef));
         suit->addTest(new TestCaller<PlaneTest>("testIntersec", &PlaneTest::testIntersec));
+        suit->addTest(new TestCaller<PlaneTest>("testPacket", &PlaneTest::testPacket));
 
         return suit;
     }
@@ -1,5 +1,10 @@
 #pragma once
 #include "geometry/Point.hpp"
+#include "geometry/Quaternion.hpp"
+#include "geometry/PackedQuaternion.hpp"
+#include "geometry/RotationTracks.hpp"
+#include "geometry/Transformation.hpp"
+#include "geometry/Affine3x4.hpp"
 
 #include <TestCaller.h>
 #include <TestResult.h>
@@ -7,10 +12,16 @@
 #include <ui/text/TestRunner.h>
 #include <TestFixture.h>
 #include <TestSuite.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
 
 using namespace CppUnit;
 
+#define QUATERNION_TEST_EPSILON 1e-5f /**< Tolerance sur les calculs trigonometriques */
+
 /**
  * @class QuaternionTest
  * @author xavier
@@ -42,9 +53,11 @@ public:
          ******************************************************/
         geometry::Direction<real, 3> directionForAngle{1, 1, 1};
         geometry::Quaternion<real> ctor2(90.f, directionForAngle);
-        math::Vec3r imVector2{(float) std::sin(deg2rad(45.f)), (float) std::sin(deg2rad(45.f)), (float) std::sin(deg2rad(45.f))};
+        double sin45, cos45;
+        math::DefaultMath::sincos(deg2rad(45.f), sin45, cos45);
+        math::Vec3r imVector2{(float) sin45, (float) sin45, (float) sin45};
         
-        CPPUNIT_ASSERT_EQUAL((float) std::cos(deg2rad(45.f)), ctor2.re());
+        CPPUNIT_ASSERT_EQUAL((float) cos45, ctor2.re());
         CPPUNIT_ASSERT_EQUAL(imVector2, ctor2.im());
     }
     
@@ -76,6 +89,260 @@ public:
         CPPUNIT_ASSERT_EQUAL(q.conjugate() / (q.norm() * q.norm()), q.inverse());
     }
 
+    /**
+     * @brief Test du produit de Hamilton, seul et par tableaux
+     */
+    void testMultiply()
+    {
+        const geometry::Quaternion<real> i{math::Vec4r{0, 1, 0, 0}}, j{math::Vec4r{0, 0, 1, 0}}, k{math::Vec4r{0, 0, 0, 1}};
+
+        CPPUNIT_ASSERT_EQUAL(k, i * j);
+        CPPUNIT_ASSERT_EQUAL(-k, j * i);
+        CPPUNIT_ASSERT_EQUAL(i, j * k);
+        CPPUNIT_ASSERT_EQUAL(j, k * i);
+
+        std::vector<geometry::Quaternion<real>> a, b, res(7, i);
+        for (int n = 0; n < 7; ++n)
+        {
+            a.push_back(geometry::Quaternion<real>{math::Vec4r{0.5f * n, float(1 - n), 2, 0.25f}});
+            b.push_back(geometry::Quaternion<real>{math::Vec4r{-1, 0.5f, float(n), 3 - 0.5f * n}});
+        }
+        geometry::Quaternion<real>::multiply(a.data(), b.data(), res.data(), res.size());
+        for (int n = 0; n < 7; ++n)
+            CPPUNIT_ASSERT_EQUAL(a[n] * b[n], res[n]);
+
+        geometry::Quaternion<real> c = a[3];
+        c *= b[3];
+        CPPUNIT_ASSERT_EQUAL(res[3], c);
+    }
+
+    /**
+     * @brief Test de la rotation q * v * q' de points et de directions
+     */
+    void testRotate()
+    {
+        const geometry::Quaternion<real> q(90.f, geometry::Direction<real, 3>{0, 0, 1});
+
+        const geometry::Point<real, 3> rotated = q.rotate(geometry::Point<real, 3>{1, 0, 2});
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.f, rotated[0], QUATERNION_TEST_EPSILON);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.f, rotated[1], QUATERNION_TEST_EPSILON);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2.f, rotated[2], QUATERNION_TEST_EPSILON);
+
+        const geometry::Quaternion<real> r = q.conjugate() * geometry::Quaternion<real>(30.f, geometry::Direction<real, 3>{0.6f, 0, 0.8f});
+        std::vector<geometry::Point<real, 3>> points;
+        std::vector<geometry::Direction<real, 3>> directions;
+        for (int n = 0; n < 9; ++n)
+        {
+            points.push_back(geometry::Point<real, 3>{1.f * n, 2 - 0.5f * n, -1});
+            directions.push_back(geometry::Direction<real, 3>{0.5f, 1.f * n, 0.25f * n});
+        }
+
+        std::vector<geometry::Point<real, 3>> movedPoints(points.size());
+        std::vector<geometry::Direction<real, 3>> movedDirections(directions);
+        r.rotate(points.data(), movedPoints.data(), points.size());
+        r.rotate(movedDirections.data(), movedDirections.data(), movedDirections.size());
+
+        for (int n = 0; n < 9; ++n)
+        {
+            const geometry::Point<real, 3> p = r.rotate(points[n]);
+            const geometry::Direction<real, 3> d = r.rotate(directions[n]);
+            for (int c = 0; c < 3; ++c)
+            {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(p[c], movedPoints[n][c], QUATERNION_TEST_EPSILON * 10);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(d[c], movedDirections[n][c], QUATERNION_TEST_EPSILON * 10);
+            }
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(points[n].norm(), p.norm(), QUATERNION_TEST_EPSILON * 10);
+        }
+    }
+
+    /**
+     * @brief Test de la conversion de tableaux de quaternions en matrices
+     */
+    void testToMatrices()
+    {
+        std::vector<geometry::Quaternion<real>> q;
+        for (int n = 0; n < 6; ++n)
+            q.push_back(geometry::Quaternion<real>(15.f * n, geometry::Direction<real, 3>{0, 0, 1}));
+        q[5] = geometry::Quaternion<real>(90.f, geometry::Direction<real, 3>{0, 0, 1});
+
+        std::vector<math::Mat44r> mats(q.size());
+        geometry::Quaternion<real>::to_matrices(q.data(), mats.data(), q.size());
+
+        // Convention du vecteur ligne : la premiere ligne est l'image de (1, 0, 0)
+        const math::Mat44r expected{{0, 1, 0, 0}, {-1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i][j], mats[5][i][j], QUATERNION_TEST_EPSILON);
+
+        // Le noyau SSE (quatre premiers) et la version generique donnent le meme resultat
+        math::Mat44r scalar;
+        for (int n = 0; n < 6; ++n)
+        {
+            math::simd::QuaternionKernel<real, false>::to_matrix(q[n].getMembers().data(), scalar.data(), 1);
+            CPPUNIT_ASSERT(scalar == mats[n]);
+        }
+
+        // Toutes les representations d'un quaternion tournent dans le meme sens
+        q.push_back(geometry::Quaternion<real>(30.f, geometry::Direction<real, 3>{0.6f, 0, 0.8f}));
+        mats.resize(q.size());
+        geometry::Quaternion<real>::to_matrices(q.data(), mats.data(), q.size());
+        const geometry::Point<real, 3> points[] = {geometry::Point<real, 3>{1, 0, 0}, geometry::Point<real, 3>{0.5f, -2, 3}};
+        for (unsigned int n = 5; n < q.size(); ++n)
+            for (const geometry::Point<real, 3> &p : points)
+            {
+                const geometry::Point<real, 3> rotated = q[n].rotate(p);
+                const geometry::Point<real, 3> byTransformation = geometry::Transformation<real>(q[n]).transform(p);
+                const geometry::Point<real, 3> byAffine = geometry::Affine3x4<real>(q[n]).transform(p);
+                const geometry::Point<real, 3> byMatrix = geometry::Transformation<real>(mats[n]).transform(p);
+                for (int c = 0; c < 3; ++c)
+                {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(rotated[c], byTransformation[c], QUATERNION_TEST_EPSILON * 10);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(rotated[c], byAffine[c], QUATERNION_TEST_EPSILON * 10);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(rotated[c], byMatrix[c], QUATERNION_TEST_EPSILON * 10);
+                }
+            }
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1, q[5].rotate(points[0])[1], QUATERNION_TEST_EPSILON);
+    }
+
+    /**
+     * @brief Verifie que deux quaternions representent la meme rotation
+     */
+    static void checkSameRotation(const geometry::Quaternion<real> &expected, const geometry::Quaternion<real> &actual, const float epsilon)
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.f, std::fabs(expected.dot(actual)), epsilon);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.f, actual.norm(), epsilon);
+    }
+
+    /**
+     * @brief Test de slerp et nlerp, seuls et par tableaux
+     */
+    void testInterpolate()
+    {
+        const geometry::Direction<real, 3> z{0, 0, 1};
+        const geometry::Quaternion<real> from(0.f, z), to(90.f, z);
+
+        checkSameRotation(geometry::Quaternion<real>(45.f, z), from.slerp(to, 0.5f), QUATERNION_TEST_EPSILON);
+        checkSameRotation(geometry::Quaternion<real>(22.5f, z), from.slerp(to, 0.25f), QUATERNION_TEST_EPSILON);
+        checkSameRotation(geometry::Quaternion<real>(45.f, z), from.nlerp(to, 0.5f), QUATERNION_TEST_EPSILON);
+        checkSameRotation(to, from.slerp(to, 1.f), QUATERNION_TEST_EPSILON);
+
+        // -to represente la meme rotation : le chemin le plus court donne le meme resultat
+        checkSameRotation(geometry::Quaternion<real>(45.f, z), from.slerp(-to, 0.5f), QUATERNION_TEST_EPSILON);
+        checkSameRotation(from, from.slerp(from, 0.3f), QUATERNION_TEST_EPSILON);
+
+        std::vector<geometry::Quaternion<real>> a, b, spherical(11, from), linear(11, from);
+        std::vector<real> t;
+        for (int n = 0; n < 11; ++n)
+        {
+            a.push_back(geometry::Quaternion<real>(10.f * n, geometry::Direction<real, 3>{0.6f, 0, 0.8f}));
+            b.push_back(geometry::Quaternion<real>(170.f - 25.f * n, geometry::Direction<real, 3>{0, 1, 0}));
+            if (n % 3 == 0)
+                b[n] = -b[n];
+            t.push_back(0.1f * n);
+        }
+        geometry::Quaternion<real>::slerp(a.data(), b.data(), t.data(), spherical.data(), spherical.size());
+        geometry::Quaternion<real>::nlerp(a.data(), b.data(), t.data(), linear.data(), linear.size());
+        for (int n = 0; n < 11; ++n)
+        {
+            checkSameRotation(a[n].slerp(b[n], t[n]), spherical[n], QUATERNION_TEST_EPSILON * 2);
+            checkSameRotation(a[n].nlerp(b[n], t[n]), linear[n], QUATERNION_TEST_EPSILON * 2);
+        }
+    }
+
+    /**
+     * @brief Test de l'echantillonnage de pistes de rotations
+     */
+    void testTracks()
+    {
+        const geometry::Direction<real, 3> y{0, 1, 0};
+        geometry::RotationTracks<real> tracks(6, std::vector<real>{0, 1, 3});
+
+        for (std::size_t i = 0; i < tracks.size(); ++i)
+        {
+            tracks.key(1, i) = geometry::Quaternion<real>(10.f * i, y);
+            tracks.key(2, i) = geometry::Quaternion<real>(30.f * i, y);
+        }
+
+        std::vector<geometry::Quaternion<real>> sample;
+        tracks.sample(2, sample);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(6), sample.size());
+        for (std::size_t i = 0; i < tracks.size(); ++i)
+            checkSameRotation(geometry::Quaternion<real>(20.f * i, y), sample[i], QUATERNION_TEST_EPSILON * 2);
+
+        tracks.sample(5, sample, false);
+        CPPUNIT_ASSERT_EQUAL(tracks.key(2, 4), sample[4]);
+        tracks.sample(-1, sample);
+        CPPUNIT_ASSERT_EQUAL(tracks.key(0, 3), sample[3]);
+
+        bool thrown = false;
+        try
+        {
+            geometry::RotationTracks<real> unordered(2, std::vector<real>{0, 2, 1});
+        }
+        catch (std::invalid_argument &e)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+    }
+
+    /**
+     * @brief Verifie la borne d'erreur d'un codage compresse sur des rotations aleatoires
+     */
+    template<class Packed>
+    static void checkPacked()
+    {
+        std::srand(17);
+        std::vector<geometry::Quaternion<real>> q;
+        for (int n = 0; n < 1000; ++n)
+        {
+            math::Vec4r v{std::rand() / (real) RAND_MAX - 0.5f, std::rand() / (real) RAND_MAX - 0.5f,
+                          std::rand() / (real) RAND_MAX - 0.5f, std::rand() / (real) RAND_MAX - 0.5f};
+            q.push_back(geometry::Quaternion<real>(v.to_unit()));
+        }
+        q[0] = geometry::Quaternion<real>{math::Vec4r{0, 0, 0, -1}};
+        q[1] = geometry::Quaternion<real>{math::Vec4r{0.5f, -0.5f, 0.5f, -0.5f}};
+
+        std::vector<Packed> packed(q.size());
+        std::vector<geometry::Quaternion<real>> unpacked(q.size(), q[0]);
+        geometry::pack(q.data(), packed.data(), packed.size());
+        geometry::unpack(packed.data(), unpacked.data(), unpacked.size());
+
+        const float componentError = 3 * Packed::Codec::component_error() + QUATERNION_TEST_EPSILON;
+        for (std::size_t n = 0; n < q.size(); ++n)
+        {
+            // Les tableaux (SSE) donnent le meme codage et le meme decodage qu'un a un
+            const Packed single = geometry::pack<Packed>(q[n]);
+            CPPUNIT_ASSERT(std::memcmp(&single, &packed[n], sizeof(Packed)) == 0);
+            CPPUNIT_ASSERT_EQUAL(geometry::unpack<real>(single), unpacked[n]);
+
+            // q et -q sont la meme rotation et ont le meme codage
+            const Packed opposite = geometry::pack<Packed>(-q[n]);
+            CPPUNIT_ASSERT(std::memcmp(&single, &opposite, sizeof(Packed)) == 0);
+
+            const float sign = q[n].dot(unpacked[n]) < 0 ? -1.f : 1.f;
+            for (int c = 0; c < 4; ++c)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(q[n].data()[c], sign * unpacked[n].data()[c], componentError);
+
+            // Angle de la rotation entre les deux, sans acos qui manque de precision pres de 1
+            const geometry::Quaternion<real> delta = q[n].conjugate() * unpacked[n];
+            CPPUNIT_ASSERT(2 * std::atan2(delta.im().norm(), std::fabs(delta.re())) <= Packed::Codec::angle_error());
+        }
+    }
+
+    /**
+     * @brief Test des quaternions compresses sur 48 et 32 bits
+     */
+    void testPacked()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::size_t(6), sizeof(geometry::PackedQuaternion48));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), sizeof(geometry::PackedQuaternion32));
+
+        checkPacked<geometry::PackedQuaternion48>();
+        CPPUNIT_ASSERT(geometry::PackedQuaternion48::Codec::angle_error() < 2e-4f);
+        checkPacked<geometry::PackedQuaternion32>();
+    }
+
     /**
      * @brief Genere la suite de test pour les quaternions
      * @return La suite de tests pour les quaternions
@@ -87,6 +354,12 @@ public:
         suit->addTest(new TestCaller<QuaternionTest>("TestConjugate", &QuaternionTest::testConjugate));
         suit->addTest(new TestCaller<QuaternionTest>("TestInverse", &QuaternionTest::testInverse));
         suit->addTest(new TestCaller<QuaternionTest>("TestNorm", &QuaternionTest::testNorm));
+        suit->addTest(new TestCaller<QuaternionTest>("TestMultiply", &QuaternionTest::testMultiply));
+        suit->addTest(new TestCaller<QuaternionTest>("TestRotate", &QuaternionTest::testRotate));
+        suit->addTest(new TestCaller<QuaternionTest>("TestToMatrices", &QuaternionTest::testToMatrices));
+        suit->addTest(new TestCaller<QuaternionTest>("TestInterpolate", &QuaternionTest::testInterpolate));
+        suit->addTest(new TestCaller<QuaternionTest>("TestTracks", &QuaternionTest::testTracks));
+        suit->addTest(new TestCaller<QuaternionTest>("TestPacked", &QuaternionTest::testPacked));
         
         return suit;
     }
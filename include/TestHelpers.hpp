@@ -0,0 +1,51 @@
+#pragma once
+#include "scene/Frustum.hpp"
+
+#include <cstdlib>
+
+/**
+ * @namespace helpers
+ *
+ * Fonctions partagees par les tests unitaires de la scene
+ */
+namespace helpers
+{
+    /**
+     * @brief Champ de vision en forme de boite, de -1 a 1 en x et y et de -1 a 0 en z
+     * @return Le champ de vision
+     */
+    inline scene::Frustum boxView()
+    {
+        using namespace geometry;
+
+        Plane<real> near(Point<real, 3>{0, 0, 0}, Direction<real, 3>{0, 0, -1});
+        Plane<real> far(Point<real, 3>{0, 0, -1}, Direction<real, 3>{0, 0, 1});
+        Plane<real> left(Point<real, 3>{-1, 0, -0.5f}, Direction<real, 3>{1, 0, 0});
+        Plane<real> right(Point<real, 3>{1, 0, -0.5f}, Direction<real, 3>{-1, 0, 0});
+        Plane<real> top(Point<real, 3>{0.5f, 1, -0.5f}, Direction<real, 3>{0, -1, 0});
+        Plane<real> bottom(Point<real, 3>{0.5f, -1, -0.5f}, Direction<real, 3>{0, 1, 0});
+
+        return scene::Frustum(near, far, left, right, top, bottom);
+    }
+
+    /**
+     * @brief Nombre aleatoire tire par std::rand
+     * @return Un nombre entre min et max
+     */
+    inline real random(const real min, const real max)
+    {
+        return min + (max - min) * std::rand() / RAND_MAX;
+    }
+
+    /**
+     * @brief Sphere aleatoire
+     * @param extent Le centre est tire dans le cube de -extent a extent
+     * @param radius Le rayon est tire entre 0 et radius
+     * @return La sphere
+     */
+    inline geometry::Sphere<real> randomSphere(const real extent, const real radius)
+    {
+        const geometry::Point<real, 3> c{random(-extent, extent), random(-extent, extent), random(-extent, extent)};
+        return geometry::Sphere<real>(c, random(0, radius));
+    }
+}
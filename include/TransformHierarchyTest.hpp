@@ -0,0 +1,103 @@
+#pragma once
+#include "scene/TransformHierarchy.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <stdexcept>
+
+using namespace CppUnit;
+
+/**
+ * @class TransformHierarchyTest
+ * @file TransformHierarchyTest.hpp
+ * @brief Test unitaire pour la hierarchie de transformations
+ */
+class TransformHierarchyTest : public TestFixture
+{
+public:
+
+    /**
+     * @brief Test des transformations monde d'une hierarchie
+     */
+    void testWorld()
+    {
+        typedef geometry::Affine3x4<float> Affine;
+        scene::TransformHierarchy h;
+
+        const std::size_t root = h.add(Affine::createTranslation(10, 0, 0));
+        const std::size_t arm = h.add(Affine::createScaling(2, 2, 2), root);
+        const std::size_t hand = h.add(Affine::createTranslation(0, 1, 0), arm);
+        const std::size_t other = h.add(Affine::createTranslation(0, 0, 5));
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), h.size());
+        CPPUNIT_ASSERT_EQUAL(arm, h.parent(hand));
+        CPPUNIT_ASSERT(h.parent(other) == scene::TransformHierarchy::none);
+        CPPUNIT_ASSERT(h.isDirty(hand));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), h.update());
+        CPPUNIT_ASSERT(!h.isDirty(hand));
+
+        // La main est translatee dans le repere du bras, mis a l'echelle dans celui de la racine
+        const geometry::Point<float, 3> p{1, 0, 0};
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{12, 2, 0}), h.world(hand).transform(p));
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{1, 0, 5}), h.world(other).transform(p));
+
+        bool thrown = false;
+        try
+        {
+            h.add(Affine(), 7);
+        }
+        catch (std::out_of_range &e)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+    }
+
+    /**
+     * @brief Test de la propagation des modifications : seuls les sous-arbres modifies sont recalcules
+     */
+    void testDirty()
+    {
+        typedef geometry::Affine3x4<float> Affine;
+        scene::TransformHierarchy h;
+
+        const std::size_t root = h.add(Affine());
+        const std::size_t arm = h.add(Affine::createTranslation(1, 0, 0), root);
+        const std::size_t hand = h.add(Affine::createTranslation(1, 0, 0), arm);
+        const std::size_t leg = h.add(Affine::createTranslation(0, -1, 0), root);
+        h.update();
+
+        // Rien n'a bouge : rien n'est recalcule
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), h.update());
+
+        h.setLocal(arm, Affine::createTranslation(3, 0, 0));
+        CPPUNIT_ASSERT(h.isDirty(hand));
+        CPPUNIT_ASSERT(!h.isDirty(leg));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), h.update());
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{4, 0, 0}), h.world(hand).transform(geometry::Point<float, 3>{0, 0, 0}));
+
+        // Un noeud et son ancetre modifies : le sous-arbre n'est parcouru qu'une fois
+        h.setLocal(hand, Affine::createTranslation(2, 0, 0));
+        h.setLocal(root, Affine::createTranslation(0, 0, 1));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), h.update());
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{5, 0, 1}), h.world(hand).transform(geometry::Point<float, 3>{0, 0, 0}));
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{0, -1, 1}), h.world(leg).transform(geometry::Point<float, 3>{0, 0, 0}));
+    }
+
+    /**
+     * @brief Prepare la suite de tests pour la hierarchie de transformations
+     * @return La suite de tests pour la hierarchie de transformations
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<TransformHierarchyTest>("testWorld", &TransformHierarchyTest::testWorld));
+        suit->addTest(new TestCaller<TransformHierarchyTest>("testDirty", &TransformHierarchyTest::testDirty));
+
+        return suit;
+    }
+};
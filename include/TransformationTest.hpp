@@ -31,14 +31,14 @@ public:
          * Test avec Quaternion
          **********************************************/
          const float angle = 180;
-         geometry::Direction<real, 3> dir{0, 1, 0};
-         geometry::Quaternion<real> qTest{angle, dir};
-         geometry::Transformation<real> quaternionMat{qTest};
-         geometry::Transformation<real> expectedMat{math::Mat44r{
+         geometry::Direction<real, 3, math::RoundTo2Decimals> dir{0, 1, 0};
+         geometry::Quaternion<real, math::RoundTo2Decimals> qTest{angle, dir};
+         geometry::Transformation<real, math::RoundTo2Decimals> quaternionMat{qTest};
+         geometry::Transformation<real, math::RoundTo2Decimals> expectedMat{math::Matrix<real, 4, 4, math::RoundTo2Decimals>{
            {-1, 0, 0, 0},
            {0,  1, 0, 0},
            {0, 0, -1, 0},
-           {0, 0, 0, 0}
+           {0, 0, 0, 1}
          }};
          
          CPPUNIT_ASSERT_EQUAL(expectedMat, quaternionMat);
@@ -46,7 +46,7 @@ public:
          /**********************************************
          * Test avec angle et Direction
          **********************************************/
-         geometry::Transformation<real> angDirMat{angle, dir};
+         geometry::Transformation<real, math::RoundTo2Decimals> angDirMat{angle, dir};
          CPPUNIT_ASSERT_EQUAL(quaternionMat, angDirMat);
     }
     
@@ -56,32 +56,126 @@ public:
     void testTransform()
     {
         const float angle = 180;
-        geometry::Direction<real, 3> dir{0, 1, 0};
-        geometry::Transformation<real> mat{angle, dir};
+        geometry::Direction<real, 3, math::RoundTo2Decimals> dir{0, 1, 0};
+        geometry::Transformation<real, math::RoundTo2Decimals> mat{angle, dir};
         
-        geometry::Point<real, 3> pt{1, 1, 1};
-        geometry::Point<real, 3> expected{-1, 1, -1};
+        geometry::Point<real, 3, math::RoundTo2Decimals> pt{1, 1, 1};
+        geometry::Point<real, 3, math::RoundTo2Decimals> expected{-1, 1, -1};
         
         CPPUNIT_ASSERT_EQUAL(expected, mat.transform(pt));
     }
-    
+
+    /**
+     * @brief Test des transformations d'ensembles de points
+     */
+    void testTransformBatch()
+    {
+        geometry::Transformation<real> mat{math::Mat44r{
+            {0, 2, 0, 0},
+            {-1, 0, 0, 0},
+            {0, 0, 0.5f, 0},
+            {3, -2, 1, 1}
+        }};
+        std::vector<geometry::Point<real, 3>> points{{1, 2, 3}, {-1, 0, 4}, {0.5f, 0.25f, -2}, {7, 8, 9}, {-3, 1, 0}};
+        std::vector<geometry::Point<real, 3>> result;
+
+        mat.transform(points, result);
+
+        CPPUNIT_ASSERT_EQUAL(points.size(), result.size());
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3>{1, 0, 2.5f}), result[0]);
+        for (unsigned int i = 0; i < points.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL(mat.transform(points[i]), result[i]);
+
+        std::vector<real> x, y, z;
+        for (unsigned int i = 0; i < points.size(); ++i)
+        {
+            x.push_back(points[i][0]);
+            y.push_back(points[i][1]);
+            z.push_back(points[i][2]);
+        }
+
+        mat.transform(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), points.size());
+
+        for (unsigned int i = 0; i < points.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL(result[i], (geometry::Point<real, 3>{x[i], y[i], z[i]}));
+
+        geometry::VertexStream<real> stream{points}, transformed;
+
+        mat.transform(stream, transformed);
+
+        CPPUNIT_ASSERT(result == transformed.points());
+
+        const math::Vec3x4 packet = mat.transform(math::Vec3x4::gather(points.data()));
+
+        for (unsigned int i = 0; i < 4; ++i)
+            CPPUNIT_ASSERT_EQUAL(result[i], (geometry::Point<real, 3>{packet[i][0], packet[i][1], packet[i][2]}));
+
+        mat.transform(points.data(), points.data(), points.size());
+
+        for (unsigned int i = 0; i < points.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL(result[i], points[i]);
+    }
+
+    /**
+     * @brief Test des inverses de transformations
+     */
+    void testInverse()
+    {
+        geometry::Transformation<real, math::RoundTo2Decimals> scaling = geometry::Transformation<real, math::RoundTo2Decimals>::createScaling(2.f, 4.f, 0.5f);
+        geometry::Point<real, 3, math::RoundTo2Decimals> pt{1, 1, 1};
+        geometry::Point<real, 3, math::RoundTo2Decimals> scaled{2, 4, 0.5f};
+
+        CPPUNIT_ASSERT_EQUAL(scaled, scaling.transform(pt));
+        CPPUNIT_ASSERT_EQUAL(pt, scaling.inverse().transform(scaled));
+        CPPUNIT_ASSERT_EQUAL(pt, scaling.inverseAffine().transform(scaled));
+        CPPUNIT_ASSERT_EQUAL(pt, scaling.inverseTranspose().transform(scaled));
+
+        const float angle = 180;
+        geometry::Direction<real, 3, math::RoundTo2Decimals> dir{0, 1, 0};
+        geometry::Transformation<real, math::RoundTo2Decimals> rotation{angle, dir};
+        geometry::Point<real, 3, math::RoundTo2Decimals> rotated{-1, 1, -1};
+
+        CPPUNIT_ASSERT_EQUAL(pt, rotation.inverseRigid().transform(rotated));
+        CPPUNIT_ASSERT_EQUAL(pt, rotation.inverse().transform(rotated));
+
+        // Avec une translation, la transformation suivie de son inverse est l'identite
+        const geometry::Transformation<real> turn{geometry::Quaternion<real>{30, geometry::Direction<real, 3>{0, 0, 1}}};
+        const geometry::Transformation<real> rigid = turn.concat(geometry::Transformation<real>::createTranslation(1, -2, 3));
+        const geometry::Transformation<real> affine = geometry::Transformation<real>::createScaling(2, 4, 0.5f).concat(rigid);
+        const math::Mat44r affineIdentity = affine.concat(affine.inverseAffine()).getMatrix();
+        const math::Mat44r rigidIdentity = rigid.concat(rigid.inverseRigid()).getMatrix();
+
+        for (unsigned int i = 0; i < 4; ++i)
+            for (unsigned int j = 0; j < 4; ++j)
+            {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(i == j, affineIdentity(i, j), 1e-5);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(i == j, rigidIdentity(i, j), 1e-5);
+            }
+
+        const geometry::Point<real, 3> back = affine.inverseAffine().transform(affine.transform(geometry::Point<real, 3>{1, 2, 3}));
+        for (unsigned int c = 0; c < 3; ++c)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(c + 1, back[c], 1e-5);
+    }
+
     /**
      * @brief Test des methodes factory
      */
     void testFactory()
     {
-        geometry::Transformation<real> translation = geometry::Transformation<real>::createTranslation(1.f, 1.f, 1.f);
-        geometry::Transformation<real> expectedTranslation{math::Mat44r{
-            {0, 0, 0, 1},
-            {0, 0, 0, 1},
-            {0, 0, 0, 1},
-            {0, 0, 0, 1}
+        geometry::Transformation<real, math::RoundTo2Decimals> translation = geometry::Transformation<real, math::RoundTo2Decimals>::createTranslation(1.f, 1.f, 1.f);
+        geometry::Transformation<real, math::RoundTo2Decimals> expectedTranslation{math::Matrix<real, 4, 4, math::RoundTo2Decimals>{
+            {1, 0, 0, 0},
+            {0, 1, 0, 0},
+            {0, 0, 1, 0},
+            {1, 1, 1, 1}
         }};
         
         CPPUNIT_ASSERT_EQUAL(expectedTranslation, translation);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3, math::RoundTo2Decimals>{2, 3, 4}),
+                             translation.transform(geometry::Point<real, 3, math::RoundTo2Decimals>{1, 2, 3}));
         
-        geometry::Transformation<real> scaling = geometry::Transformation<real>::createScaling(1.f, 1.f, 1.f);
-        geometry::Transformation<real> expectedScaling{math::Mat44r{
+        geometry::Transformation<real, math::RoundTo2Decimals> scaling = geometry::Transformation<real, math::RoundTo2Decimals>::createScaling(1.f, 1.f, 1.f);
+        geometry::Transformation<real, math::RoundTo2Decimals> expectedScaling{math::Matrix<real, 4, 4, math::RoundTo2Decimals>{
             {1, 0, 0, 0},
             {0, 1, 0, 0},
             {0, 0, 1, 0},
@@ -89,22 +183,33 @@ public:
         }};
         
         CPPUNIT_ASSERT_EQUAL(expectedScaling, scaling);
+        CPPUNIT_ASSERT(!(expectedTranslation == scaling));
     }
     
     void testConcat()
     {
-        geometry::Transformation<real> translation = geometry::Transformation<real>::createTranslation(1.f, 1.f, 1.f);
-        geometry::Transformation<real> scaling = geometry::Transformation<real>::createScaling(1.f, 1.f, 1.f);
-        geometry::Transformation<real> transAndScale = translation.concat(scaling);
-
-        geometry::Transformation<real> expectedConcat{math::Mat44r{
-            {1, 0, 0, 1},
-            {0, 1, 0, 1},
-            {0, 0, 1, 1},
-            {0, 0, 0, 1}
+        geometry::Transformation<real, math::RoundTo2Decimals> translation = geometry::Transformation<real, math::RoundTo2Decimals>::createTranslation(1.f, 1.f, 1.f);
+        geometry::Transformation<real, math::RoundTo2Decimals> scaling = geometry::Transformation<real, math::RoundTo2Decimals>::createScaling(1.f, 1.f, 1.f);
+        geometry::Transformation<real, math::RoundTo2Decimals> transAndScale = translation.concat(scaling);
+
+        geometry::Transformation<real, math::RoundTo2Decimals> expectedConcat{math::Matrix<real, 4, 4, math::RoundTo2Decimals>{
+            {1, 0, 0, 0},
+            {0, 1, 0, 0},
+            {0, 0, 1, 0},
+            {1, 1, 1, 1}
         }};
         
         CPPUNIT_ASSERT_EQUAL(expectedConcat, transAndScale);
+
+        // La transformation courante est appliquee en premier
+        const geometry::Transformation<real> move = geometry::Transformation<real>::createTranslation(1, 2, 3);
+        const geometry::Transformation<real> grow = geometry::Transformation<real>::createScaling(2, 2, 2);
+        const geometry::Point<real, 3> p{1, 1, 1};
+
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3>{4, 6, 8}), move.concat(grow).transform(p));
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<real, 3>{3, 4, 5}), grow.concat(move).transform(p));
+        CPPUNIT_ASSERT_EQUAL(p, move.concat(grow).inverseAffine().transform(geometry::Point<real, 3>{4, 6, 8}));
+        CPPUNIT_ASSERT_EQUAL(p, move.inverseRigid().transform(geometry::Point<real, 3>{2, 3, 4}));
     }
 
     /**
@@ -116,6 +221,8 @@ public:
         TestSuite *suit = new TestSuite();
         suit->addTest(new TestCaller<TransformationTest>("testConstructor", &TransformationTest::testConstructor));
         suit->addTest(new TestCaller<TransformationTest>("testTransform", &TransformationTest::testTransform));
+        suit->addTest(new TestCaller<TransformationTest>("testTransformBatch", &TransformationTest::testTransformBatch));
+        suit->addTest(new TestCaller<TransformationTest>("testInverse", &TransformationTest::testInverse));
         suit->addTest(new TestCaller<TransformationTest>("testFactory", &TransformationTest::testFactory));
         suit->addTest(new TestCaller<TransformationTest>("testConcat", &TransformationTest::testConcat));
         
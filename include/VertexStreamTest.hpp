@@ -0,0 +1,191 @@
+#pragma once
+
+#include "geometry/VertexStream.hpp"
+#include "geometry/QuantizedVertexStream.hpp"
+#include "geometry/Transformation.hpp"
+
+#include <TestCaller.h>
+#include <TestResult.h>
+#include <TestResultCollector.h>
+#include <ui/text/TestRunner.h>
+#include <TestFixture.h>
+#include <TestSuite.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+using namespace CppUnit;
+
+/**
+ * @class VertexStreamTest
+ * @file VertexStreamTest.hpp
+ * @brief Test unitaire pour le stockage des sommets coordonnee par coordonnee
+ */
+class VertexStreamTest : public TestFixture
+{
+public:
+
+    /**
+     * @brief Test de la construction a partir de points et du parcours sous forme de Point
+     */
+    void testConstructor()
+    {
+        std::vector<geometry::Point<float, 3>> points{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+        geometry::VertexStream<float> stream{points};
+
+        CPPUNIT_ASSERT_EQUAL(points.size(), stream.size());
+        for (unsigned int i = 0; i < points.size(); ++i)
+            CPPUNIT_ASSERT_EQUAL(points[i], stream[i]);
+
+        unsigned int i = 0;
+        for (geometry::VertexStream<float>::const_iterator it = stream.begin(); it != stream.end(); ++it, ++i)
+            CPPUNIT_ASSERT_EQUAL(points[i], *it);
+        CPPUNIT_ASSERT_EQUAL(3u, i);
+
+        CPPUNIT_ASSERT(points == stream.points());
+    }
+
+    /**
+     * @brief Test de l'alignement et du remplissage des tableaux de coordonnees
+     */
+    void testLayout()
+    {
+        geometry::VertexStream<float> stream;
+
+        CPPUNIT_ASSERT(stream.empty());
+
+        for (unsigned int i = 0; i < 17; ++i)
+            stream.push_back(geometry::Point<float, 3>{float(i), 2.f * i, 3.f * i});
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(17), stream.size());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), stream.padded_size() % geometry::VertexStream<float>::padding());
+        CPPUNIT_ASSERT(stream.padded_size() >= stream.size());
+        CPPUNIT_ASSERT_EQUAL(std::uintptr_t(0), reinterpret_cast<std::uintptr_t>(stream.x()) % VERTEX_STREAM_ALIGNMENT);
+        CPPUNIT_ASSERT_EQUAL(std::uintptr_t(0), reinterpret_cast<std::uintptr_t>(stream.y()) % VERTEX_STREAM_ALIGNMENT);
+        CPPUNIT_ASSERT_EQUAL(std::uintptr_t(0), reinterpret_cast<std::uintptr_t>(stream.z()) % VERTEX_STREAM_ALIGNMENT);
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{16, 32, 48}), stream[16]);
+
+        stream.resize(2);
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), stream.size());
+        for (std::size_t i = stream.size(); i < stream.padded_size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(0.f, stream.x()[i]);
+            CPPUNIT_ASSERT_EQUAL(0.f, stream.y()[i]);
+            CPPUNIT_ASSERT_EQUAL(0.f, stream.z()[i]);
+        }
+
+        stream.set(1, geometry::Point<float, 3>{-1, -2, -3});
+        CPPUNIT_ASSERT_EQUAL((geometry::Point<float, 3>{-1, -2, -3}), stream[1]);
+    }
+
+    /**
+     * @brief Compare les sommets quantifies au chemin flottant, apres decodage puis
+     * apres transformation, l'erreur devant rester sous le demi pas de quantification
+     * @param points Les sommets de reference
+     */
+    void checkQuantizedAccuracy(const geometry::VertexStream<float> &points)
+    {
+        geometry::QuantizedVertexStream<float> quantized{points};
+        const std::array<float, 3> &scale = quantized.scale();
+        const float *coords[3] = {points.x(), points.y(), points.z()};
+        float magnitude[3]; // Ordre de grandeur des coordonnees, pour l'erreur d'arrondi flottant
+
+        for (unsigned int axis = 0; axis < 3; ++axis)
+            magnitude[axis] = 1 + std::fabs(quantized.offset()[axis]) + scale[axis] * QUANTIZED_VERTEX_MAX;
+
+        CPPUNIT_ASSERT_EQUAL(points.size(), quantized.size());
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            geometry::Point<float, 3> decoded = quantized[i];
+
+            for (unsigned int axis = 0; axis < 3; ++axis)
+                CPPUNIT_ASSERT(std::fabs(decoded[axis] - coords[axis][i]) <= scale[axis] * 0.5f + 1e-6f * magnitude[axis]);
+        }
+
+        math::Mat44r m{
+            {0.866f, 0, -0.5f, 0},
+            {0, 2, 0, 0},
+            {0.5f, 0, 0.866f, 0},
+            {1.5f, -2, 10, 1}
+        };
+        geometry::Transformation<float> t{m};
+        geometry::VertexStream<float> expected, result;
+
+        t.transform(points, expected);
+        t.transform(quantized, result);
+
+        const float *exp[3] = {expected.x(), expected.y(), expected.z()};
+        const float *res[3] = {result.x(), result.y(), result.z()};
+
+        CPPUNIT_ASSERT_EQUAL(points.size(), result.size());
+
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            const float bound = (std::fabs(m[0][j]) * scale[0] + std::fabs(m[1][j]) * scale[1] + std::fabs(m[2][j]) * scale[2]) * 0.5f;
+            const float range = std::fabs(m[0][j]) * magnitude[0] + std::fabs(m[1][j]) * magnitude[1] + std::fabs(m[2][j]) * magnitude[2] + std::fabs(m[3][j]);
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+                CPPUNIT_ASSERT(std::fabs(res[j][i] - exp[j][i]) <= bound + 4e-6f * range);
+        }
+    }
+
+    /**
+     * @brief Precision de la quantification sur le maillage data/humanoid.geo
+     */
+    void testQuantizedHumanoid()
+    {
+        std::ifstream file("data/humanoid.geo");
+        int nb = 0;
+
+        CPPUNIT_ASSERT(file >> nb);
+
+        geometry::VertexStream<float> points;
+        for (int i = 0; i < nb; ++i)
+        {
+            float x, y, z;
+            file >> x >> y >> z;
+            points.push_back(geometry::Point<float, 3>{x, y, z});
+        }
+
+        CPPUNIT_ASSERT(file.good());
+        checkQuantizedAccuracy(points);
+    }
+
+    /**
+     * @brief Precision de la quantification sur un maillage d'un million de sommets
+     */
+    void testQuantizedMillion()
+    {
+        const std::size_t count = 1000000;
+        geometry::VertexStream<float> points(count);
+
+        std::srand(42);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.x()[i] = -50.f + 100.f * std::rand() / RAND_MAX;
+            points.y()[i] = 200.f * std::rand() / RAND_MAX;
+            points.z()[i] = -1.f + 2.f * std::rand() / RAND_MAX;
+        }
+
+        checkQuantizedAccuracy(points);
+    }
+
+    /**
+     * @brief Prepare la suite de tests pour les flux de sommets
+     * @return La suite de tests pour les flux de sommets
+     */
+    static TestSuite *suite()
+    {
+        TestSuite *suit = new TestSuite();
+        suit->addTest(new TestCaller<VertexStreamTest>("testConstructor", &VertexStreamTest::testConstructor));
+        suit->addTest(new TestCaller<VertexStreamTest>("testLayout", &VertexStreamTest::testLayout));
+        suit->addTest(new TestCaller<VertexStreamTest>("testQuantizedHumanoid", &VertexStreamTest::testQuantizedHumanoid));
+        suit->addTest(new TestCaller<VertexStreamTest>("testQuantizedMillion", &VertexStreamTest::testQuantizedMillion));
+
+        return suit;
+    }
+};
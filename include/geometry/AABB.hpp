@@ -0,0 +1,148 @@
+#pragma once
+
+#include "geometry/Point.hpp"
+#include "geometry/VertexStream.hpp"
+#include "geometry/Affine3x4.hpp"
+#include "math/Vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class AABB
+     *
+     * Boite alignee sur les axes, decrite par son centre et ses demi-cotes.
+     */
+    template <class T>
+    class AABB
+    {
+    private:
+        Point<T, 3> center; /**< Centre de la boite */
+        math::Vector<T, 3> extent; /**< Demi-cotes de la boite, positifs */
+
+    public:
+        /** \brief Construit une boite vide, reduite a l'origine
+         */
+        constexpr AABB() : center(), extent()
+        {
+        }
+
+        /** \brief Construit une boite avec son centre et ses demi-cotes
+         *
+         * \param center Le centre de la boite
+         * \param extent Les demi-cotes de la boite
+         */
+        constexpr AABB(const Point<T, 3> &center, const math::Vector<T, 3> &extent) : center(center), extent(extent)
+        {
+        }
+
+        /** \brief Construit la boite de deux coins
+         *
+         * \param min Le coin minimal
+         * \param max Le coin maximal
+         * \return La boite
+         */
+        static AABB fromCorners(const Point<T, 3> &min, const Point<T, 3> &max)
+        {
+            return AABB(Point<T, 3>{(min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2},
+                        math::Vector<T, 3>{(max[0] - min[0]) / 2, (max[1] - min[1]) / 2, (max[2] - min[2]) / 2});
+        }
+
+        /** \brief Construit la plus petite boite contenant des points
+         *
+         * \param points Les points
+         * \return La boite, reduite a l'origine s'il n'y a pas de point
+         */
+        static AABB fromPoints(const VertexStream<T> &points)
+        {
+            if (points.empty())
+                return AABB();
+
+            const T *coords[] = {points.x(), points.y(), points.z()};
+            Point<T, 3> min, max;
+            for (int c = 0; c < 3; ++c)
+            {
+                min[c] = *std::min_element(coords[c], coords[c] + points.size());
+                max[c] = *std::max_element(coords[c], coords[c] + points.size());
+            }
+            return fromCorners(min, max);
+        }
+
+        /** \brief Accesseur pour le centre de la boite
+         */
+        const Point<T, 3> &getCenter() const
+        {
+            return center;
+        }
+
+        /** \brief Accesseur pour les demi-cotes de la boite
+         */
+        const math::Vector<T, 3> &getExtent() const
+        {
+            return extent;
+        }
+
+        /** \brief Coin minimal de la boite
+         */
+        Point<T, 3> min() const
+        {
+            return Point<T, 3>{center[0] - extent[0], center[1] - extent[1], center[2] - extent[2]};
+        }
+
+        /** \brief Coin maximal de la boite
+         */
+        Point<T, 3> max() const
+        {
+            return Point<T, 3>{center[0] + extent[0], center[1] + extent[1], center[2] + extent[2]};
+        }
+
+        /** \brief Volume de la boite
+         */
+        T volume() const
+        {
+            return 8 * extent[0] * extent[1] * extent[2];
+        }
+
+        /** \brief Verifie si un point est dans la boite
+         *
+         * \param p Le point
+         * \return true si le point est dans la boite, bord compris
+         */
+        bool contains(const Point<T, 3> &p) const
+        {
+            for (int c = 0; c < 3; ++c)
+                if (p[c] < center[c] - extent[c] || p[c] > center[c] + extent[c])
+                    return false;
+            return true;
+        }
+
+        /** \brief Transforme la boite, le resultat etant la plus petite boite alignee contenant la boite transformee
+         *
+         * \param t La transformation
+         * \return La boite transformee
+         */
+        AABB transform(const Affine3x4<T> &t) const
+        {
+            Point<T, 3> min, max;
+            t.transformBox(this->min(), this->max(), min, max);
+            return fromCorners(min, max);
+        }
+    };
+
+    template<class T>
+    std::ostream& operator<<(std::ostream& out, const AABB<T> &b)
+    {
+        out << "Centre : " << b.getCenter() << " demi-cotes : " << b.getExtent();
+        return out;
+    }
+
+    static_assert(std::is_trivially_copyable<AABB<float>>::value, "AABB must be trivially copyable");
+}
@@ -0,0 +1,424 @@
+#pragma once
+
+#include "math/Simd.hpp"
+#include "geometry/Quaternion.hpp"
+#include "geometry/Direction.hpp"
+#include "geometry/Point.hpp"
+#include "geometry/Plane.hpp"
+#include "geometry/Sphere.hpp"
+#include "geometry/Transformation.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class Affine3x4
+     *
+     * Transformation affine stockee sous forme compacte : la matrice 3x4 [A | t],
+     * ligne par ligne, appliquee par p' = A p + t. La derniere ligne (0, 0, 0, 1)
+     * d'une matrice 4x4 n'est pas stockee : 48 octets en simple precision contre
+     * 64, et 12 multiplications-additions par point. Les projections, qui ne sont
+     * pas affines, restent des Transformation.
+     */
+    template<class T, class P = math::Exact>
+    class Affine3x4
+    {
+    private:
+        alignas(16) T mat[12]; /**< Coefficients de [A | t], ligne par ligne */
+
+        T &at(const unsigned int i, const unsigned int j)
+        {
+            return mat[4 * i + j];
+        }
+
+        const T &at(const unsigned int i, const unsigned int j) const
+        {
+            return mat[4 * i + j];
+        }
+
+    public:
+        /** \brief Construit l'identite
+         */
+        Affine3x4() : mat{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
+        {
+
+        }
+
+        /** \brief Construit une rotation a partir d'un quaternion unitaire
+         *
+         * \param q Le quaternion ; transform(p) donne le meme resultat que q.rotate(p)
+         */
+        explicit Affine3x4(const Quaternion<T, P> &q)
+        {
+            T r[16];
+            math::simd::QuaternionKernel<T, false>::to_matrix(q.data(), r, 1);
+
+            // r est la matrice du vecteur ligne, A sa transposee
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                for (unsigned int j = 0; j < 3; ++j)
+                    at(i, j) = r[4 * j + i];
+                at(i, 3) = 0;
+            }
+        }
+
+        /** \brief Construit la transformation affine equivalente a une Transformation
+         *
+         * La Transformation utilise la convention du vecteur ligne, (p, 1) * M :
+         * A est la transposee du bloc 3x3 de M et t sa derniere ligne. La derniere
+         * colonne de M, qui n'intervient pas dans le calcul des points, est ignoree.
+         * \param t La transformation
+         */
+        explicit Affine3x4(const Transformation<T, P> &t)
+        {
+            const math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION, P> &m = t.getMatrix();
+
+            for (unsigned int i = 0; i < 3; ++i)
+                for (unsigned int j = 0; j < 4; ++j)
+                    at(i, j) = m[j][i];
+        }
+
+        /** \brief Accede aux coefficients
+         *
+         * \return Les 12 coefficients de [A | t], ligne par ligne
+         */
+        const T *data() const
+        {
+            return mat;
+        }
+
+        /** \brief Obtient un coefficient
+         *
+         * \param i La ligne, entre 0 et 2
+         * \param j La colonne, entre 0 et 3 (3 pour la translation)
+         * \return Le coefficient
+         */
+        T operator()(const unsigned int i, const unsigned int j) const
+        {
+            if (i >= 3 || j >= 4)
+                throw std::out_of_range("No such coefficient");
+
+            return at(i, j);
+        }
+
+        /** \brief Construit la Transformation equivalente, par exemple pour la composer avec une projection
+         *
+         * \return La transformation 4x4, avec la convention du vecteur ligne
+         */
+        Transformation<T, P> toTransformation() const
+        {
+            math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION, P> m;
+
+            for (unsigned int i = 0; i < 3; ++i)
+                for (unsigned int j = 0; j < 4; ++j)
+                    m[j][i] = at(i, j);
+            m[3][3] = 1;
+
+            return Transformation<T, P>(m);
+        }
+
+        /** \brief Concatene deux transformations
+         *
+         * \param t La transformation a appliquer apres la transformation courante
+         * \return La transformation appliquant la transformation courante puis t
+         */
+        Affine3x4 concat(const Affine3x4 &t) const
+        {
+            Affine3x4 result;
+
+            math::simd::AffineKernel<T>::concat(mat, t.mat, result.mat);
+            return result;
+        }
+
+        /** \brief Calcule la transformation inverse
+         *
+         * A est inversee par la methode des cofacteurs, la translation devient -A^-1 t.
+         * \return La transformation inverse
+         */
+        Affine3x4 inverse() const
+        {
+            const T c00 = at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1);
+            const T c01 = at(1, 2) * at(2, 0) - at(1, 0) * at(2, 2);
+            const T c02 = at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0);
+
+            const T det = at(0, 0) * c00 + at(0, 1) * c01 + at(0, 2) * c02;
+
+            if (det == 0)
+                throw std::domain_error("Transformation not inversible");
+
+            const T inv = 1 / det;
+            Affine3x4 result;
+
+            result.at(0, 0) = c00 * inv;
+            result.at(0, 1) = (at(0, 2) * at(2, 1) - at(0, 1) * at(2, 2)) * inv;
+            result.at(0, 2) = (at(0, 1) * at(1, 2) - at(0, 2) * at(1, 1)) * inv;
+            result.at(1, 0) = c01 * inv;
+            result.at(1, 1) = (at(0, 0) * at(2, 2) - at(0, 2) * at(2, 0)) * inv;
+            result.at(1, 2) = (at(0, 2) * at(1, 0) - at(0, 0) * at(1, 2)) * inv;
+            result.at(2, 0) = c02 * inv;
+            result.at(2, 1) = (at(0, 1) * at(2, 0) - at(0, 0) * at(2, 1)) * inv;
+            result.at(2, 2) = (at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0)) * inv;
+            result.translate(*this);
+
+            return result;
+        }
+
+        /** \brief Calcule l'inverse d'une transformation rigide (rotation et translation)
+         *
+         * \return La transformation inverse, A etant simplement transposee
+         */
+        Affine3x4 inverseRigid() const
+        {
+            Affine3x4 result;
+
+            for (unsigned int i = 0; i < 3; ++i)
+                for (unsigned int j = 0; j < 3; ++j)
+                    result.at(i, j) = at(j, i);
+            result.translate(*this);
+
+            return result;
+        }
+
+        /** \brief Transforme un point
+         *
+         * \param p Le point à transformer
+         * \return Le point résultant de la transformation
+         */
+        Point<T, 3, P> transform(const Point<T, 3, P> &p) const
+        {
+            Point<T, 3, P> res;
+
+            math::simd::AffineKernel<T, false>::points(mat, p.data(), res.data(), 1, 0);
+            return res;
+        }
+
+        /** \brief Transforme un ensemble de points, les coefficients n'etant charges qu'une seule fois
+         *
+         * \param points Les points à transformer
+         * \param result Les points transformés, peut être égal à points
+         * \param count Le nombre de points
+         */
+        void transform(const Point<T, 3, P> *points, Point<T, 3, P> *result, const std::size_t count) const
+        {
+            if (count == 0)
+                return;
+
+            math::simd::AffineKernel<T>::points(mat, points->data(), result->data(), count,
+                                                sizeof(Point<T, 3, P>) / sizeof(T));
+        }
+
+        /** \brief Transforme un tableau de points
+         *
+         * \param points Les points à transformer
+         * \param result Les points transformés, redimensionné si nécessaire
+         */
+        void transform(const std::vector<Point<T, 3, P>> &points, std::vector<Point<T, 3, P>> &result) const
+        {
+            result.resize(points.size());
+            transform(points.data(), result.data(), points.size());
+        }
+
+        /** \brief Transforme des points stockés coordonnée par coordonnée
+         *
+         * Les noyaux de Transformation sont utilises : ils ne lisent pas la derniere colonne.
+         * \param x, y, z Les coordonnées des points à transformer
+         * \param outX, outY, outZ Les coordonnées des points transformés, peuvent être égales aux entrées
+         * \param count Le nombre de points
+         */
+        void transform(const T *x, const T *y, const T *z, T *outX, T *outY, T *outZ, const std::size_t count) const
+        {
+            toTransformation().transform(x, y, z, outX, outY, outZ, count);
+        }
+
+        /** \brief Transforme un flux de sommets
+         *
+         * \param vertices Les sommets à transformer
+         * \param result Les sommets transformés, redimensionné si nécessaire, peut être égal à vertices
+         */
+        void transform(const VertexStream<T> &vertices, VertexStream<T> &result) const
+        {
+            toTransformation().transform(vertices, result);
+        }
+
+        /** \brief Transforme des sommets quantifiés, le décodage étant intégré à la matrice
+         *
+         * \param vertices Les sommets quantifiés
+         * \param result Les sommets transformés, redimensionné si nécessaire
+         */
+        void transform(const QuantizedVertexStream<T> &vertices, VertexStream<T> &result) const
+        {
+            toTransformation().transform(vertices, result);
+        }
+
+        /** \brief Transforme une direction, sans la translation
+         *
+         * \param d La direction à transformer
+         * \return La direction résultant de la transformation
+         */
+        Direction<T, 3, P> transform(const Direction<T, 3, P> &d) const
+        {
+            return Direction<T, 3, P>(at(0, 0) * d[0] + at(0, 1) * d[1] + at(0, 2) * d[2],
+                                      at(1, 0) * d[0] + at(1, 1) * d[1] + at(1, 2) * d[2],
+                                      at(2, 0) * d[0] + at(2, 1) * d[1] + at(2, 2) * d[2]);
+        }
+
+        /** \brief Transforme une sphère
+         *
+         * Le rayon est multiplie par une borne superieure du plus grand facteur
+         * d'etirement de A, la racine de la plus grande valeur propre de A^T A.
+         * Celle-ci est majoree par la trace de A^T A et par la plus grande somme
+         * des valeurs absolues d'une ligne (theoreme de Gershgorin) ; la borne est
+         * exacte pour une similitude et pour une mise a l'echelle selon les axes,
+         * et la sphere obtenue contient toujours la sphere transformee.
+         * \param s La sphere à transformer
+         * \return La sphere résultant de la transformation
+         */
+        Sphere<T> transform(const Sphere<T> &s) const
+        {
+            T gram[3][3];
+            for (unsigned int i = 0; i < 3; ++i)
+                for (unsigned int j = 0; j < 3; ++j)
+                    gram[i][j] = at(0, i) * at(0, j) + at(1, i) * at(1, j) + at(2, i) * at(2, j);
+
+            T gershgorin = 0;
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                const T row = std::fabs(gram[i][0]) + std::fabs(gram[i][1]) + std::fabs(gram[i][2]);
+                gershgorin = row > gershgorin ? row : gershgorin;
+            }
+            const T trace = gram[0][0] + gram[1][1] + gram[2][2];
+            const T scale = gershgorin < trace ? gershgorin : trace;
+
+            return Sphere<T>(transform(Point<T, 3, P>(s.getCenter())), s.getRadius() * std::sqrt(scale));
+        }
+
+        /** \brief Transforme une boite alignee sur les axes
+         *
+         * Chaque coordonnee du resultat somme, pour chaque colonne de A, le plus
+         * petit et le plus grand des produits avec les bornes de la boite : la
+         * boite obtenue est la plus petite contenant la boite transformee.
+         * \param min Le coin minimal de la boite
+         * \param max Le coin maximal de la boite
+         * \param resultMin Le coin minimal de la boite transformee
+         * \param resultMax Le coin maximal de la boite transformee
+         */
+        void transformBox(const Point<T, 3, P> &min, const Point<T, 3, P> &max, Point<T, 3, P> &resultMin, Point<T, 3, P> &resultMax) const
+        {
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                T low = at(i, 3), high = at(i, 3);
+
+                for (unsigned int j = 0; j < 3; ++j)
+                {
+                    const T a = at(i, j) * min[j], b = at(i, j) * max[j];
+                    low += a < b ? a : b;
+                    high += a < b ? b : a;
+                }
+                resultMin[i] = low;
+                resultMax[i] = high;
+            }
+        }
+
+        /** \brief Exprime dans le repere de depart un plan du repere d'arrivee
+         *
+         * Un point p est sur le plan (n, d) transforme si n . (A p + t) + d = 0 : le
+         * plan cherche a pour equation (A^T n, n . t + d), normalisee. Aucune
+         * inversion n'est necessaire.
+         * \param plane Le plan, dans le repere d'arrivee
+         * \return Le plan, dans le repere de depart
+         */
+        Plane<T, P> inverseTransform(const Plane<T, P> &plane) const
+        {
+            const math::Vector<T, EQUATION_VECTOR_DIM, P> &e = plane.GetEquation();
+            math::Vector<T, EQUATION_VECTOR_DIM, P> local;
+
+            for (unsigned int j = 0; j < 4; ++j)
+                local[j] = e[0] * at(0, j) + e[1] * at(1, j) + e[2] * at(2, j);
+            local[3] += e[3];
+
+            return Plane<T, P>(local);
+        }
+
+        /**
+         * @brief Comparaison de deux transformations
+         * @param t La transformation a comparer avec la transformation courante
+         * @return true si les coefficients sont identiques, false sinon
+         */
+        bool operator==(const Affine3x4 &t) const
+        {
+            for (unsigned int k = 0; k < 12; ++k)
+                if (mat[k] != t.mat[k])
+                    return false;
+            return true;
+        }
+
+        /** \brief Créer la transformation relative à une translation
+         *
+         * \param x La translation à effectuer en x
+         * \param y La translation à effectuer en y
+         * \param z La translation à effectuer en z
+         * \return La transformation équivalente à la translation mise en paramètre
+         */
+        static Affine3x4 createTranslation(const T x, const T y, const T z)
+        {
+            Affine3x4 t;
+
+            t.at(0, 3) = x;
+            t.at(1, 3) = y;
+            t.at(2, 3) = z;
+
+            return t;
+        }
+
+        /** \brief  Créer la transformation equivalente à la mise à l'echelle demandée
+         *
+         * \param x Le facteur de mise a l'echelle sur l'axe x
+         * \param y Le facteur de mise a l'echelle sur l'axe y
+         * \param z Le facteur de mise a l'echelle sur l'axe z
+         * \return La transformation equivalente à la mise à l'echelle passé en parametre
+         */
+        static Affine3x4 createScaling(const T x, const T y, const T z)
+        {
+            Affine3x4 t;
+
+            t.at(0, 0) = x;
+            t.at(1, 1) = y;
+            t.at(2, 2) = z;
+
+            return t;
+        }
+
+        template <class U, class Q>
+        friend std::ostream& operator<<(std::ostream& out, const Affine3x4<U, Q>& t);
+
+    private:
+        /** \brief Calcule la translation de l'inverse, -A^-1 t, A^-1 etant deja stockee
+         *
+         * \param source La transformation inversee
+         */
+        void translate(const Affine3x4 &source)
+        {
+            for (unsigned int i = 0; i < 3; ++i)
+                at(i, 3) = -(at(i, 0) * source.at(0, 3) + at(i, 1) * source.at(1, 3) + at(i, 2) * source.at(2, 3));
+        }
+    };
+
+    template <class T, class P>
+    std::ostream& operator<<(std::ostream& out, const Affine3x4<T, P>& t)
+    {
+        out << t.at(0, 0) << " " << t.at(0, 1) << " " << t.at(0, 2) << " | " << t.at(0, 3) << std::endl;
+        out << t.at(1, 0) << " " << t.at(1, 1) << " " << t.at(1, 2) << " | " << t.at(1, 3) << std::endl;
+        out << t.at(2, 0) << " " << t.at(2, 1) << " " << t.at(2, 2) << " | " << t.at(2, 3);
+
+        return out;
+    }
+}
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "geometry/Point.hpp"
+#include "geometry/Sphere.hpp"
+#include "geometry/VertexStream.hpp"
+#include "math/Packet.hpp"
+#include "math/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace geometry
+{
+    /** @class BoundingSphere
+     *
+     * Sphere englobante minimale exacte d'un ensemble de points.
+     *
+     * L'algorithme de Welzl, sequentiel, n'est applique qu'a un petit ensemble
+     * support. Celui-ci part des points extremes le long de sept directions
+     * (les axes et les diagonales du cube, comme EPOS-14) ; tant qu'un point sort
+     * de la sphere minimale du support, le plus eloigne est ajoute au support et
+     * la sphere recalculee. Chaque passe sur les points est decoupee en morceaux
+     * repartis sur un ThreadPool et traitee par paquets de quatre (math::Packet).
+     * Quelques passes suffisent en pratique, la sphere grandissant a chacune.
+     */
+    template<class T>
+    class BoundingSphere
+    {
+    private:
+        typedef math::Packet<T, 4> Lanes;
+
+        static constexpr unsigned int directions = 7; /**< Axes et diagonales du cube */
+        static constexpr std::size_t grain = 16384; /**< Taille minimale d'un morceau */
+        static constexpr std::size_t block = std::size_t(1) << 20; /**< Points par bloc, les index etant comptes en T */
+        static constexpr unsigned int passes = 256; /**< Nombre maximal de points ajoutes au support */
+
+        struct Ball
+        {
+            double center[3];
+            double radius2; /**< Rayon au carre, negatif pour la boule vide */
+
+            bool contains(const double *p) const
+            {
+                const double dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+                return dx * dx + dy * dy + dz * dz <= radius2 * (1 + 1e-12);
+            }
+        };
+
+        typedef std::array<double, 3> Vec;
+
+        static double dot(const double *a, const double *b)
+        {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        static void cross(const double *a, const double *b, double *r)
+        {
+            r[0] = a[1] * b[2] - a[2] * b[1];
+            r[1] = a[2] * b[0] - a[0] * b[2];
+            r[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        static Ball ball(const double *center, const double *p)
+        {
+            Ball b{{center[0], center[1], center[2]}, 0};
+            const double d[3] = {p[0] - center[0], p[1] - center[1], p[2] - center[2]};
+            b.radius2 = dot(d, d);
+            return b;
+        }
+
+        /** \brief Plus petite boule dont les points sont sur le bord, au plus quatre
+         *
+         * Les cas degeneres (points alignes ou coplanaires) se ramenent aux boules
+         * de sous-ensembles, la plus petite contenant tous les points etant retenue.
+         */
+        static Ball boundary(const Vec *p, const unsigned int n)
+        {
+            if (n == 0)
+                return Ball{{0, 0, 0}, -1};
+            if (n == 1)
+                return Ball{{p[0][0], p[0][1], p[0][2]}, 0};
+            if (n == 2)
+            {
+                const double c[3] = {(p[0][0] + p[1][0]) / 2, (p[0][1] + p[1][1]) / 2, (p[0][2] + p[1][2]) / 2};
+                return ball(c, p[0].data());
+            }
+
+            const double a[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+            const double b[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+            double axb[3];
+            cross(a, b, axb);
+
+            if (n == 3)
+            {
+                // Centre du cercle circonscrit : p0 + ((|a|^2 b - |b|^2 a) x (a x b)) / (2 |a x b|^2)
+                const double denominator = 2 * dot(axb, axb);
+                if (denominator <= 1e-12 * dot(a, a) * dot(b, b))
+                    return smallest(p, n);
+
+                const double aa = dot(a, a), bb = dot(b, b);
+                const double u[3] = {aa * b[0] - bb * a[0], aa * b[1] - bb * a[1], aa * b[2] - bb * a[2]};
+                double offset[3];
+                cross(u, axb, offset);
+
+                const double c[3] = {p[0][0] + offset[0] / denominator, p[0][1] + offset[1] / denominator, p[0][2] + offset[2] / denominator};
+                return ball(c, p[0].data());
+            }
+
+            // Centre de la sphere circonscrite : 2 (a, b, c) x = (|a|^2, |b|^2, |c|^2), resolu par Cramer
+            const double c[3] = {p[3][0] - p[0][0], p[3][1] - p[0][1], p[3][2] - p[0][2]};
+            const double det = 2 * dot(axb, c);
+            if (std::fabs(det) <= 1e-12 * std::sqrt(dot(a, a) * dot(b, b) * dot(c, c)) * std::sqrt(dot(a, a) + dot(b, b) + dot(c, c)))
+                return smallest(p, n);
+
+            double bxc[3], cxa[3];
+            cross(b, c, bxc);
+            cross(c, a, cxa);
+            const double aa = dot(a, a), bb = dot(b, b), cc = dot(c, c);
+            const double center[3] = {p[0][0] + (aa * bxc[0] + bb * cxa[0] + cc * axb[0]) / det,
+                                      p[0][1] + (aa * bxc[1] + bb * cxa[1] + cc * axb[1]) / det,
+                                      p[0][2] + (aa * bxc[2] + bb * cxa[2] + cc * axb[2]) / det};
+            return ball(center, p[0].data());
+        }
+
+        /** \brief Plus petite boule d'un sous-ensemble de points degeneres les contenant tous
+         */
+        static Ball smallest(const Vec *p, const unsigned int n)
+        {
+            Ball best{{0, 0, 0}, -1};
+
+            for (unsigned int skip = 0; skip < n; ++skip)
+            {
+                Vec subset[3];
+                unsigned int m = 0;
+                for (unsigned int i = 0; i < n; ++i)
+                    if (i != skip)
+                        subset[m++] = p[i];
+
+                const Ball b = boundary(subset, m);
+                bool all = true;
+                for (unsigned int i = 0; i < n && all; ++i)
+                    all = b.contains(p[i].data());
+
+                if (all && (best.radius2 < 0 || b.radius2 < best.radius2))
+                    best = b;
+            }
+            return best;
+        }
+
+        /** \brief Algorithme de Welzl, dans sa variante qui ramene en tete les points hors de la boule
+         *
+         * \param points Les points, reordonnes
+         * \param end Le nombre de points consideres
+         * \param support Les points imposes sur le bord
+         * \param n Le nombre de points imposes
+         */
+        static Ball welzl(std::vector<Vec> &points, const std::size_t end, Vec *support, const unsigned int n)
+        {
+            Ball b = boundary(support, n);
+            if (n == 4)
+                return b;
+
+            for (std::size_t i = 0; i < end; ++i)
+            {
+                if (b.contains(points[i].data()))
+                    continue;
+
+                support[n] = points[i];
+                b = welzl(points, i, support, n + 1);
+                std::rotate(points.begin(), points.begin() + i, points.begin() + i + 1);
+            }
+            return b;
+        }
+
+        /** \brief Cherche, dans un morceau, les points d'abscisse minimale et maximale le long des directions
+         */
+        static void extremes(const VertexStream<T> &points, const std::size_t first, const std::size_t last,
+                             T *low, std::size_t *lowIndex, T *high, std::size_t *highIndex)
+        {
+            static const T axes[directions][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}};
+            const T *x = points.x(), *y = points.y(), *z = points.z();
+
+            for (unsigned int k = 0; k < directions; ++k)
+            {
+                low[k] = high[k] = axes[k][0] * x[first] + axes[k][1] * y[first] + axes[k][2] * z[first];
+                lowIndex[k] = highIndex[k] = first;
+            }
+
+            for (std::size_t start = first; start < last; start += block)
+            {
+                const std::size_t end = std::min(last, start + block), packed = start + (end - start) / 4 * 4;
+                Lanes minimum[directions], maximum[directions], minimumAt[directions], maximumAt[directions];
+                for (unsigned int k = 0; k < directions; ++k)
+                {
+                    minimum[k] = low[k];
+                    maximum[k] = high[k];
+                    minimumAt[k] = maximumAt[k] = T(-1);
+                }
+
+                const Lanes step(4);
+                Lanes at = Lanes::loadu(std::array<T, 4>{{0, 1, 2, 3}}.data());
+                for (std::size_t i = start; i < packed; i += 4, at = at + step)
+                {
+                    const Lanes px = Lanes::loadu(x + i), py = Lanes::loadu(y + i), pz = Lanes::loadu(z + i);
+                    for (unsigned int k = 0; k < directions; ++k)
+                    {
+                        const Lanes d = madd(pz, Lanes(axes[k][2]), madd(py, Lanes(axes[k][1]), px * Lanes(axes[k][0])));
+                        const typename Lanes::mask below = d < minimum[k], above = d > maximum[k];
+                        minimum[k] = select(below, d, minimum[k]);
+                        minimumAt[k] = select(below, at, minimumAt[k]);
+                        maximum[k] = select(above, d, maximum[k]);
+                        maximumAt[k] = select(above, at, maximumAt[k]);
+                    }
+                }
+
+                for (unsigned int k = 0; k < directions; ++k)
+                    for (unsigned int lane = 0; lane < 4; ++lane)
+                    {
+                        if (minimumAt[k][lane] >= 0 && minimum[k][lane] < low[k])
+                        {
+                            low[k] = minimum[k][lane];
+                            lowIndex[k] = start + std::size_t(minimumAt[k][lane]);
+                        }
+                        if (maximumAt[k][lane] >= 0 && maximum[k][lane] > high[k])
+                        {
+                            high[k] = maximum[k][lane];
+                            highIndex[k] = start + std::size_t(maximumAt[k][lane]);
+                        }
+                    }
+
+                for (std::size_t i = packed; i < end; ++i)
+                    for (unsigned int k = 0; k < directions; ++k)
+                    {
+                        const T d = axes[k][0] * x[i] + axes[k][1] * y[i] + axes[k][2] * z[i];
+                        if (d < low[k])
+                        {
+                            low[k] = d;
+                            lowIndex[k] = i;
+                        }
+                        if (d > high[k])
+                        {
+                            high[k] = d;
+                            highIndex[k] = i;
+                        }
+                    }
+            }
+        }
+
+        /** \brief Cherche, dans un morceau, le point le plus eloigne d'un centre
+         *
+         * \return La distance au carre du point trouve, index recevant son index
+         */
+        static T farthest(const VertexStream<T> &points, const std::size_t first, const std::size_t last, const T *center, std::size_t &index)
+        {
+            const T *x = points.x(), *y = points.y(), *z = points.z();
+            const Lanes cx(center[0]), cy(center[1]), cz(center[2]);
+            T best = -1;
+
+            for (std::size_t start = first; start < last; start += block)
+            {
+                const std::size_t end = std::min(last, start + block), packed = start + (end - start) / 4 * 4;
+                Lanes maximum(T(-1)), maximumAt(T(-1));
+
+                const Lanes step(4);
+                Lanes at = Lanes::loadu(std::array<T, 4>{{0, 1, 2, 3}}.data());
+                for (std::size_t i = start; i < packed; i += 4, at = at + step)
+                {
+                    const Lanes dx = Lanes::loadu(x + i) - cx, dy = Lanes::loadu(y + i) - cy, dz = Lanes::loadu(z + i) - cz;
+                    const Lanes d2 = madd(dz, dz, madd(dy, dy, dx * dx));
+                    const typename Lanes::mask above = d2 > maximum;
+                    maximum = select(above, d2, maximum);
+                    maximumAt = select(above, at, maximumAt);
+                }
+
+                for (unsigned int lane = 0; lane < 4; ++lane)
+                    if (maximum[lane] > best)
+                    {
+                        best = maximum[lane];
+                        index = start + std::size_t(maximumAt[lane]);
+                    }
+
+                for (std::size_t i = packed; i < end; ++i)
+                {
+                    const T dx = x[i] - center[0], dy = y[i] - center[1], dz = z[i] - center[2];
+                    const T d2 = dx * dx + dy * dy + dz * dz;
+                    if (d2 > best)
+                    {
+                        best = d2;
+                        index = i;
+                    }
+                }
+            }
+            return best;
+        }
+
+        static Vec point(const VertexStream<T> &points, const std::size_t i)
+        {
+            return Vec{{double(points.x()[i]), double(points.y()[i]), double(points.z()[i])}};
+        }
+
+    public:
+        /** \brief Calcule la sphere englobante minimale d'un ensemble de points
+         *
+         * Le rayon retourne est au moins la distance, calculee en T, du centre au
+         * point le plus eloigne : tous les points sont dans la sphere.
+         * \param points Les points
+         * \param pool Les threads sur lesquels repartir les passes sur les points
+         * \return La sphere englobante minimale, de rayon nul pour un ensemble vide
+         */
+        static Sphere<T> compute(const VertexStream<T> &points, math::ThreadPool &pool = math::ThreadPool::global())
+        {
+            const std::size_t count = points.size();
+            if (count == 0)
+                return Sphere<T>();
+
+            // Support initial : les points extremes le long des sept directions
+            T low[directions], high[directions];
+            std::size_t lowIndex[directions], highIndex[directions];
+            extremes(points, 0, 1, low, lowIndex, high, highIndex);
+
+            std::mutex merge;
+            pool.parallel_for(0, count, grain, [&](const std::size_t first, const std::size_t last) {
+                T chunkLow[directions], chunkHigh[directions];
+                std::size_t chunkLowIndex[directions], chunkHighIndex[directions];
+                extremes(points, first, last, chunkLow, chunkLowIndex, chunkHigh, chunkHighIndex);
+
+                std::lock_guard<std::mutex> guard(merge);
+                for (unsigned int k = 0; k < directions; ++k)
+                {
+                    if (chunkLow[k] < low[k])
+                    {
+                        low[k] = chunkLow[k];
+                        lowIndex[k] = chunkLowIndex[k];
+                    }
+                    if (chunkHigh[k] > high[k])
+                    {
+                        high[k] = chunkHigh[k];
+                        highIndex[k] = chunkHighIndex[k];
+                    }
+                }
+            });
+
+            std::vector<std::size_t> chosen(lowIndex, lowIndex + directions);
+            chosen.insert(chosen.end(), highIndex, highIndex + directions);
+            std::sort(chosen.begin(), chosen.end());
+            chosen.erase(std::unique(chosen.begin(), chosen.end()), chosen.end());
+
+            std::vector<Vec> support;
+            for (const std::size_t i : chosen)
+                support.push_back(point(points, i));
+
+            // Ordre aleatoire, mais reproductible, pour l'esperance lineaire de Welzl
+            std::minstd_rand random(static_cast<unsigned int>(count));
+            std::shuffle(support.begin(), support.end(), random);
+
+            for (unsigned int pass = 0;; ++pass)
+            {
+                Vec boundaryPoints[4];
+                const Ball b = welzl(support, support.size(), boundaryPoints, 0);
+                const T center[3] = {T(b.center[0]), T(b.center[1]), T(b.center[2])};
+                const T radius = T(std::sqrt(b.radius2));
+
+                T best = -1;
+                std::size_t index = 0;
+                pool.parallel_for(0, count, grain, [&](const std::size_t first, const std::size_t last) {
+                    std::size_t chunkIndex = first;
+                    const T d2 = farthest(points, first, last, center, chunkIndex);
+
+                    std::lock_guard<std::mutex> guard(merge);
+                    if (d2 > best)
+                    {
+                        best = d2;
+                        index = chunkIndex;
+                    }
+                });
+
+                // Les points a l'arrondi pres du bord ne relancent pas le calcul mais agrandissent le rayon,
+                // comme, par securite, tous les points restants apres le nombre maximal de passes
+                const T distance = std::sqrt(best);
+                if (distance <= radius * (1 + T(1e-5)) || pass == passes)
+                    return Sphere<T>(Point<T, 3>{center[0], center[1], center[2]}, std::max(radius, distance));
+
+                support.insert(support.begin(), point(points, index));
+            }
+        }
+    };
+}
@@ -2,6 +2,8 @@
 
 #include "math/Vector.hpp"
 
+#include <type_traits>
+
 /**
  * @namespace geometry
  *
@@ -14,21 +16,24 @@ namespace geometry
      * @brief Représente une direction
      *
      * Représente une direction de dimension N, où les coordonnées sont de type T
+     * et les calculs arrondis selon la politique de precision P
      */
-    template <class T, unsigned int N>
-    class Direction : public math::Vector<T, N>
+    template <class T, unsigned int N, class P = math::Exact>
+    class Direction : public math::Vector<T, N, P>
     {
     public:
-        using math::Vector<T, N>::Vector; /*<! Indique l'usage des constructeurs de Vector comme constructeurs de Direction */
+        using math::Vector<T, N, P>::Vector; /*<! Indique l'usage des constructeurs de Vector comme constructeurs de Direction */
         
-        Direction(const math::Vector<T, N> &v) : Direction::Vector(v)
+        constexpr Direction(const math::Vector<T, N, P> &v) : Direction::Vector(v)
         {
             
         }
         
-        Direction() : Direction::Vector()
+        constexpr Direction() : Direction::Vector()
         {
             
         }
     };
+
+    static_assert(std::is_trivially_copyable<Direction<float, 3>>::value, "Direction must be trivially copyable");
 }
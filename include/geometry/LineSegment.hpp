@@ -3,6 +3,7 @@
 #include "geometry/Point.hpp"
 
 #include <iostream>
+#include <type_traits>
 
 /**
  * @namespace geometry
@@ -25,18 +26,9 @@ namespace geometry
          * \param begin Le point de départ du segment
          * \param end Le point d'arrivée du segment
          */
-        LineSegment(Point<T, N> begin, Point<T, N> end) : begin(begin), end(end)
+        constexpr LineSegment(Point<T, N> begin, Point<T, N> end) : begin(begin), end(end)
         {
 
-        }
-        
-        /**
-         * @brief Constructeur par recopie
-         * @param ls
-         */
-        LineSegment(const LineSegment& ls) : begin(ls.begin), end(ls.end)
-        {
-            
         }
 
         /** \brief Accesseur pour le point de départ
@@ -76,5 +68,9 @@ namespace geometry
     std::ostream& operator<<(std::ostream& out, const LineSegment<T, N> &ls)
     {
         out << "Begin : " << ls.get_begin() << ", end : " << ls.get_end();
+
+        return out;
     }
+
+    static_assert(std::is_trivially_copyable<LineSegment<float, 3>>::value, "LineSegment must be trivially copyable");
 }
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "geometry/Point.hpp"
+#include "geometry/Direction.hpp"
+#include "geometry/VertexStream.hpp"
+#include "geometry/Affine3x4.hpp"
+#include "math/Vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class OBB
+     *
+     * Boite orientee, decrite par son centre, trois axes orthonormes et ses
+     * demi-cotes le long de ces axes. Elle englobe mieux qu'une sphere ou
+     * qu'une boite alignee les objets allonges ou penches.
+     */
+    template <class T>
+    class OBB
+    {
+    private:
+        Point<T, 3> center; /**< Centre de la boite */
+        Direction<T, 3> axes[3]; /**< Axes orthonormes de la boite */
+        math::Vector<T, 3> extent; /**< Demi-cotes le long des axes, positifs */
+
+        /** \brief Vecteurs propres d'une matrice symetrique 3x3, par la methode de Jacobi
+         *
+         * \param a La matrice, diagonalisee
+         * \param v Les vecteurs propres, en colonnes
+         */
+        static void jacobi(double a[3][3], double v[3][3])
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    v[i][j] = i == j;
+
+            for (int sweep = 0; sweep < 50; ++sweep)
+            {
+                const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+                const double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+                if (off <= 1e-24 * diagonal || off == 0)
+                    return;
+
+                for (int p = 0; p < 2; ++p)
+                    for (int q = p + 1; q < 3; ++q)
+                    {
+                        if (a[p][q] == 0)
+                            continue;
+
+                        // Rotation annulant a[p][q]
+                        const double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                        const double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                        const double c = 1 / std::sqrt(t * t + 1), s = t * c;
+
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const double akp = a[k][p], akq = a[k][q];
+                            a[k][p] = c * akp - s * akq;
+                            a[k][q] = s * akp + c * akq;
+                        }
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const double apk = a[p][k], aqk = a[q][k];
+                            a[p][k] = c * apk - s * aqk;
+                            a[q][k] = s * apk + c * aqk;
+                        }
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const double vkp = v[k][p], vkq = v[k][q];
+                            v[k][p] = c * vkp - s * vkq;
+                            v[k][q] = s * vkp + c * vkq;
+                        }
+                    }
+            }
+        }
+
+    public:
+        /** \brief Construit une boite vide, reduite a l'origine et alignee sur les axes
+         */
+        OBB() : center(), axes{Direction<T, 3>{1, 0, 0}, Direction<T, 3>{0, 1, 0}, Direction<T, 3>{0, 0, 1}}, extent()
+        {
+        }
+
+        /** \brief Construit une boite avec son centre, ses axes et ses demi-cotes
+         *
+         * \param center Le centre de la boite
+         * \param u, v, w Les axes de la boite, orthonormes
+         * \param extent Les demi-cotes le long des axes
+         */
+        OBB(const Point<T, 3> &center, const Direction<T, 3> &u, const Direction<T, 3> &v, const Direction<T, 3> &w,
+            const math::Vector<T, 3> &extent) : center(center), axes{u, v, w}, extent(extent)
+        {
+        }
+
+        /** \brief Construit une boite contenant des points, orientee selon leurs axes principaux
+         *
+         * Les axes sont les vecteurs propres de la matrice de covariance des points ;
+         * les demi-cotes sont ajustes aux projections extremes sur ces axes.
+         * \param points Les points
+         * \return La boite, reduite a l'origine s'il n'y a pas de point
+         */
+        static OBB fromPoints(const VertexStream<T> &points)
+        {
+            const std::size_t count = points.size();
+            if (count == 0)
+                return OBB();
+
+            const T *x = points.x(), *y = points.y(), *z = points.z();
+            double mean[3] = {0, 0, 0};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mean[0] += x[i];
+                mean[1] += y[i];
+                mean[2] += z[i];
+            }
+            for (int c = 0; c < 3; ++c)
+                mean[c] /= count;
+
+            double covariance[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const double d[3] = {x[i] - mean[0], y[i] - mean[1], z[i] - mean[2]};
+                for (int r = 0; r < 3; ++r)
+                    for (int c = r; c < 3; ++c)
+                        covariance[r][c] += d[r] * d[c];
+            }
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < r; ++c)
+                    covariance[r][c] = covariance[c][r];
+
+            double v[3][3];
+            jacobi(covariance, v);
+
+            // Base orthonormee directe, le troisieme axe etant recalcule pour absorber les arrondis
+            Direction<T, 3> u{T(v[0][0]), T(v[1][0]), T(v[2][0])}, w{T(v[0][1]), T(v[1][1]), T(v[2][1])};
+            u = u.to_unit();
+            const math::Vector<T, 3> orthogonal = w - u * T(u * w);
+            w = orthogonal.to_unit();
+            const Direction<T, 3> n{u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+            const Direction<T, 3> basis[3] = {u, w, n};
+
+            T low[3], high[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                low[a] = std::numeric_limits<T>::max();
+                high[a] = -std::numeric_limits<T>::max();
+            }
+            for (std::size_t i = 0; i < count; ++i)
+                for (int a = 0; a < 3; ++a)
+                {
+                    const T d = basis[a][0] * x[i] + basis[a][1] * y[i] + basis[a][2] * z[i];
+                    low[a] = std::min(low[a], d);
+                    high[a] = std::max(high[a], d);
+                }
+
+            Point<T, 3> center;
+            math::Vector<T, 3> extent;
+            for (int a = 0; a < 3; ++a)
+            {
+                const T middle = (low[a] + high[a]) / 2;
+                for (int c = 0; c < 3; ++c)
+                    center[c] += middle * basis[a][c];
+                extent[a] = (high[a] - low[a]) / 2;
+            }
+            return OBB(center, u, w, n, extent);
+        }
+
+        /** \brief Accesseur pour le centre de la boite
+         */
+        const Point<T, 3> &getCenter() const
+        {
+            return center;
+        }
+
+        /** \brief Accesseur pour un axe de la boite
+         *
+         * \param i L'index de l'axe, de 0 a 2
+         */
+        const Direction<T, 3> &getAxis(const unsigned int i) const
+        {
+            if (i >= 3)
+                throw std::out_of_range("An OBB has three axes");
+            return axes[i];
+        }
+
+        /** \brief Accesseur pour les demi-cotes de la boite, le long de ses axes
+         */
+        const math::Vector<T, 3> &getExtent() const
+        {
+            return extent;
+        }
+
+        /** \brief Volume de la boite
+         */
+        T volume() const
+        {
+            return 8 * extent[0] * extent[1] * extent[2];
+        }
+
+        /** \brief Verifie si un point est dans la boite
+         *
+         * \param p Le point
+         * \param tolerance La marge toleree, le long de chaque axe
+         * \return true si le point est dans la boite, bord compris
+         */
+        bool contains(const Point<T, 3> &p, const T tolerance = 0) const
+        {
+            const math::Vector<T, 3> d = p - center;
+            for (int a = 0; a < 3; ++a)
+                if (std::fabs(T(axes[a] * d)) > extent[a] + tolerance)
+                    return false;
+            return true;
+        }
+
+        /** \brief Transforme la boite
+         *
+         * Les axes transformes sont renormalises et les demi-cotes multiplies par
+         * leur longueur : le resultat est exact pour une similitude (rotation,
+         * translation et mise a l'echelle uniforme). Les axes d'une transformation
+         * avec cisaillement ne restant pas orthogonaux, la boite ne serait alors
+         * plus qu'approchee.
+         * \param t La transformation
+         * \return La boite transformee
+         */
+        OBB transform(const Affine3x4<T> &t) const
+        {
+            Direction<T, 3> moved[3];
+            math::Vector<T, 3> scaled;
+            for (int a = 0; a < 3; ++a)
+            {
+                const Direction<T, 3> d = t.transform(axes[a]);
+                const T length = std::sqrt(T(d * d));
+                moved[a] = length > 0 ? Direction<T, 3>(d * (1 / length)) : axes[a];
+                scaled[a] = extent[a] * length;
+            }
+            return OBB(t.transform(center), moved[0], moved[1], moved[2], scaled);
+        }
+    };
+
+    template<class T>
+    std::ostream& operator<<(std::ostream& out, const OBB<T> &b)
+    {
+        out << "Centre : " << b.getCenter() << " axes : " << b.getAxis(0) << ", " << b.getAxis(1) << ", " << b.getAxis(2)
+            << " demi-cotes : " << b.getExtent();
+        return out;
+    }
+
+    static_assert(std::is_trivially_copyable<OBB<float>>::value, "OBB must be trivially copyable");
+}
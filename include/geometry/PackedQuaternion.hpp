@@ -0,0 +1,427 @@
+#pragma once
+
+#include "math/Simd.hpp"
+#include "geometry/Quaternion.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class SmallestThree
+     *
+     * Codage "smallest three" d'un quaternion unitaire : q et -q representant la
+     * meme rotation, la plus grande composante (en valeur absolue) est rendue
+     * positive et omise, puis retrouvee au decodage par sqrt(1 - a^2 - b^2 - c^2).
+     * Les trois autres sont dans [-1/sqrt(2), 1/sqrt(2)] et sont quantifiees sur
+     * bits bits ; l'index de la composante omise occupe 2 bits.
+     *
+     * L'erreur sur chacune des trois composantes stockees est bornee par
+     * component_error() (un demi pas de quantification), l'erreur angulaire par
+     * angle_error(). Avec SSE, quatre quaternions sont codes ou decodes a chaque
+     * iteration, avec les memes operations que la version scalaire : les
+     * resultats sont identiques.
+     */
+    template<unsigned int bits>
+    struct SmallestThree
+    {
+        static constexpr std::uint32_t max = (1u << bits) - 1; /**< Plus grande valeur quantifiee */
+
+        /** \brief Borne de l'erreur sur une composante stockee
+         */
+        static float component_error()
+        {
+            return 0.70710678f / max;
+        }
+
+        /** \brief Borne de l'erreur angulaire, en radians
+         *
+         * La composante retrouvee a une erreur d'au plus 3 * component_error() (elle
+         * vaut au moins 1/2), l'ecart entre les deux quaternions est donc inferieur a
+         * 4 * component_error() et l'angle de la rotation entre eux au double.
+         */
+        static float angle_error()
+        {
+            return 8 * component_error();
+        }
+
+        /** \brief Pas de quantification divise par 2 / sqrt(2), pour le codage
+         */
+        static float encode_scale()
+        {
+            return max * 0.70710678f;
+        }
+
+        /** \brief Pas de quantification, pour le decodage
+         */
+        static float decode_scale()
+        {
+            return 1.41421356f / max;
+        }
+
+        /** \brief Code un quaternion unitaire
+         *
+         * \param q Les membres (reel, im1, im2, im3)
+         * \param index L'index de la composante omise
+         * \param c Les trois autres composantes, quantifiees
+         */
+        static void encode(const float *q, std::uint32_t &index, std::uint32_t *c)
+        {
+            unsigned int largest = 0;
+            for (unsigned int j = 1; j < 4; ++j)
+                if (std::fabs(q[j]) > std::fabs(q[largest]))
+                    largest = j;
+
+            const float sign = q[largest] < 0 ? -1.f : 1.f;
+            const float scale = encode_scale(), offset = 0.5f * max;
+
+            for (unsigned int j = 0, k = 0; j < 4; ++j)
+            {
+                if (j == largest)
+                    continue;
+
+                const float v = std::nearbyint((sign * q[j]) * scale + offset);
+                c[k++] = std::uint32_t(v < 0 ? 0 : (v > max ? max : v));
+            }
+
+            index = largest;
+        }
+
+        /** \brief Decode un quaternion unitaire
+         *
+         * \param index L'index de la composante omise
+         * \param c Les trois autres composantes, quantifiees
+         * \param q Les membres (reel, im1, im2, im3)
+         */
+        static void decode(const std::uint32_t index, const std::uint32_t *c, float *q)
+        {
+            const float scale = decode_scale(), offset = 0.70710678f;
+            float v[3];
+
+            for (unsigned int k = 0; k < 3; ++k)
+                v[k] = float(int(c[k])) * scale - offset;
+
+            const float rest = 1 - v[0] * v[0] - v[1] * v[1] - v[2] * v[2];
+            const float largest = std::sqrt(rest > 0 ? rest : 0);
+
+            for (unsigned int j = 0, k = 0; j < 4; ++j)
+                q[j] = j == index ? largest : v[k++];
+        }
+
+#ifdef MATH_SIMD_SSE
+        /** \brief Code quatre quaternions unitaires, ranges les uns a la suite des autres
+         */
+        static void encode4(const float *q, __m128i &index, __m128i &c0, __m128i &c1, __m128i &c2)
+        {
+            __m128 w = _mm_loadu_ps(q), x = _mm_loadu_ps(q + 4), y = _mm_loadu_ps(q + 8), z = _mm_loadu_ps(q + 12);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+
+            const __m128 signBit = _mm_set1_ps(-0.f);
+            const __m128 values[4] = {w, x, y, z};
+
+            __m128 best = _mm_andnot_ps(signBit, w), big = w;
+            __m128i largest = _mm_setzero_si128();
+            for (int j = 1; j < 4; ++j)
+            {
+                const __m128 a = _mm_andnot_ps(signBit, values[j]);
+                const __m128 gt = _mm_cmpgt_ps(a, best);
+
+                best = select(gt, a, best);
+                big = select(gt, values[j], big);
+                largest = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(gt), largest), _mm_and_si128(_mm_castps_si128(gt), _mm_set1_epi32(j)));
+            }
+
+            // Les trois composantes restantes, dans l'ordre
+            const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_setzero_si128()));
+            const __m128 upTo1 = _mm_castsi128_ps(_mm_cmplt_epi32(largest, _mm_set1_epi32(2)));
+            const __m128 upTo2 = _mm_castsi128_ps(_mm_cmplt_epi32(largest, _mm_set1_epi32(3)));
+            const __m128 sign = _mm_and_ps(big, signBit);
+
+            const __m128 scale = _mm_set1_ps(encode_scale()), offset = _mm_set1_ps(0.5f * max);
+            const __m128 s0 = _mm_xor_ps(select(is0, x, w), sign);
+            const __m128 s1 = _mm_xor_ps(select(upTo1, y, x), sign);
+            const __m128 s2 = _mm_xor_ps(select(upTo2, z, y), sign);
+
+            index = largest;
+            c0 = quantize(_mm_add_ps(_mm_mul_ps(s0, scale), offset));
+            c1 = quantize(_mm_add_ps(_mm_mul_ps(s1, scale), offset));
+            c2 = quantize(_mm_add_ps(_mm_mul_ps(s2, scale), offset));
+        }
+
+        /** \brief Decode quatre quaternions unitaires et les range les uns a la suite des autres
+         */
+        static void decode4(const __m128i index, const __m128i c0, const __m128i c1, const __m128i c2, float *q)
+        {
+            const __m128 scale = _mm_set1_ps(decode_scale()), offset = _mm_set1_ps(0.70710678f);
+            const __m128 v0 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(c0), scale), offset);
+            const __m128 v1 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(c1), scale), offset);
+            const __m128 v2 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(c2), scale), offset);
+
+            const __m128 rest = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1), _mm_mul_ps(v0, v0)), _mm_mul_ps(v1, v1)), _mm_mul_ps(v2, v2));
+            const __m128 largest = _mm_sqrt_ps(_mm_max_ps(rest, _mm_setzero_ps()));
+
+            const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+            const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+            const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+            const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+            const __m128 above1 = _mm_castsi128_ps(_mm_cmpgt_epi32(index, _mm_set1_epi32(1)));
+
+            __m128 w = select(is0, largest, v0);
+            __m128 x = select(above1, v1, select(is1, largest, v0));
+            __m128 y = select(is3, v2, select(is2, largest, v1));
+            __m128 z = select(is3, largest, v2);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+
+            _mm_storeu_ps(q, w);
+            _mm_storeu_ps(q + 4, x);
+            _mm_storeu_ps(q + 8, y);
+            _mm_storeu_ps(q + 12, z);
+        }
+
+    private:
+        static __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        /** \brief Arrondi au plus proche, comme std::nearbyint, puis ramene dans [0, max]
+         */
+        static __m128i quantize(const __m128 v)
+        {
+            const __m128 clamped = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(float(max)));
+            return _mm_cvtps_epi32(clamped);
+        }
+#endif
+    };
+
+    template<unsigned int bits>
+    constexpr std::uint32_t SmallestThree<bits>::max;
+
+    /** @class PackedQuaternion48
+     *
+     * Quaternion unitaire code sur 48 bits (trois mots de 16 bits) : trois
+     * composantes sur 15 bits, l'index de la composante omise dans les bits de
+     * poids fort des deux premiers mots. Erreur angulaire inferieure a 1.8e-4 radian.
+     */
+    struct PackedQuaternion48
+    {
+        typedef SmallestThree<15> Codec;
+
+        std::uint16_t words[3]; /**< Mots du codage */
+
+        /** \brief Assemble les mots a partir du codage
+         */
+        void set(const std::uint32_t index, const std::uint32_t *c)
+        {
+            words[0] = std::uint16_t(c[0] | ((index & 2) << 14));
+            words[1] = std::uint16_t(c[1] | ((index & 1) << 15));
+            words[2] = std::uint16_t(c[2]);
+        }
+
+        /** \brief Extrait le codage des mots
+         */
+        std::uint32_t get(std::uint32_t *c) const
+        {
+            c[0] = words[0] & Codec::max;
+            c[1] = words[1] & Codec::max;
+            c[2] = words[2] & Codec::max;
+
+            return ((words[0] >> 14) & 2) | (words[1] >> 15);
+        }
+    };
+
+    /** @class PackedQuaternion32
+     *
+     * Quaternion unitaire code sur 32 bits : index de la composante omise sur les
+     * 2 bits de poids fort, puis trois composantes sur 10 bits. Erreur angulaire
+     * inferieure a 5.6e-3 radian.
+     */
+    struct PackedQuaternion32
+    {
+        typedef SmallestThree<10> Codec;
+
+        std::uint32_t word; /**< Mot du codage */
+
+        void set(const std::uint32_t index, const std::uint32_t *c)
+        {
+            word = (index << 30) | (c[0] << 20) | (c[1] << 10) | c[2];
+        }
+
+        std::uint32_t get(std::uint32_t *c) const
+        {
+            c[0] = (word >> 20) & Codec::max;
+            c[1] = (word >> 10) & Codec::max;
+            c[2] = word & Codec::max;
+
+            return word >> 30;
+        }
+    };
+
+    static_assert(sizeof(PackedQuaternion48) == 6, "PackedQuaternion48 must take 6 bytes");
+    static_assert(sizeof(PackedQuaternion32) == 4, "PackedQuaternion32 must take 4 bytes");
+
+    /** \brief Code un quaternion unitaire
+     *
+     * \param q Le quaternion
+     * \return Le quaternion code au format Packed
+     */
+    template<class Packed, class T, class P>
+    Packed pack(const Quaternion<T, P> &q)
+    {
+        const float members[4] = {float(q.data()[0]), float(q.data()[1]), float(q.data()[2]), float(q.data()[3])};
+        std::uint32_t index, c[3];
+        Packed::Codec::encode(members, index, c);
+
+        Packed res;
+        res.set(index, c);
+        return res;
+    }
+
+    /** \brief Decode un quaternion unitaire
+     *
+     * \param packed Le quaternion code
+     * \return Le quaternion, unitaire a l'erreur de quantification pres
+     */
+    template<class T, class P = math::Exact, class Packed>
+    Quaternion<T, P> unpack(const Packed &packed)
+    {
+        std::uint32_t c[3];
+        const std::uint32_t index = packed.get(c);
+
+        float members[4];
+        Packed::Codec::decode(index, c, members);
+
+        return Quaternion<T, P>(math::Vector<T, QUATERNION_DIMENSION, P>(T(members[0]), T(members[1]), T(members[2]), T(members[3])));
+    }
+
+    /** \brief Code un tableau de quaternions unitaires, quatre a la fois avec SSE
+     *
+     * \param q Les quaternions
+     * \param result Les quaternions codes
+     * \param count Le nombre de quaternions
+     */
+    template<class Packed, class T, class P>
+    void pack(const Quaternion<T, P> *q, Packed *result, const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = pack<Packed>(q[i]);
+    }
+
+    /** \brief Decode un tableau de quaternions unitaires, quatre a la fois avec SSE
+     *
+     * \param packed Les quaternions codes
+     * \param result Les quaternions
+     * \param count Le nombre de quaternions
+     */
+    template<class Packed, class T, class P>
+    void unpack(const Packed *packed, Quaternion<T, P> *result, const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = unpack<T, P>(packed[i]);
+    }
+
+#ifdef MATH_SIMD_SSE
+    /** \brief PackedQuaternion48 : les mots sont assembles dans les registres
+     */
+    template<class P>
+    void pack(const Quaternion<float, P> *q, PackedQuaternion48 *result, const std::size_t count)
+    {
+        static_assert(sizeof(Quaternion<float, P>) == 4 * sizeof(float), "Quaternions must be packed");
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i index, c0, c1, c2;
+            PackedQuaternion48::Codec::encode4(q[i].data(), index, c0, c1, c2);
+
+            alignas(16) std::uint32_t words[3][4];
+            _mm_store_si128(reinterpret_cast<__m128i *>(words[0]), _mm_or_si128(c0, _mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(2)), 14)));
+            _mm_store_si128(reinterpret_cast<__m128i *>(words[1]), _mm_or_si128(c1, _mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(1)), 15)));
+            _mm_store_si128(reinterpret_cast<__m128i *>(words[2]), c2);
+
+            for (int l = 0; l < 4; ++l)
+                for (int w = 0; w < 3; ++w)
+                    result[i + l].words[w] = std::uint16_t(words[w][l]);
+        }
+
+        for (; i < count; ++i)
+            result[i] = pack<PackedQuaternion48>(q[i]);
+    }
+
+    /** \brief PackedQuaternion32 : les champs sont assembles dans les registres
+     */
+    template<class P>
+    void pack(const Quaternion<float, P> *q, PackedQuaternion32 *result, const std::size_t count)
+    {
+        static_assert(sizeof(Quaternion<float, P>) == 4 * sizeof(float), "Quaternions must be packed");
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i index, c0, c1, c2;
+            PackedQuaternion32::Codec::encode4(q[i].data(), index, c0, c1, c2);
+
+            const __m128i word = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(index, 30), _mm_slli_epi32(c0, 20)),
+                                              _mm_or_si128(_mm_slli_epi32(c1, 10), c2));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(result + i), word);
+        }
+
+        for (; i < count; ++i)
+            result[i] = pack<PackedQuaternion32>(q[i]);
+    }
+
+    /** \brief PackedQuaternion48 : les champs sont extraits dans les registres
+     */
+    template<class P>
+    void unpack(const PackedQuaternion48 *packed, Quaternion<float, P> *result, const std::size_t count)
+    {
+        static_assert(sizeof(Quaternion<float, P>) == 4 * sizeof(float), "Quaternions must be packed");
+
+        const __m128i mask = _mm_set1_epi32(PackedQuaternion48::Codec::max);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const PackedQuaternion48 *p = packed + i;
+            const __m128i w0 = _mm_set_epi32(p[3].words[0], p[2].words[0], p[1].words[0], p[0].words[0]);
+            const __m128i w1 = _mm_set_epi32(p[3].words[1], p[2].words[1], p[1].words[1], p[0].words[1]);
+            const __m128i w2 = _mm_set_epi32(p[3].words[2], p[2].words[2], p[1].words[2], p[0].words[2]);
+            const __m128i index = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(w0, 14), _mm_set1_epi32(2)), _mm_srli_epi32(w1, 15));
+
+            PackedQuaternion48::Codec::decode4(index, _mm_and_si128(w0, mask), _mm_and_si128(w1, mask), w2, result[i].data());
+        }
+
+        for (; i < count; ++i)
+            result[i] = unpack<float, P>(packed[i]);
+    }
+
+    /** \brief PackedQuaternion32 : les champs sont extraits dans les registres
+     */
+    template<class P>
+    void unpack(const PackedQuaternion32 *packed, Quaternion<float, P> *result, const std::size_t count)
+    {
+        static_assert(sizeof(Quaternion<float, P>) == 4 * sizeof(float), "Quaternions must be packed");
+
+        const __m128i mask = _mm_set1_epi32(PackedQuaternion32::Codec::max);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i *>(packed + i));
+
+            PackedQuaternion32::Codec::decode4(_mm_srli_epi32(word, 30), _mm_and_si128(_mm_srli_epi32(word, 20), mask),
+                                               _mm_and_si128(_mm_srli_epi32(word, 10), mask), _mm_and_si128(word, mask),
+                                               result[i].data());
+        }
+
+        for (; i < count; ++i)
+            result[i] = unpack<float, P>(packed[i]);
+    }
+#endif
+}
@@ -3,9 +3,12 @@
 #include "geometry/LineSegment.hpp"
 #include "geometry/Point.hpp"
 #include "geometry/Direction.hpp"
+#include "math/Packet.hpp"
 
+#include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
 
 #define EQUATION_VECTOR_DIM 4
 #define PLANE_DIMENSION 3
@@ -17,13 +20,17 @@
  */
 namespace geometry
 {
-template <class T>
+/**
+ * @class Plane
+ * @brief Plan de l'espace, dont les calculs sont arrondis selon la politique de precision P
+ */
+template <class T, class P = math::Exact>
 class Plane
 {
 private:
-    Point<T, PLANE_DIMENSION> p; /**< Le point par lequelle le point passe */
-    math::Vector<T, EQUATION_VECTOR_DIM> equation; /**< L'equation du plan */
-    Direction<T, PLANE_DIMENSION> n; /**< Normale du plan */
+    Point<T, PLANE_DIMENSION, P> p; /**< Le point par lequelle le point passe */
+    math::Vector<T, EQUATION_VECTOR_DIM, P> equation; /**< L'equation du plan */
+    Direction<T, PLANE_DIMENSION, P> n; /**< Normale du plan */
 public:
 
     /** \brief Construit un plan à l'aide du point par lequel il passe et un vector normal
@@ -32,9 +39,9 @@ public:
      * \param n Le vecteur normal perpendiculaire au point p
      * \return Plane(Point<T, PLANE_DIMENSION> &p, Direction<T, PLANE_DIMENSION> &n):
      */
-    Plane(const Point<T, PLANE_DIMENSION> &p, const Direction<T, PLANE_DIMENSION> &n) : p(p), n(n) {
+    Plane(const Point<T, PLANE_DIMENSION, P> &p, const Direction<T, PLANE_DIMENSION, P> &n) : p(p), n(n) {
         if (! this->n.is_unit())
-            this->n = Direction<T, PLANE_DIMENSION>(this->n.to_unit());
+            this->n = Direction<T, PLANE_DIMENSION, P>(this->n.to_unit());
 
         equation[0] = this->n[0];
         equation[1] = this->n[1];
@@ -42,10 +49,26 @@ public:
         equation[3] = -(this->n * p);
     }
     
+    /** \brief Construit un plan a partir de son equation
+     *
+     * \param equation Les coefficients (a, b, c, d) de a*x + b*y + c*z + d = 0, (a, b, c) non nul
+     */
+    explicit Plane(const math::Vector<T, EQUATION_VECTOR_DIM, P> &equation) {
+        const T length = std::sqrt(equation[0] * equation[0] + equation[1] * equation[1] + equation[2] * equation[2]);
+        if (length == 0)
+            throw(std::invalid_argument("The normal of a plane can't be null"));
+
+        for (int c = 0; c < EQUATION_VECTOR_DIM; ++c)
+            this->equation[c] = equation[c] / length;
+
+        n = Direction<T, PLANE_DIMENSION, P> {this->equation[0], this->equation[1], this->equation[2]};
+        p = Point<T, PLANE_DIMENSION, P> {-this->equation[3] * n[0], -this->equation[3] * n[1], -this->equation[3] * n[2]};
+    }
+    
     /**
      * @brief Constructeur par défaut
      */
-    Plane()
+    constexpr Plane() : p(), equation(), n()
     {
     }
 
@@ -54,7 +77,7 @@ public:
      * \param p Le point à tester
      * \return n < 0 si le point est derriere, n = 0 si le point appartient au plan, n > 0 si le point est devant
      */
-    double positionFrom(const Point<T, PLANE_DIMENSION> &pt) const {
+    double positionFrom(const Point<T, PLANE_DIMENSION, P> &pt) const {
         return (n * pt) + equation[3];
     }
 
@@ -63,7 +86,7 @@ public:
      * \param p Le point dont on souhaite connaitre la disposition par rapport au plan
      * \return true si le plan est devant le plan, false sinon
      */
-    bool isFrontOf(const Point<T, PLANE_DIMENSION> &pt) const {
+    bool isFrontOf(const Point<T, PLANE_DIMENSION, P> &pt) const {
         return positionFrom(pt) < 0;
     }
 
@@ -72,18 +95,18 @@ public:
      * \param ls Le segement de droite
      * \return Le point d'intersection entre le plan et la droite
      */
-    Point<T, PLANE_DIMENSION> intersec(const LineSegment<T, PLANE_DIMENSION> &ls) const {
+    Point<T, PLANE_DIMENSION, P> intersec(const LineSegment<T, PLANE_DIMENSION> &ls) const {
         double coef = intersectCoef(ls);
         if (coef < 0)
             throw(std::runtime_error("This function can be only called if there is an intersection point"));
 
-        Point<T, EQUATION_VECTOR_DIM> s {ls.get_begin()[0], ls.get_begin()[1], ls.get_begin()[2], 1};
-        Direction<T, PLANE_DIMENSION> dir {ls.get_begin().length_to(ls.get_end())};
-        Direction<T, EQUATION_VECTOR_DIM> adaptedDir {dir[0], dir[1], dir[2], T()};
+        Point<T, EQUATION_VECTOR_DIM, P> s {ls.get_begin()[0], ls.get_begin()[1], ls.get_begin()[2], 1};
+        Direction<T, PLANE_DIMENSION, P> dir {ls.get_begin().length_to(ls.get_end())};
+        Direction<T, EQUATION_VECTOR_DIM, P> adaptedDir {dir[0], dir[1], dir[2], T()};
 
-        Point<T, EQUATION_VECTOR_DIM> pt = s + (coef * adaptedDir);
+        Point<T, EQUATION_VECTOR_DIM, P> pt = s + (coef * adaptedDir);
 
-        return Point<T, PLANE_DIMENSION> {pt[0], pt[1], pt[2]};
+        return Point<T, PLANE_DIMENSION, P> {pt[0], pt[1], pt[2]};
     }
 
     /** \brief
@@ -92,9 +115,9 @@ public:
      * \return double
      */
     double intersectCoef(const LineSegment<T, PLANE_DIMENSION> &ls) const {
-        Point<T, EQUATION_VECTOR_DIM> s {ls.get_begin()[0], ls.get_begin()[1], ls.get_begin()[2], 1};
-        Direction<T, PLANE_DIMENSION> vDim3 {ls.get_begin().length_to(ls.get_end())};
-        Direction<T, EQUATION_VECTOR_DIM> v = {vDim3[0], vDim3[1], vDim3[2], T()};
+        Point<T, EQUATION_VECTOR_DIM, P> s {ls.get_begin()[0], ls.get_begin()[1], ls.get_begin()[2], 1};
+        Direction<T, PLANE_DIMENSION, P> vDim3 {ls.get_begin().length_to(ls.get_end())};
+        Direction<T, EQUATION_VECTOR_DIM, P> v = {vDim3[0], vDim3[1], vDim3[2], T()};
 
         if ((equation * v) == 0)
             return (equation * s == 0 ? 1.d : -1);
@@ -106,7 +129,7 @@ public:
      * @brief Accesseur pour la direction du plan
      * @return La direction du plan
      */
-    const Direction<T, PLANE_DIMENSION>& GetN() const {
+    const Direction<T, PLANE_DIMENSION, P>& GetN() const {
         return n;
     }
     
@@ -114,18 +137,37 @@ public:
      * @brief Accesseur pour le point du plan
      * @return Le point du plan
      */
-    const Point<T, PLANE_DIMENSION>& GetP() const {
+    const Point<T, PLANE_DIMENSION, P>& GetP() const {
         return p;
     }
 
-    template <class U>
-    friend std::ostream& operator<<(std::ostream& out, Plane<U> &p);
+    /**
+     * @brief Accesseur pour l'equation du plan
+     * @return Les coefficients (a, b, c, d) de a*x + b*y + c*z + d = 0
+     */
+    const math::Vector<T, EQUATION_VECTOR_DIM, P>& GetEquation() const {
+        return equation;
+    }
+
+    /**
+     * @brief Diffuse l'equation du plan sur W voies, pour tester W objets a la fois
+     * @return Le plan sous forme de paquet
+     */
+    template <unsigned int W>
+    math::PlanePacket<T, W> packet() const {
+        return math::PlanePacket<T, W>(equation);
+    }
+
+    template <class U, class Q>
+    friend std::ostream& operator<<(std::ostream& out, Plane<U, Q> &p);
 };
 
-template<class T>
-std::ostream& operator<<(std::ostream& out, const Plane<T> &p)
+template<class T, class P>
+std::ostream& operator<<(std::ostream& out, const Plane<T, P> &p)
 {
     out << "Point : " << p.p << " direction : " << p.n << " Equation : " << p.equation;
     return out;
 }
+
+static_assert(std::is_trivially_copyable<Plane<float>>::value, "Plane must be trivially copyable");
 }
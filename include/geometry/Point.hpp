@@ -4,6 +4,7 @@
 #include "geometry/Direction.hpp"
 
 #include <iostream>
+#include <type_traits>
 
 /**
  * @namespace geometry
@@ -12,17 +13,17 @@
  */
 namespace geometry
 {
-    template <class T, unsigned int N>
-    class Point : public math::Vector<T, N>
+    template <class T, unsigned int N, class P = math::Exact>
+    class Point : public math::Vector<T, N, P>
     {
     public:
 
-        using math::Vector<T, N>::Vector; // Usage des constructeurs de la base class
+        using math::Vector<T, N, P>::Vector; // Usage des constructeurs de la base class
 
-        Point() : Point::Vector()
+        constexpr Point() : Point::Vector()
         {}
 
-        Point(const math::Vector<T, N> &v) : Point::Vector(v)
+        constexpr Point(const math::Vector<T, N, P> &v) : Point::Vector(v)
         {}
 
         /** \brief Calcule la distance entre ce point et un autre
@@ -30,9 +31,9 @@ namespace geometry
          * \param p Le point dont on veut calculer la distance par rapport à celui-ci
          * \return La direction de ce point vers celui passé en paramètre
          */
-        Direction<T, N> length_to(const Point<T, N> &p) const
+        Direction<T, N, P> length_to(const Point<T, N, P> &p) const
         {
-            Direction<T, N> dir;
+            Direction<T, N, P> dir;
 
             for (int i = 0; i < N; ++i)
                 dir[i] = p[i] - this->at(i);
@@ -40,12 +41,12 @@ namespace geometry
             return dir;
         }
 
-        template <class U, unsigned int O>
-        friend std::ostream& operator<<(std::ostream &out, Point<U, O> &p);
+        template <class U, unsigned int O, class Q>
+        friend std::ostream& operator<<(std::ostream &out, Point<U, O, Q> &p);
     };
 
-    template <class T, unsigned int N>
-    std::ostream& operator<<(std::ostream &out, Point<T, N> &p)
+    template <class T, unsigned int N, class P>
+    std::ostream& operator<<(std::ostream &out, Point<T, N, P> &p)
     {
         out << "(" << p[0];
 
@@ -55,4 +56,6 @@ namespace geometry
 
         return out;
     }
+
+    static_assert(std::is_trivially_copyable<Point<float, 3>>::value, "Point must be trivially copyable");
 }
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "math/AlignedAllocator.hpp"
+#include "geometry/Point.hpp"
+#include "geometry/VertexStream.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define QUANTIZED_VERTEX_MAX 65535
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class QuantizedVertexStream
+     *
+     * Ensemble de points dont les coordonnees sont quantifiees sur 16 bits, normalisees
+     * par rapport a la boite englobante de l'ensemble. Un sommet se decode par
+     * offset + q * scale, coordonnee par coordonnee ; l'erreur de quantification est
+     * bornee par scale / 2 sur chaque axe. Comme VertexStream, les tableaux sont alignes
+     * sur une ligne de cache et completes par des zeros.
+     */
+    template<class T>
+    class QuantizedVertexStream
+    {
+    public:
+        typedef std::vector<std::uint16_t, math::AlignedAllocator<std::uint16_t, VERTEX_STREAM_ALIGNMENT>> coordinates;
+
+    private:
+        coordinates xs; /**< Abscisses quantifiees */
+        coordinates ys; /**< Ordonnees quantifiees */
+        coordinates zs; /**< Cotes quantifiees */
+        std::size_t count; /**< Nombre de sommets */
+        std::array<T, 3> offsets; /**< Coin minimal de la boite englobante */
+        std::array<T, 3> scales; /**< Pas de quantification sur chaque axe */
+
+        /** \brief Quantifie une coordonnee
+         *
+         * \param v La coordonnee
+         * \param axis L'axe de la coordonnee
+         * \return La coordonnee quantifiee
+         */
+        std::uint16_t encode(const T v, const unsigned int axis) const
+        {
+            if (scales[axis] == T())
+                return 0;
+
+            const long q = std::lround((v - offsets[axis]) / scales[axis]);
+
+            return std::uint16_t(q < 0 ? 0 : (q > QUANTIZED_VERTEX_MAX ? QUANTIZED_VERTEX_MAX : q));
+        }
+
+    public:
+        QuantizedVertexStream() : count(0), offsets(), scales()
+        {
+        }
+
+        /** \brief Quantifie un flux de sommets
+         *
+         * \param vertices Les sommets a quantifier
+         */
+        explicit QuantizedVertexStream(const VertexStream<T> &vertices) : count(vertices.size()), offsets(), scales()
+        {
+            const T *in[3] = {vertices.x(), vertices.y(), vertices.z()};
+            coordinates *out[3] = {&xs, &ys, &zs};
+
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                T min = count > 0 ? in[axis][0] : T(), max = min;
+
+                for (std::size_t i = 1; i < count; ++i)
+                {
+                    if (in[axis][i] < min)
+                        min = in[axis][i];
+                    if (in[axis][i] > max)
+                        max = in[axis][i];
+                }
+
+                offsets[axis] = min;
+                scales[axis] = (max - min) / T(QUANTIZED_VERTEX_MAX);
+
+                out[axis]->resize(vertices.padded_size(), 0);
+                for (std::size_t i = 0; i < count; ++i)
+                    (*out[axis])[i] = encode(in[axis][i], axis);
+            }
+        }
+
+        /** \brief Nombre de sommets
+         */
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /** \brief Indique si l'ensemble est vide
+         */
+        bool empty() const
+        {
+            return count == 0;
+        }
+
+        /** \brief Nombre d'elements alloues par coordonnee
+         */
+        std::size_t padded_size() const
+        {
+            return xs.size();
+        }
+
+        /** \brief Coin minimal de la boite englobante, ajoute lors du decodage
+         */
+        const std::array<T, 3> &offset() const
+        {
+            return offsets;
+        }
+
+        /** \brief Pas de quantification de chaque axe, multiplie lors du decodage
+         */
+        const std::array<T, 3> &scale() const
+        {
+            return scales;
+        }
+
+        /** \brief Decode un sommet
+         *
+         * \param i L'index du sommet
+         * \return Le sommet decode
+         */
+        Point<T, 3> operator[](const std::size_t i) const
+        {
+            return Point<T, 3>{offsets[0] + T(xs[i]) * scales[0], offsets[1] + T(ys[i]) * scales[1], offsets[2] + T(zs[i]) * scales[2]};
+        }
+
+        /** \brief Accede aux coordonnees quantifiees, alignees sur VERTEX_STREAM_ALIGNMENT octets
+         */
+        const std::uint16_t *x() const { return xs.data(); }
+        const std::uint16_t *y() const { return ys.data(); }
+        const std::uint16_t *z() const { return zs.data(); }
+
+        /** \brief Decode l'ensemble des sommets
+         *
+         * \return Les sommets decodes
+         */
+        VertexStream<T> decode() const
+        {
+            VertexStream<T> vertices(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                vertices.x()[i] = offsets[0] + T(xs[i]) * scales[0];
+                vertices.y()[i] = offsets[1] + T(ys[i]) * scales[1];
+                vertices.z()[i] = offsets[2] + T(zs[i]) * scales[2];
+            }
+
+            return vertices;
+        }
+    };
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "math/Matrix.hpp"
+#include "math/Simd.hpp"
 #include "math/Vector.hpp"
 #include "geometry/Direction.hpp"
 #include "geometry/Point.hpp"
 #include "geometry/Plane.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 
 #define PI 3.14159265358 /**< Valeur approché du nombre PI */
@@ -25,20 +28,46 @@ namespace geometry
     /**
      * @class Quaternion
      *
-     * Objet mathematiques permettant de traiter les rotations complexes
+     * Objet mathematiques permettant de traiter les rotations complexes, les calculs
+     * etant arrondis selon la politique de precision P
      */
-    template <class T>
+    template <class T, class P = math::Exact>
     class Quaternion
     {
     private:
-        math::Vector<T, QUATERNION_DIMENSION> members; /**< Les membres du quaternion  */
+        math::Vector<T, QUATERNION_DIMENSION, P> members; /**< Les membres du quaternion  */
+
+        /** \brief Rotation d'un vecteur : v + w t + u x t avec t = 2 u x v
+         */
+        math::Vector<T, 3, P> rotated(const math::Vector<T, 3, P> &v) const
+        {
+            const math::Vector<T, 3, P> u = im();
+            const math::Vector<T, 3, P> t = u.cross(v) * T(2);
+            const math::Vector<T, 3, P> r = v + t * members[0] + u.cross(t);
+
+            return r;
+        }
+
+        /** \brief Rotation de vecteurs rangés les uns à la suite des autres, par
+         * la matrice de rotation avec la convention du vecteur ligne
+         */
+        void rotate(const T *in, T *out, const std::size_t count, const std::size_t stride) const
+        {
+            if (count == 0)
+                return;
+
+            alignas(16) T mat[16];
+            math::simd::QuaternionKernel<T, false>::to_matrix(members.data(), mat, 1);
+
+            math::simd::TransformKernel<T>::points(mat, in, out, count, stride);
+        }
     public:
 
         /** \brief Construit un quaternion à partir de ses membres
          *
          * \param members Les membres du quaternion (reel, im1, im2, im3)
          */
-        Quaternion(const math::Vector<T, QUATERNION_DIMENSION> &members) : members(members)
+        Quaternion(const math::Vector<T, QUATERNION_DIMENSION, P> &members) : members(members)
         {
 
         }
@@ -49,11 +78,13 @@ namespace geometry
          * \param dir La direction vers laquelle doit s'effectuer la rotation
          *
          */
-        Quaternion(const float rotation, const Direction<T, 3> &dir)
+        Quaternion(const float rotation, const Direction<T, 3, P> &dir)
         {
-            float sinAngle = ROUND(std::sin(deg2rad(rotation / 2)));
+            double sinHalf, cosHalf;
+            math::DefaultMath::sincos(deg2rad(rotation / 2), sinHalf, cosHalf);
+            float sinAngle = P::round(sinHalf);
 
-            members[0] = ROUND(std::cos(deg2rad(rotation / 2)));
+            members[0] = P::round(cosHalf);
             members[1] = dir[0] * sinAngle;
             members[2] = dir[1] * sinAngle;
             members[3] = dir[2] * sinAngle;
@@ -66,7 +97,7 @@ namespace geometry
          */
         Quaternion conjugate() const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0], -members[1], -members[2], -members[3]});
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0], -members[1], -members[2], -members[3]});
         }
 
         /** \brief Calcule la norme du quaternion
@@ -82,9 +113,9 @@ namespace geometry
          *
          * \return La partie imaginaire du quaternion
          */
-        math::Vector<T, IMAGINARY_PART_DIMENSION> im() const
+        math::Vector<T, IMAGINARY_PART_DIMENSION, P> im() const
         {
-            math::Vector<T, IMAGINARY_PART_DIMENSION> imag{members[1], members[2], members[3]};
+            math::Vector<T, IMAGINARY_PART_DIMENSION, P> imag{members[1], members[2], members[3]};
 
             return imag;
         }
@@ -108,11 +139,126 @@ namespace geometry
             return members[0];
         }
 
-        math::Vector<T, QUATERNION_DIMENSION> getMembers() const
+        math::Vector<T, QUATERNION_DIMENSION, P> getMembers() const
         {
             return members;
         }
 
+        /** \brief Accède au stockage contigu des membres (reel, im1, im2, im3)
+         *
+         * \return Un pointeur sur le premier membre
+         */
+        const T *data() const
+        {
+            return members.data();
+        }
+
+        T *data()
+        {
+            return members.data();
+        }
+
+        /** \brief Produit scalaire de deux quaternions
+         *
+         * \param q Le second quaternion
+         * \return Le cosinus de la moitié de l'angle entre les deux rotations, s'ils sont unitaires
+         */
+        T dot(const Quaternion &q) const
+        {
+            return members[0] * q.members[0] + members[1] * q.members[1] + members[2] * q.members[2] + members[3] * q.members[3];
+        }
+
+        /** \brief Interpolation linéaire normalisée vers q, par le chemin le plus court
+         *
+         * Moins chère que slerp ; la vitesse angulaire n'est pas constante.
+         * \param q Le quaternion d'arrivée, unitaire comme le quaternion courant
+         * \param t Le paramètre d'interpolation, dans [0, 1]
+         * \return Le quaternion interpolé, unitaire
+         */
+        Quaternion nlerp(const Quaternion &q, const T t) const
+        {
+            const Quaternion target = dot(q) < 0 ? -q : q;
+
+            return (*this + (target - *this) * t).to_norm();
+        }
+
+        /** \brief Interpolation sphérique vers q, par le chemin le plus court
+         *
+         * Lorsque les deux rotations sont presque égales, sin(theta) est trop petit et
+         * l'interpolation linéaire normalisée est utilisée.
+         * \param q Le quaternion d'arrivée, unitaire comme le quaternion courant
+         * \param t Le paramètre d'interpolation, dans [0, 1]
+         * \return Le quaternion interpolé, unitaire
+         */
+        Quaternion slerp(const Quaternion &q, const T t) const
+        {
+            const T cosTheta = dot(q);
+            const Quaternion target = cosTheta < 0 ? -q : q;
+            const T c = std::fabs(cosTheta);
+
+            if (c > T(0.9995))
+                return nlerp(target, t);
+
+            const T theta = std::acos(c), sinTheta = std::sin(theta);
+
+            return (*this * T(std::sin((1 - t) * theta) / sinTheta) + target * T(std::sin(t * theta) / sinTheta)).to_norm();
+        }
+
+        /** \brief Interpole des tableaux de quaternions terme à terme par nlerp,
+         * quatre à la fois avec SSE
+         *
+         * \param a, b Les quaternions de départ et d'arrivée, unitaires
+         * \param t Les paramètres d'interpolation, un par quaternion
+         * \param result Les quaternions interpolés
+         * \param count Le nombre de quaternions
+         */
+        static void nlerp(const Quaternion *a, const Quaternion *b, const T *t, Quaternion *result, const std::size_t count)
+        {
+            static_assert(sizeof(Quaternion) == QUATERNION_DIMENSION * sizeof(T), "Quaternions must be packed");
+
+            if (count > 0)
+                math::simd::QuaternionKernel<T>::nlerp(a->members.data(), b->members.data(), t, 1, result->members.data(), count);
+        }
+
+        /** \brief Interpole des tableaux de quaternions terme à terme par slerp,
+         * quatre à la fois avec SSE
+         *
+         * Les coefficients sont approchés par un polynôme, sans fonction
+         * trigonométrique (écart à slerp inférieur à 1e-5 en simple précision).
+         * \param a, b Les quaternions de départ et d'arrivée, unitaires
+         * \param t Les paramètres d'interpolation, un par quaternion
+         * \param result Les quaternions interpolés
+         * \param count Le nombre de quaternions
+         */
+        static void slerp(const Quaternion *a, const Quaternion *b, const T *t, Quaternion *result, const std::size_t count)
+        {
+            static_assert(sizeof(Quaternion) == QUATERNION_DIMENSION * sizeof(T), "Quaternions must be packed");
+
+            if (count > 0)
+                math::simd::QuaternionKernel<T>::slerp(a->members.data(), b->members.data(), t, 1, result->members.data(), count);
+        }
+
+        /** \brief Interpole des tableaux de quaternions avec un même paramètre
+         *
+         * \param a, b Les quaternions de départ et d'arrivée, unitaires
+         * \param t Le paramètre d'interpolation, commun à tous les quaternions
+         * \param result Les quaternions interpolés
+         * \param count Le nombre de quaternions
+         * \param spherical true pour slerp, false pour nlerp
+         */
+        static void interpolate(const Quaternion *a, const Quaternion *b, const T t, Quaternion *result, const std::size_t count, const bool spherical = true)
+        {
+            static_assert(sizeof(Quaternion) == QUATERNION_DIMENSION * sizeof(T), "Quaternions must be packed");
+
+            if (count == 0)
+                return;
+
+            if (spherical)
+                math::simd::QuaternionKernel<T>::slerp(a->members.data(), b->members.data(), &t, 0, result->members.data(), count);
+            else
+                math::simd::QuaternionKernel<T>::nlerp(a->members.data(), b->members.data(), &t, 0, result->members.data(), count);
+        }
+
         /** \brief Retourne une copie normalisé du quaternion
          *
          * \return Une copie du quaternion normalisé
@@ -124,36 +270,58 @@ namespace geometry
         
         /** \brief Effectue une rotation sur un point 
          *
+         * Calcule q * (0, pt) * q', sous la forme pt + w t + u x t avec t = 2 u x pt
+         * (u la partie imaginaire) ; le quaternion doit etre unitaire.
          * \param pt le point à transformer
          * \return Le point transforme
          */
-        Point<T, 3> rotate(const Point<T, 3> &pt) const
+        Point<T, 3, P> rotate(const Point<T, 3, P> &pt) const
         {
-            Point<T, QUATERNION_DIMENSION> p(pt->at(0), pt->at(1), pt->at(2), 1);
-
-            Point<T, QUATERNION_DIMENSION> rotatedP(p * members);
-
-            return Point<T, 3>{rotatedP[0], rotatedP[1], rotatedP[2]};
+            return Point<T, 3, P>(rotated(pt));
         }
         
         /**
-         * @brief Effectue une rotation sur une direction
+         * @brief Effectue une rotation sur une direction, comme pour un point
          * @param d La direction a transformer
          * @return La direction transforme
          */
-        Direction<T, 3> rotate(const Direction<T, 3> &d) const
+        Direction<T, 3, P> rotate(const Direction<T, 3, P> &d) const
         {
-            return Direction<T, 3>{d[0] * members[0], d[1] * members[1], d[2] * members[2]};
+            return Direction<T, 3, P>(rotated(d));
         }
-        
+
+        /** \brief Effectue une rotation sur un ensemble de points
+         *
+         * La matrice de rotation est calculee une fois puis appliquee par le noyau
+         * SIMD de Transformation ; les resultats ne sont pas arrondis selon P.
+         * \param points Les points à transformer
+         * \param result Les points transformés, peut être égal à points
+         * \param count Le nombre de points
+         */
+        void rotate(const Point<T, 3, P> *points, Point<T, 3, P> *result, const std::size_t count) const
+        {
+            rotate(points->data(), result->data(), count, sizeof(Point<T, 3, P>) / sizeof(T));
+        }
+
+        /** \brief Effectue une rotation sur un ensemble de directions
+         *
+         * \param directions Les directions à transformer
+         * \param result Les directions transformées, peut être égal à directions
+         * \param count Le nombre de directions
+         */
+        void rotate(const Direction<T, 3, P> *directions, Direction<T, 3, P> *result, const std::size_t count) const
+        {
+            rotate(directions->data(), result->data(), count, sizeof(Direction<T, 3, P>) / sizeof(T));
+        }
+
         /**
          * @brief Effectue une rotation sur un plan
          * @param p Le plan a transformer
          * @return Le plan transforme
          */
-        Plane<T> rotate(const Plane<T> &p) const
+        Plane<T, P> rotate(const Plane<T, P> &p) const
         {
-            return Plane<T>(rotate(p.GetP()), rotate(p.GetN()));
+            return Plane<T, P>(rotate(p.GetP()), rotate(p.GetN()));
         }
 
         /** \brief Additione un scalaire au quaternion
@@ -163,7 +331,7 @@ namespace geometry
          */
         Quaternion operator+ (const T scalar) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] + scalar,
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] + scalar,
                                                                     members[1],
                                                                     members[2],
                                                                     members[3]});
@@ -176,7 +344,7 @@ namespace geometry
          */
         Quaternion operator+ (const Quaternion &q) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] + q.members[0],
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] + q.members[0],
                                                                     members[1] + q.members[1],
                                                                     members[2] + q.members[2],
                                                                     members[3] + q.members[3]});
@@ -189,7 +357,7 @@ namespace geometry
          */
         Quaternion operator- (const T scalar) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] - scalar,
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] - scalar,
                                                                     members[1],
                                                                     members[2],
                                                                     members[3]});
@@ -202,7 +370,7 @@ namespace geometry
          */
         Quaternion operator- (const Quaternion &q) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] - q.members[0],
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] - q.members[0],
                                                                     members[1] - q.members[1],
                                                                     members[2] - q.members[2],
                                                                     members[3] - q.members[3]});
@@ -227,7 +395,7 @@ namespace geometry
          */
         Quaternion operator- () const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{-members[0], -members[1], -members[2], -members[3]});
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{-members[0], -members[1], -members[2], -members[3]});
         }
 
         /** \brief Multiplication d'un quaternion avec un scalaire
@@ -237,7 +405,7 @@ namespace geometry
          */
         Quaternion operator* (const T scalar) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] * scalar,
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] * scalar,
                                                                     members[1] * scalar,
                                                                     members[2] * scalar,
                                                                     members[3] * scalar});
@@ -250,10 +418,13 @@ namespace geometry
          */
         Quaternion operator* (const Quaternion& q) const
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] * q.members[0] - members[1] * q.members[1] - members[2] * q.members[2] - members[3] * q.members[3],
-                                                                    members[0] * q.members[1] + members[1] * q.members[0] + members[2] * q.members[3] + members[3] * q.members[2],
-                                                                    members[0] * q.members[2] - members[1] * q.members[3] + members[2] * q.members[0] + members[3] * q.members[1],
-                                                                    members[0] * q.members[3] + members[1] * q.members[2] - members[2] * q.members[1] + members[3] * q.members[0]});
+            const T aw = members[0], ax = members[1], ay = members[2], az = members[3];
+            const T bw = q.members[0], bx = q.members[1], by = q.members[2], bz = q.members[3];
+
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>(aw * bw - ax * bx - ay * by - az * bz,
+                                                                       aw * bx + ax * bw + ay * bz - az * by,
+                                                                       aw * by - ax * bz + ay * bw + az * bx,
+                                                                       aw * bz + ax * by - ay * bx + az * bw));
         }
 
 
@@ -264,7 +435,7 @@ namespace geometry
          */
         Quaternion operator/ (const T scalar) const 
         {
-            return Quaternion(math::Vector<T, QUATERNION_DIMENSION>{members[0] / scalar,
+            return Quaternion(math::Vector<T, QUATERNION_DIMENSION, P>{members[0] / scalar,
                                                                     members[1] / scalar,
                                                                     members[2] / scalar,
                                                                     members[3] / scalar});
@@ -346,45 +517,72 @@ namespace geometry
          */
         Quaternion& operator*= (const Quaternion& q)
         {
-            math::Vector<T, QUATERNION_DIMENSION> newMembers{members[0] * q.members[0] - members[1] * q.members[1] - members[2] * q.members[2] - members[3] * q.members[3],
-                                                             members[0] * q.members[1] + members[1] * q.members[0] + members[2] * q.members[3] + members[3] * q.members[2],
-                                                             members[0] * q.members[2] - members[1] * q.members[3] + members[2] * q.members[0] + members[3] * q.members[1],
-                                                             members[0] * q.members[3] + members[1] * q.members[2] - members[2] * q.members[1] + members[3] * q.members[0]};
+            return *this = *this * q;
+        }
 
-            members = newMembers;
-            return *this;
+        /** \brief Multiplie deux tableaux de quaternions terme à terme, quatre à la fois avec SSE
+         *
+         * Les résultats ne sont pas arrondis selon P.
+         * \param a, b Les quaternions à multiplier
+         * \param result Les produits a[i] * b[i], peut être égal à a ou b
+         * \param count Le nombre de quaternions
+         */
+        static void multiply(const Quaternion *a, const Quaternion *b, Quaternion *result, const std::size_t count)
+        {
+            static_assert(sizeof(Quaternion) == QUATERNION_DIMENSION * sizeof(T), "Quaternions must be packed");
+
+            if (count > 0)
+                math::simd::QuaternionKernel<T>::multiply(a->members.data(), b->members.data(), result->members.data(), count);
+        }
+
+        /** \brief Calcule les matrices de rotation d'un tableau de quaternions unitaires,
+         * quatre à la fois avec SSE
+         *
+         * Chaque matrice est celle de Transformation(const Quaternion &), avec la
+         * convention du vecteur ligne : (p, 1) * M tourne p comme rotate(p).
+         * \param q Les quaternions
+         * \param result Les matrices
+         * \param count Le nombre de quaternions
+         */
+        static void to_matrices(const Quaternion *q, math::Matrix<T, 4, 4, P> *result, const std::size_t count)
+        {
+            static_assert(sizeof(Quaternion) == QUATERNION_DIMENSION * sizeof(T), "Quaternions must be packed");
+            static_assert(sizeof(math::Matrix<T, 4, 4, P>) == 16 * sizeof(T), "Matrices must be packed");
+
+            if (count > 0)
+                math::simd::QuaternionKernel<T>::to_matrix(q->members.data(), result->data(), count);
         }
 
-        template <class U>
-        friend Quaternion<U> operator+(const U scalar, const Quaternion<U> &q);
+        template <class U, class Q>
+        friend Quaternion<U, Q> operator+(const U scalar, const Quaternion<U, Q> &q);
 
-        template <class U>
-        friend Quaternion<U> operator-(const U scalar, const Quaternion<U> &q);
+        template <class U, class Q>
+        friend Quaternion<U, Q> operator-(const U scalar, const Quaternion<U, Q> &q);
 
-        template <class U>
-        friend std::ostream& operator<<(std::ostream &out, const Quaternion<U> &q);
+        template <class U, class Q>
+        friend std::ostream& operator<<(std::ostream &out, const Quaternion<U, Q> &q);
     };
 
-    template <class T>
-    Quaternion<T> operator+(const T scalar, const Quaternion<T> &q)
+    template <class T, class P>
+    Quaternion<T, P> operator+(const T scalar, const Quaternion<T, P> &q)
     {
-        return Quaternion<T>(math::Vector<T, QUATERNION_DIMENSION>{q.members[0] + scalar,
+        return Quaternion<T, P>(math::Vector<T, QUATERNION_DIMENSION, P>{q.members[0] + scalar,
                                                                 q.members[1],
                                                                 q.members[2],
                                                                 q.members[3]});
     }
 
-    template<class T>
-    Quaternion<T> operator-(const T scalar, const Quaternion<T> &q)
+    template<class T, class P>
+    Quaternion<T, P> operator-(const T scalar, const Quaternion<T, P> &q)
     {
-        return Quaternion<T>(math::Vector<T, QUATERNION_DIMENSION>{q.members[0] - scalar,
+        return Quaternion<T, P>(math::Vector<T, QUATERNION_DIMENSION, P>{q.members[0] - scalar,
                                                                 q.members[1],
                                                                 q.members[2],
                                                                 q.members[3]});
     }
 
-    template<class T>
-    std::ostream& operator<< (std::ostream &out, const Quaternion<T> &q)
+    template<class T, class P>
+    std::ostream& operator<< (std::ostream &out, const Quaternion<T, P> &q)
     {
         out << "Quaternion(" << q.members[0] << ", " << q.members[1] << ", " << q.members[2] << ", " << q.members[3] << ")";
         return out;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "geometry/Quaternion.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /**
+     * @class RotationTracks
+     * @brief Ensemble de pistes d'animation de rotations partageant les memes instants clefs
+     *
+     * Les clefs d'un meme instant sont contigues : echantillonner toutes les pistes
+     * revient a interpoler deux tableaux de quaternions, ce que font les noyaux SIMD
+     * de Quaternion::interpolate.
+     */
+    template <class T, class P = math::Exact>
+    class RotationTracks
+    {
+    private:
+        std::size_t tracks; /**< Nombre de pistes */
+        std::vector<T> times; /**< Instants clefs, strictement croissants */
+        std::vector<Quaternion<T, P>> keys; /**< Clefs, rangees instant par instant */
+
+        void check(const std::size_t k, const std::size_t track) const
+        {
+            if (k >= times.size() || track >= tracks)
+                throw std::out_of_range("No such key");
+        }
+
+    public:
+        /**
+         * @brief Cree des pistes dont toutes les clefs sont l'identite
+         * @param tracks Le nombre de pistes
+         * @param times Les instants clefs, strictement croissants
+         */
+        RotationTracks(const std::size_t tracks, const std::vector<T> &times) :
+            tracks(tracks), times(times),
+            keys(tracks * times.size(), Quaternion<T, P>(math::Vector<T, QUATERNION_DIMENSION, P>(1, 0, 0, 0)))
+        {
+            if (times.empty())
+                throw std::invalid_argument("A track needs at least one key");
+
+            for (std::size_t k = 1; k < times.size(); ++k)
+                if (!(times[k - 1] < times[k]))
+                    throw std::invalid_argument("Key times must be strictly increasing");
+        }
+
+        /**
+         * @brief Nombre de pistes
+         */
+        std::size_t size() const
+        {
+            return tracks;
+        }
+
+        /**
+         * @brief Instants clefs
+         */
+        const std::vector<T> &key_times() const
+        {
+            return times;
+        }
+
+        /**
+         * @brief Clef d'une piste a un instant clef
+         * @param k L'index de l'instant clef
+         * @param track L'index de la piste
+         * @return La rotation, unitaire
+         */
+        Quaternion<T, P> &key(const std::size_t k, const std::size_t track)
+        {
+            check(k, track);
+            return keys[k * tracks + track];
+        }
+
+        const Quaternion<T, P> &key(const std::size_t k, const std::size_t track) const
+        {
+            check(k, track);
+            return keys[k * tracks + track];
+        }
+
+        /**
+         * @brief Echantillonne toutes les pistes
+         *
+         * Avant le premier instant clef et apres le dernier, les clefs extremes sont recopiees.
+         * @param time L'instant a echantillonner
+         * @param result Une rotation par piste
+         * @param spherical true pour slerp, false pour nlerp
+         */
+        void sample(const T time, Quaternion<T, P> *result, const bool spherical = true) const
+        {
+            const std::size_t next = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+
+            if (next == 0 || next == times.size())
+            {
+                std::copy(keys.begin() + (next == 0 ? 0 : (next - 1) * tracks), keys.begin() + (next == 0 ? tracks : next * tracks), result);
+                return;
+            }
+
+            const T t = (time - times[next - 1]) / (times[next] - times[next - 1]);
+            Quaternion<T, P>::interpolate(keys.data() + (next - 1) * tracks, keys.data() + next * tracks, t, result, tracks, spherical);
+        }
+
+        /**
+         * @brief Echantillonne toutes les pistes
+         * @param time L'instant a echantillonner
+         * @param result Une rotation par piste, redimensionne si necessaire
+         * @param spherical true pour slerp, false pour nlerp
+         */
+        void sample(const T time, std::vector<Quaternion<T, P>> &result, const bool spherical = true) const
+        {
+            result.resize(tracks, keys.front());
+            sample(time, result.data(), spherical);
+        }
+    };
+}
@@ -5,6 +5,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
 
 #define SPHERE_DIMENSION 3
 
@@ -25,7 +26,7 @@ namespace geometry
         /** \brief Constructeur par défaut
          *
          */
-        Sphere() : center(), radius(0)
+        constexpr Sphere() : center(), radius(0)
         {
 
         }
@@ -36,24 +37,21 @@ namespace geometry
          * \param radius le rayon de la sphere
          * \return Sphere(Point &center, float radius):
          */
-        Sphere(const Point<T, SPHERE_DIMENSION> &center, const float radius) : center(center)
+        constexpr Sphere(const Point<T, SPHERE_DIMENSION> &center, const float radius) :
+            center(center), radius(radius < 0 ? throw std::invalid_argument("The radius must be postive") : radius)
         {
-            if (radius < 0)
-                throw std::invalid_argument("The radius must be postive");
-
-            this->radius = radius;
         }
 
-        /** \brief Verifie si la sphere est derriere un plan
+        /** \brief Verifie si la sphere est entierement derriere un plan
          *
+         * La distance signee du centre au plan est comparee au rayon, un seul
+         * produit scalaire suffisant pour un test exact.
          * \param p Le plan à verifier
          * \return true si la sphere est derriere le plan, false sinon
          */
         bool behind(const Plane<T> &p) const
         {
-            Point<T, SPHERE_DIMENSION> min({center[0] - radius, center[1] - radius, center[2] - radius});
-            Point<T, SPHERE_DIMENSION> max({center[0] + radius, center[1] + radius, center[2] + radius});
-            return p.isFrontOf(min) && p.isFrontOf(max);
+            return p.positionFrom(center) < -radius;
         }
 
         /** \brief Vérifie si un point est contenu dans la sphere
@@ -119,4 +117,6 @@ namespace geometry
         out << "Centre : " << s.getCenter() << " rayon : " << s.getRadius();
         return out;
     }
+
+    static_assert(std::is_trivially_copyable<Sphere<float>>::value, "Sphere must be trivially copyable");
 }
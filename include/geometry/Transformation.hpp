@@ -1,10 +1,17 @@
 #pragma once
 
 #include "math/Matrix.hpp"
+#include "math/Packet.hpp"
+#include "math/Dispatch.hpp"
 #include "geometry/Quaternion.hpp"
 #include "geometry/Direction.hpp"
 #include "geometry/Point.hpp"
 #include "geometry/Sphere.hpp"
+#include "geometry/VertexStream.hpp"
+#include "geometry/QuantizedVertexStream.hpp"
+
+#include <cstddef>
+#include <vector>
 
 #define TRANSFORMATION_DIMENSION 4
 
@@ -17,37 +24,54 @@ namespace geometry
 {
     /** @class Transformation
      *
-     * Classe permettant d'effectuer des transformations
+     * Classe permettant d'effectuer des transformations, les calculs etant arrondis
+     * selon la politique de precision P
      */
-    template<class T>
+    template<class T, class P = math::Exact>
     class Transformation
     {
     private:
-        math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION> transformMat; /**< Matrice de transformation */
+        math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION, P> transformMat; /**< Matrice de transformation */
         Transformation() : transformMat()/**< Constructeur par défaut */
         {
 
         }
+
+        /** \brief Transforme des points rangés coordonnée par coordonnée ; en simple précision,
+         * le noyau est choisi à l'exécution selon le processeur (math::dispatch)
+         */
+        static void soa(const float *mat, const float *x, const float *y, const float *z, float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            math::dispatch::kernels().transform_points(mat, x, y, z, outX, outY, outZ, count);
+        }
+
+        template<class U>
+        static void soa(const U *mat, const U *x, const U *y, const U *z, U *outX, U *outY, U *outZ, const std::size_t count)
+        {
+            math::simd::TransformKernel<U>::soa(mat, x, y, z, outX, outY, outZ, count);
+        }
     public:
         /** \brief Construit une transformation à partir d'un quaternion
          *
+         * Avec la convention du vecteur ligne, la matrice est la transposee de la
+         * matrice de rotation : transform(p) donne le meme resultat que q.rotate(p).
          * \param q Le quaternion avec lequel construire la matrice de rotation
          */
-        Transformation(const Quaternion<T> &q) : transformMat()
+        Transformation(const Quaternion<T, P> &q) : transformMat()
         {
             T reel = q.re();
-            math::Vector<T, IMAGINARY_PART_DIMENSION> img = q.im();
+            math::Vector<T, IMAGINARY_PART_DIMENSION, P> img = q.im();
 
             transformMat[0][0] = 1 - (2 * img[1] * img[1]) - (2 * img[2] * img[2]);
-            transformMat[0][1] = (2 * img[0] * img[1]) - (2 * reel * img[2]);
-            transformMat[0][2] = (2 * img[0] * img[2]) + (2 * reel * img[1]);
+            transformMat[0][1] = (2 * img[0] * img[1]) + (2 * reel * img[2]);
+            transformMat[0][2] = (2 * img[0] * img[2]) - (2 * reel * img[1]);
 
-            transformMat[1][0] = (2 * img[0] * img[1]) + (2 * reel * img[2]);
+            transformMat[1][0] = (2 * img[0] * img[1]) - (2 * reel * img[2]);
             transformMat[1][1] = 1 - (2 * img[0] * img[0]) - (2 * img[2] * img[2]);
-            transformMat[1][2] = (2 * img[1] * img[2]) - (2 * reel * img[0]);
+            transformMat[1][2] = (2 * img[1] * img[2]) + (2 * reel * img[0]);
 
-            transformMat[2][0] = (2 * img[0] * img[2]) - (2 * reel * img[1]);
-            transformMat[2][1] = (2 * img[1] * img[2]) + (2 * reel * img[0]);
+            transformMat[2][0] = (2 * img[0] * img[2]) + (2 * reel * img[1]);
+            transformMat[2][1] = (2 * img[1] * img[2]) - (2 * reel * img[0]);
             transformMat[2][2] = 1 - (2 * img[0] * img[0]) - (2 * img[1] * img[1]);
 
             transformMat[3][3] = 1;
@@ -58,10 +82,12 @@ namespace geometry
          * \param d L'axe de rotation
          * \param angle L'angle de rotation
          */
-        Transformation(const T angle, const Direction<real, 3> &d)
+        Transformation(const T angle, const Direction<real, 3, P> &d)
         {
-            double cosAngle = ROUND(cos(deg2rad(angle)));
-            double sinAngle = ROUND(sin(deg2rad(angle)));
+            double sinAngle, cosAngle;
+            math::DefaultMath::sincos(deg2rad(angle), sinAngle, cosAngle);
+            sinAngle = P::round(sinAngle);
+            cosAngle = P::round(cosAngle);
 
             transformMat[0][0] = cosAngle + (1 - cosAngle) * (d[0] * d[0]);
             transformMat[0][1] = (1 - cosAngle) * d[0] * d[1] + (sinAngle * d[1]);
@@ -82,34 +108,67 @@ namespace geometry
          * @brief Constructeur avec une matrice
          * @param transformMat La matrice a utiliser pour la transformation
          */
-        Transformation(const math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION> &transformMat) : transformMat(transformMat)
+        Transformation(const math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION, P> &transformMat) : transformMat(transformMat)
         {
-            
+
+        }
+
+        /** \brief Accede a la matrice de transformation
+         *
+         * \return La matrice 4x4, avec la convention du vecteur ligne
+         */
+        const math::Matrix<T, TRANSFORMATION_DIMENSION, TRANSFORMATION_DIMENSION, P> &getMatrix() const
+        {
+            return transformMat;
         }
 
         /** \brief Concatene deux transformations
          *
-         * \param t La transformation a ajouté
+         * Avec la convention du vecteur ligne, (p, 1) * M1 * M2 applique M1 puis M2.
+         * \param t La transformation a appliquer apres la transformation courante
          * \return Le résultat de la concaténation de transformation
          */
         Transformation concat(const Transformation &t) const
         {
-            Transformation result;
-            result.transformMat[0][0] = transformMat[0][0] + t.transformMat[0][0];
-            result.transformMat[0][1] = transformMat[0][1] + t.transformMat[1][1];
-            result.transformMat[0][2] = transformMat[0][2] + t.transformMat[2][2];
+            return Transformation(transformMat * t.transformMat);
+        }
+
+        /** \brief Calcule la transformation inverse
+         *
+         * \return La transformation inverse, calculee par la methode des cofacteurs
+         */
+        Transformation inverse() const
+        {
+            return Transformation(transformMat.cofactor_inverse());
+        }
 
-            result.transformMat[1][0] = transformMat[1][0] + t.transformMat[0][0];
-            result.transformMat[1][1] = transformMat[1][1] + t.transformMat[1][1];
-            result.transformMat[1][2] = transformMat[1][2] + t.transformMat[2][2];
+        /** \brief Calcule l'inverse d'une transformation affine (rotation, mise a l'echelle et translation)
+         *
+         * Matrix::inverse_affine attend la translation dans la derniere colonne ; avec
+         * la convention du vecteur ligne elle est dans la derniere ligne, d'ou les transposees.
+         * \return La transformation inverse
+         */
+        Transformation inverseAffine() const
+        {
+            return Transformation(transformMat.transpose().inverse_affine().transpose());
+        }
 
-            result.transformMat[2][0] = transformMat[2][0] + t.transformMat[0][0];
-            result.transformMat[2][1] = transformMat[2][1] + t.transformMat[1][1];
-            result.transformMat[2][2] = transformMat[2][2] + t.transformMat[2][2];
+        /** \brief Calcule l'inverse d'une transformation rigide (rotation et translation)
+         *
+         * \return La transformation inverse
+         */
+        Transformation inverseRigid() const
+        {
+            return Transformation(transformMat.transpose().inverse_rigid().transpose());
+        }
 
-            result.transformMat[3][0] = transformMat[3][0] + t.transformMat[0][0];
-            result.transformMat[3][1] = transformMat[3][1] + t.transformMat[1][1];
-            result.transformMat[3][2] = transformMat[3][2] + t.transformMat[2][2];
+        /** \brief Calcule la transformation a appliquer aux normales
+         *
+         * \return La transposee de l'inverse de la partie lineaire de la transformation
+         */
+        Transformation inverseTranspose() const
+        {
+            return Transformation(transformMat.inverse_transpose());
         }
 
         /** \brief Transforme un point
@@ -117,13 +176,97 @@ namespace geometry
          * \param p Le point à transformer
          * \return Le point résultant de la transformation
          */
-        Point<T, 3> transform(const Point<T, 3> &p) const
+        Point<T, 3, P> transform(const Point<T, 3, P> &p) const
         {
-            const T last(1);
-            math::Vector<T, 4> v{p[0], p[1], p[2], last};
+            Point<T, 3, P> res;
 
-            v = v * transformMat;
-            return Point<T, 3>{v[0], v[1], v[2]};
+            transform(&p, &res, 1);
+            return res;
+        }
+
+        /** \brief Transforme un ensemble de points, la matrice n'etant chargee qu'une seule fois
+         *
+         * \param points Les points à transformer
+         * \param result Les points transformés, peut être égal à points
+         * \param count Le nombre de points
+         */
+        void transform(const Point<T, 3, P> *points, Point<T, 3, P> *result, const std::size_t count) const
+        {
+            if (count == 0)
+                return;
+
+            math::simd::TransformKernel<T>::points(transformMat.data(), points->data(), result->data(), count,
+                                                   sizeof(Point<T, 3, P>) / sizeof(T));
+        }
+
+        /** \brief Transforme un tableau de points
+         *
+         * \param points Les points à transformer
+         * \param result Les points transformés, redimensionné si nécessaire
+         */
+        void transform(const std::vector<Point<T, 3, P>> &points, std::vector<Point<T, 3, P>> &result) const
+        {
+            result.resize(points.size());
+            transform(points.data(), result.data(), points.size());
+        }
+
+        /** \brief Transforme des points stockés coordonnée par coordonnée
+         *
+         * \param x, y, z Les coordonnées des points à transformer
+         * \param outX, outY, outZ Les coordonnées des points transformés, peuvent être égales aux entrées
+         * \param count Le nombre de points
+         */
+        void transform(const T *x, const T *y, const T *z, T *outX, T *outY, T *outZ, const std::size_t count) const
+        {
+            soa(transformMat.data(), x, y, z, outX, outY, outZ, count);
+        }
+
+        /** \brief Transforme W points rangés coordonnée par coordonnée
+         *
+         * \param p Les points à transformer
+         * \return Les points transformés
+         */
+        template<unsigned int W>
+        math::Vec3Packet<T, W> transform(const math::Vec3Packet<T, W> &p) const
+        {
+            return math::Mat44Packet<T, W>(transformMat).point(p);
+        }
+
+        /** \brief Transforme un flux de sommets
+         *
+         * \param vertices Les sommets à transformer
+         * \param result Les sommets transformés, redimensionné si nécessaire, peut être égal à vertices
+         */
+        void transform(const VertexStream<T> &vertices, VertexStream<T> &result) const
+        {
+            result.resize(vertices.size());
+            transform(vertices.x(), vertices.y(), vertices.z(), result.x(), result.y(), result.z(), vertices.size());
+        }
+
+        /** \brief Transforme des sommets quantifiés, le décodage étant intégré à la matrice
+         *
+         * Avec la convention du vecteur ligne, décoder puis transformer revient à multiplier
+         * la ligne i de la matrice par scale[i] et à ajouter offset * M à la translation.
+         * \param vertices Les sommets quantifiés
+         * \param result Les sommets transformés, redimensionné si nécessaire
+         */
+        void transform(const QuantizedVertexStream<T> &vertices, VertexStream<T> &result) const
+        {
+            alignas(16) T decodeMat[TRANSFORMATION_DIMENSION * TRANSFORMATION_DIMENSION];
+            const T *mat = transformMat.data();
+
+            for (unsigned int j = 0; j < TRANSFORMATION_DIMENSION; ++j)
+            {
+                decodeMat[j] = vertices.scale()[0] * mat[j];
+                decodeMat[4 + j] = vertices.scale()[1] * mat[4 + j];
+                decodeMat[8 + j] = vertices.scale()[2] * mat[8 + j];
+                decodeMat[12 + j] = vertices.offset()[0] * mat[j] + vertices.offset()[1] * mat[4 + j]
+                                    + vertices.offset()[2] * mat[8 + j] + mat[12 + j];
+            }
+
+            result.resize(vertices.size());
+            math::simd::TransformKernel<T>::quantized(decodeMat, vertices.x(), vertices.y(), vertices.z(),
+                                                      result.x(), result.y(), result.z(), vertices.size());
         }
 
         /** \brief Transforme une sphère
@@ -144,22 +287,22 @@ namespace geometry
          * \param d La direction à transformer
          * \return La direction résultant de la transformation
          */
-        Direction<T, 3> transform(Direction<T, 3> &d) const
+        Direction<T, 3, P> transform(Direction<T, 3, P> &d) const
         {
-            math::Vector<T, 4> v(d[0], d[1], d[2], T());
+            math::Vector<T, 4, P> v(d[0], d[1], d[2], T());
 
             v = v * transformMat;
 
-            return Direction<T, 3>(v[0], v[1], v[2]);
+            return Direction<T, 3, P>(v[0], v[1], v[2]);
         }
         
         /**
          * @brief Transforme un plan
          * @return Le plan transforme
          */
-        Plane<real> transform(const Plane<real> &p) const
+        Plane<real, P> transform(const Plane<real, P> &p) const
         {
-            return Plane<real>(transform(p.GetP()), transform(p.GetN()));
+            return Plane<real, P>(transform(p.GetP()), transform(p.GetN()));
         }
         
         /**
@@ -171,7 +314,7 @@ namespace geometry
         {
             for (int i = 0; i < TRANSFORMATION_DIMENSION; ++i)
                 for (int j = 0; j < TRANSFORMATION_DIMENSION; ++j)
-                    if (transformMat[i][j] != transformMat[i][j])
+                    if (transformMat[i][j] != transform.transformMat[i][j])
                         return false;
             return true;
         }
@@ -187,10 +330,13 @@ namespace geometry
         {
             Transformation t;
 
-            t.transformMat[0][3] = x;
-            t.transformMat[1][3] = y;
-            t.transformMat[2][3] = z;
+            t.transformMat[0][0] = 1;
+            t.transformMat[1][1] = 1;
+            t.transformMat[2][2] = 1;
 
+            t.transformMat[3][0] = x;
+            t.transformMat[3][1] = y;
+            t.transformMat[3][2] = z;
             t.transformMat[3][3] = 1;
 
             return t;
@@ -216,12 +362,12 @@ namespace geometry
             return t;
         }
 
-        template <class U>
-        friend std::ostream& operator<<(std::ostream& out, const Transformation<U>& t);
+        template <class U, class Q>
+        friend std::ostream& operator<<(std::ostream& out, const Transformation<U, Q>& t);
     };
 
-    template <class T>
-    std::ostream& operator<<(std::ostream& out, const Transformation<T>& t)
+    template <class T, class P>
+    std::ostream& operator<<(std::ostream& out, const Transformation<T, P>& t)
     {
         out << t.transformMat[0][0] << " " << t.transformMat[0][1] << " " << t.transformMat[0][2] << " | " << t.transformMat[0][3] << std::endl;
         out << t.transformMat[1][0] << " " << t.transformMat[1][1] << " " << t.transformMat[1][2] << " | " << t.transformMat[1][3] << std::endl;
@@ -3,6 +3,7 @@
 #include "geometry/Point.hpp"
 
 #include <iostream>
+#include <type_traits>
 
 #define TRIANGLE_DIMENSION 3
 
@@ -34,7 +35,7 @@ namespace geometry
          * @param p2 Le deuxieme point du triangle
          * @param p3 Le troisieme point du triangle
          */
-        Triangle(Point<T, TRIANGLE_DIMENSION> &p0, Point<T, TRIANGLE_DIMENSION> &p1, Point<T, TRIANGLE_DIMENSION> &p2) : p0(p0), p1(p1), p2(p2)
+        constexpr Triangle(const Point<T, TRIANGLE_DIMENSION> &p0, const Point<T, TRIANGLE_DIMENSION> &p1, const Point<T, TRIANGLE_DIMENSION> &p2) : p0(p0), p1(p1), p2(p2)
         {
         }
 
@@ -93,4 +94,6 @@ namespace geometry
         out << "P0 : " << t.p0 << " P1 : " << t.p1 << " P2 : " << t.p2;
         return out;
     }
+
+    static_assert(std::is_trivially_copyable<Triangle<float>>::value, "Triangle must be trivially copyable");
 }
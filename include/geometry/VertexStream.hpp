@@ -0,0 +1,225 @@
+#pragma once
+
+#include "math/AlignedAllocator.hpp"
+#include "geometry/Point.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#define VERTEX_STREAM_ALIGNMENT 64
+
+/**
+ * @namespace geometry
+ *
+ * Espace de nommage contenant les objets géométriques nécessaire pour la réalisation du moteur
+ */
+namespace geometry
+{
+    /** @class VertexStream
+     *
+     * Ensemble de points stocke coordonnee par coordonnee (structure de tableaux) :
+     * les tableaux x, y et z sont alignes sur une ligne de cache et completes par
+     * des zeros jusqu'a un multiple de padding() elements, de sorte que les noyaux
+     * SIMD puissent les parcourir par paquets entiers sans traiter de reste.
+     */
+    template<class T>
+    class VertexStream
+    {
+    public:
+        typedef std::vector<T, math::AlignedAllocator<T, VERTEX_STREAM_ALIGNMENT>> coordinates;
+
+        /** @class const_iterator
+         *
+         * Parcourt le flux en reconstruisant chaque sommet sous forme de Point
+         */
+        class const_iterator : public std::iterator<std::random_access_iterator_tag, Point<T, 3>, std::ptrdiff_t, void, Point<T, 3>>
+        {
+        private:
+            const VertexStream *stream; /**< Le flux parcouru */
+            std::size_t i; /**< L'index du sommet courant */
+        public:
+            const_iterator() : stream(nullptr), i(0) {}
+            const_iterator(const VertexStream *stream, const std::size_t i) : stream(stream), i(i) {}
+
+            Point<T, 3> operator*() const { return (*stream)[i]; }
+            Point<T, 3> operator[](const std::ptrdiff_t n) const { return (*stream)[i + n]; }
+
+            const_iterator &operator++() { ++i; return *this; }
+            const_iterator operator++(int) { const_iterator it(*this); ++i; return it; }
+            const_iterator &operator--() { --i; return *this; }
+            const_iterator operator--(int) { const_iterator it(*this); --i; return it; }
+            const_iterator &operator+=(const std::ptrdiff_t n) { i += n; return *this; }
+            const_iterator &operator-=(const std::ptrdiff_t n) { i -= n; return *this; }
+            const_iterator operator+(const std::ptrdiff_t n) const { return const_iterator(stream, i + n); }
+            const_iterator operator-(const std::ptrdiff_t n) const { return const_iterator(stream, i - n); }
+            std::ptrdiff_t operator-(const const_iterator &it) const { return std::ptrdiff_t(i) - std::ptrdiff_t(it.i); }
+
+            bool operator==(const const_iterator &it) const { return i == it.i; }
+            bool operator!=(const const_iterator &it) const { return i != it.i; }
+            bool operator<(const const_iterator &it) const { return i < it.i; }
+            bool operator>(const const_iterator &it) const { return i > it.i; }
+            bool operator<=(const const_iterator &it) const { return i <= it.i; }
+            bool operator>=(const const_iterator &it) const { return i >= it.i; }
+        };
+
+    private:
+        coordinates xs; /**< Abscisses, completees par des zeros */
+        coordinates ys; /**< Ordonnees, completees par des zeros */
+        coordinates zs; /**< Cotes, completees par des zeros */
+        std::size_t count; /**< Nombre de sommets */
+
+        /** \brief Redimensionne les tableaux pour contenir n sommets et leur remplissage
+         *
+         * \param n Le nombre de sommets
+         */
+        void reserveFor(const std::size_t n)
+        {
+            const std::size_t padded = (n + padding() - 1) / padding() * padding();
+
+            xs.resize(padded, T());
+            ys.resize(padded, T());
+            zs.resize(padded, T());
+        }
+
+    public:
+        /** \brief Nombre d'elements par ligne de cache, les tableaux en sont toujours un multiple
+         */
+        static constexpr std::size_t padding()
+        {
+            return VERTEX_STREAM_ALIGNMENT / sizeof(T) > 0 ? VERTEX_STREAM_ALIGNMENT / sizeof(T) : 1;
+        }
+
+        VertexStream() : count(0)
+        {
+        }
+
+        /** \brief Construit un flux de n sommets a l'origine
+         *
+         * \param n Le nombre de sommets
+         */
+        explicit VertexStream(const std::size_t n) : count(n)
+        {
+            reserveFor(n);
+        }
+
+        /** \brief Construit un flux a partir d'un tableau de points
+         *
+         * \param points Les points a recopier
+         */
+        template<class P>
+        VertexStream(const std::vector<Point<T, 3, P>> &points) : count(points.size())
+        {
+            reserveFor(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                xs[i] = points[i][0];
+                ys[i] = points[i][1];
+                zs[i] = points[i][2];
+            }
+        }
+
+        /** \brief Nombre de sommets du flux
+         */
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /** \brief Indique si le flux est vide
+         */
+        bool empty() const
+        {
+            return count == 0;
+        }
+
+        /** \brief Nombre d'elements alloues par coordonnee, multiple de padding()
+         */
+        std::size_t padded_size() const
+        {
+            return xs.size();
+        }
+
+        /** \brief Redimensionne le flux, les nouveaux sommets etant a l'origine
+         *
+         * \param n Le nouveau nombre de sommets
+         */
+        void resize(const std::size_t n)
+        {
+            for (std::size_t i = n; i < count; ++i)
+                xs[i] = ys[i] = zs[i] = T();
+
+            count = n;
+            reserveFor(n);
+        }
+
+        /** \brief Ajoute un sommet a la fin du flux
+         *
+         * \param p Le sommet a ajouter
+         */
+        template<class P>
+        void push_back(const Point<T, 3, P> &p)
+        {
+            reserveFor(count + 1);
+            set(count++, p);
+        }
+
+        /** \brief Obtient un sommet
+         *
+         * \param i L'index du sommet
+         * \return Le sommet reconstruit sous forme de Point
+         */
+        Point<T, 3> operator[](const std::size_t i) const
+        {
+            return Point<T, 3>{xs[i], ys[i], zs[i]};
+        }
+
+        /** \brief Modifie un sommet
+         *
+         * \param i L'index du sommet
+         * \param p La nouvelle valeur du sommet
+         */
+        template<class P>
+        void set(const std::size_t i, const Point<T, 3, P> &p)
+        {
+            xs[i] = p[0];
+            ys[i] = p[1];
+            zs[i] = p[2];
+        }
+
+        /** \brief Accede aux abscisses, alignees sur VERTEX_STREAM_ALIGNMENT octets
+         */
+        T *x() { return xs.data(); }
+        const T *x() const { return xs.data(); }
+
+        /** \brief Accede aux ordonnees, alignees sur VERTEX_STREAM_ALIGNMENT octets
+         */
+        T *y() { return ys.data(); }
+        const T *y() const { return ys.data(); }
+
+        /** \brief Accede aux cotes, alignees sur VERTEX_STREAM_ALIGNMENT octets
+         */
+        T *z() { return zs.data(); }
+        const T *z() const { return zs.data(); }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, count);
+        }
+
+        /** \brief Recopie le flux dans un tableau de points
+         *
+         * \return Les sommets du flux
+         */
+        std::vector<Point<T, 3>> points() const
+        {
+            return std::vector<Point<T, 3>>(begin(), end());
+        }
+    };
+}
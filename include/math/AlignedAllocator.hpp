@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace math
+{
+    /**
+     * @class AlignedAllocator
+     * @brief Allocateur pour les conteneurs standards garantissant un alignement
+     * de align octets (une ligne de cache par defaut)
+     *
+     * Le bloc est surdimensionne de align octets ; l'adresse renvoyee par malloc
+     * est conservee juste avant le debut du bloc aligne pour la liberation.
+     */
+    template<class T, std::size_t align = 64>
+    class AlignedAllocator
+    {
+        static_assert(align >= sizeof(void *) && (align & (align - 1)) == 0, "align must be a power of two");
+    public:
+        typedef T value_type;
+
+        template<class U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, align> other;
+        };
+
+        AlignedAllocator() {}
+
+        template<class U>
+        AlignedAllocator(const AlignedAllocator<U, align> &) {}
+
+        /**
+         * @brief Alloue un bloc aligne pour n elements
+         * @param n Le nombre d'elements
+         * @return L'adresse du bloc
+         */
+        T *allocate(const std::size_t n)
+        {
+            void *raw = std::malloc(n * sizeof(T) + align);
+
+            if (raw == nullptr)
+                throw std::bad_alloc();
+
+            std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + align) & ~(std::uintptr_t(align) - 1);
+            reinterpret_cast<void **>(aligned)[-1] = raw;
+
+            return reinterpret_cast<T *>(aligned);
+        }
+
+        /**
+         * @brief Libere un bloc obtenu par allocate
+         * @param p L'adresse du bloc
+         */
+        void deallocate(T *p, std::size_t)
+        {
+            if (p != nullptr)
+                std::free(reinterpret_cast<void **>(p)[-1]);
+        }
+    };
+
+    template<class T, class U, std::size_t align>
+    bool operator==(const AlignedAllocator<T, align> &, const AlignedAllocator<U, align> &)
+    {
+        return true;
+    }
+
+    template<class T, class U, std::size_t align>
+    bool operator!=(const AlignedAllocator<T, align> &, const AlignedAllocator<U, align> &)
+    {
+        return false;
+    }
+}
@@ -0,0 +1,671 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+#include "math/Simd.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(MATH_NO_SIMD)
+#include <immintrin.h>
+#define MATH_DISPATCH_X86 1 /**< Les variantes SSE2, AVX2 et AVX-512 sont compilees */
+#define MATH_TARGET(isa) __attribute__((target(isa))) /**< Compile une fonction pour un jeu d'instructions donne */
+#endif
+
+/**
+ * @namespace math::dispatch
+ *
+ * Choix a l'execution des noyaux de calcul des scenes. Chaque noyau existe en
+ * version scalaire portable et, sur x86 avec GCC ou Clang, en versions SSE2,
+ * AVX2 et AVX-512 compilees par fonction (attribut target) : le binaire n'a pas
+ * besoin d'etre construit avec -march=native. La meilleure version supportee
+ * par le processeur est choisie au premier appel de kernels(). La variable
+ * d'environnement MATH_KERNELS (scalar, sse2, avx2 ou avx512) ou select()
+ * imposent une autre version.
+ *
+ * Toutes les versions effectuent les memes operations dans le meme ordre, sans
+ * FMA ni approximation de l'inverse : leurs resultats sont identiques au bit pres.
+ * Les donnees sont rangees coordonnee par coordonnee, sans contrainte d'alignement.
+ */
+namespace math
+{
+namespace dispatch
+{
+    /**
+     * @brief Jeux d'instructions, du moins au plus rapide
+     */
+    enum class Isa
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    /**
+     * @brief Nom d'un jeu d'instructions, tel qu'accepte par MATH_KERNELS
+     */
+    inline const char *name(const Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::sse2:
+            return "sse2";
+        case Isa::avx2:
+            return "avx2";
+        case Isa::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+        }
+    }
+
+    /**
+     * @brief Ensemble des noyaux d'un meme jeu d'instructions
+     *
+     * - transform_points : out = (p, 1) * mat, mat etant une matrice 4x4 en lignes
+     *   (translation sur la derniere ligne) ;
+     * - spheres_outside : outside[i] = 1 si la sphere i est entierement derriere
+     *   l'un des plans, 0 sinon ; un plan est donne par son equation (a, b, c, d),
+     *   l'interieur etant a*x + b*y + c*z + d >= 0 ;
+     * - clip_segments : restreint chaque segment [b, e] a l'intersection des
+     *   demi-espaces interieurs, la partie visible etant b + t * (e - b) pour t
+     *   dans [t0, t1] ; le segment est invisible si t0 > t1 ;
+     * - project : projection perspective (-focal / z) * x, (-focal / z) * y.
+     */
+    struct KernelTable
+    {
+        typedef void (*TransformPoints)(const float *mat, const float *x, const float *y, const float *z,
+                                        float *outX, float *outY, float *outZ, std::size_t count);
+        typedef void (*SpheresOutside)(const float *planes, std::size_t planeCount,
+                                       const float *cx, const float *cy, const float *cz, const float *radius,
+                                       std::uint8_t *outside, std::size_t count);
+        typedef void (*ClipSegments)(const float *planes, std::size_t planeCount,
+                                     const float *bx, const float *by, const float *bz,
+                                     const float *ex, const float *ey, const float *ez,
+                                     float *t0, float *t1, std::size_t count);
+        typedef void (*Project)(float focal, const float *x, const float *y, const float *z,
+                                float *outX, float *outY, std::size_t count);
+
+        Isa isa; /**< Jeu d'instructions utilise par les noyaux */
+        TransformPoints transform_points;
+        SpheresOutside spheres_outside;
+        ClipSegments clip_segments;
+        Project project;
+    };
+
+    /**
+     * @brief Versions portables, reference des autres versions
+     */
+    namespace scalar
+    {
+        inline void transform_points(const float *mat, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float px = x[i], py = y[i], pz = z[i];
+
+                outX[i] = px * mat[0] + py * mat[4] + pz * mat[8] + mat[12];
+                outY[i] = px * mat[1] + py * mat[5] + pz * mat[9] + mat[13];
+                outZ[i] = px * mat[2] + py * mat[6] + pz * mat[10] + mat[14];
+            }
+        }
+
+        inline void spheres_outside(const float *planes, const std::size_t planeCount,
+                                    const float *cx, const float *cy, const float *cz, const float *radius,
+                                    std::uint8_t *outside, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float r = 0 - radius[i];
+                bool out = false;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    out |= eq[0] * cx[i] + eq[1] * cy[i] + eq[2] * cz[i] + eq[3] < r;
+                }
+
+                outside[i] = out;
+            }
+        }
+
+        inline void clip_segments(const float *planes, const std::size_t planeCount,
+                                  const float *bx, const float *by, const float *bz,
+                                  const float *ex, const float *ey, const float *ez,
+                                  float *t0, float *t1, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                float first = 0, last = 1;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const float d0 = eq[0] * bx[i] + eq[1] * by[i] + eq[2] * bz[i] + eq[3];
+                    const float d1 = eq[0] * ex[i] + eq[1] * ey[i] + eq[2] * ez[i] + eq[3];
+
+                    if (d0 < 0 && d1 < 0)
+                    {
+                        first = 1;
+                        last = 0;
+                    }
+                    else if (d0 < 0)
+                    {
+                        const float t = d0 / (d0 - d1);
+                        first = t > first ? t : first;
+                    }
+                    else if (d1 < 0)
+                    {
+                        const float t = d0 / (d0 - d1);
+                        last = t < last ? t : last;
+                    }
+                }
+
+                t0[i] = first;
+                t1[i] = last;
+            }
+        }
+
+        inline void project(const float focal, const float *x, const float *y, const float *z,
+                            float *outX, float *outY, const std::size_t count)
+        {
+            const float f = 0 - focal;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float s = f / z[i];
+
+                outX[i] = s * x[i];
+                outY[i] = s * y[i];
+            }
+        }
+
+        inline const KernelTable &table()
+        {
+            static const KernelTable t = {Isa::scalar, &transform_points, &spheres_outside, &clip_segments, &project};
+            return t;
+        }
+    }
+
+#ifdef MATH_DISPATCH_X86
+    // Les trois versions vectorielles ont la meme structure ; seules la largeur
+    // des registres et l'ecriture des masques changent. Les elements restants
+    // sont traites par la version scalaire, qui calcule la meme chose.
+
+    namespace sse2
+    {
+        MATH_TARGET("sse2")
+        inline void transform_points(const float *mat, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            __m128 m[12];
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 3; ++c)
+                    m[3 * r + c] = _mm_set1_ps(mat[4 * r + c]);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+
+                _mm_storeu_ps(outX + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m[0]), _mm_mul_ps(py, m[3])), _mm_mul_ps(pz, m[6])), m[9]));
+                _mm_storeu_ps(outY + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m[1]), _mm_mul_ps(py, m[4])), _mm_mul_ps(pz, m[7])), m[10]));
+                _mm_storeu_ps(outZ + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m[2]), _mm_mul_ps(py, m[5])), _mm_mul_ps(pz, m[8])), m[11]));
+            }
+
+            scalar::transform_points(mat, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+        }
+
+        MATH_TARGET("sse2")
+        inline void spheres_outside(const float *planes, const std::size_t planeCount,
+                                    const float *cx, const float *cy, const float *cz, const float *radius,
+                                    std::uint8_t *outside, const std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+                const __m128 r = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+                __m128 out = _mm_setzero_ps();
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(eq[0]), x), _mm_mul_ps(_mm_set1_ps(eq[1]), y)),
+                                                           _mm_mul_ps(_mm_set1_ps(eq[2]), z)), _mm_set1_ps(eq[3]));
+                    out = _mm_or_ps(out, _mm_cmplt_ps(d, r));
+                }
+
+                const int bits = _mm_movemask_ps(out);
+                for (int l = 0; l < 4; ++l)
+                    outside[i + l] = (bits >> l) & 1;
+            }
+
+            scalar::spheres_outside(planes, planeCount, cx + i, cy + i, cz + i, radius + i, outside + i, count - i);
+        }
+
+        MATH_TARGET("sse2")
+        inline void clip_segments(const float *planes, const std::size_t planeCount,
+                                  const float *bx, const float *by, const float *bz,
+                                  const float *ex, const float *ey, const float *ez,
+                                  float *t0, float *t1, const std::size_t count)
+        {
+            const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 x0 = _mm_loadu_ps(bx + i), y0 = _mm_loadu_ps(by + i), z0 = _mm_loadu_ps(bz + i);
+                const __m128 x1 = _mm_loadu_ps(ex + i), y1 = _mm_loadu_ps(ey + i), z1 = _mm_loadu_ps(ez + i);
+                __m128 first = zero, last = one;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m128 a = _mm_set1_ps(eq[0]), b = _mm_set1_ps(eq[1]), c = _mm_set1_ps(eq[2]), w = _mm_set1_ps(eq[3]);
+                    const __m128 d0 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x0), _mm_mul_ps(b, y0)), _mm_mul_ps(c, z0)), w);
+                    const __m128 d1 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x1), _mm_mul_ps(b, y1)), _mm_mul_ps(c, z1)), w);
+                    const __m128 out0 = _mm_cmplt_ps(d0, zero), out1 = _mm_cmplt_ps(d1, zero);
+                    const __m128 t = _mm_div_ps(d0, _mm_sub_ps(d0, d1));
+
+                    const __m128 both = _mm_and_ps(out0, out1);
+                    const __m128 enter = _mm_andnot_ps(out1, out0), leave = _mm_andnot_ps(out0, out1);
+
+                    first = _mm_or_ps(_mm_andnot_ps(enter, first), _mm_and_ps(enter, _mm_max_ps(first, t)));
+                    last = _mm_or_ps(_mm_andnot_ps(leave, last), _mm_and_ps(leave, _mm_min_ps(last, t)));
+                    first = _mm_or_ps(_mm_andnot_ps(both, first), _mm_and_ps(both, one));
+                    last = _mm_andnot_ps(both, last);
+                }
+
+                _mm_storeu_ps(t0 + i, first);
+                _mm_storeu_ps(t1 + i, last);
+            }
+
+            scalar::clip_segments(planes, planeCount, bx + i, by + i, bz + i, ex + i, ey + i, ez + i, t0 + i, t1 + i, count - i);
+        }
+
+        MATH_TARGET("sse2")
+        inline void project(const float focal, const float *x, const float *y, const float *z,
+                            float *outX, float *outY, const std::size_t count)
+        {
+            const __m128 f = _mm_set1_ps(0 - focal);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 s = _mm_div_ps(f, _mm_loadu_ps(z + i));
+
+                _mm_storeu_ps(outX + i, _mm_mul_ps(s, _mm_loadu_ps(x + i)));
+                _mm_storeu_ps(outY + i, _mm_mul_ps(s, _mm_loadu_ps(y + i)));
+            }
+
+            scalar::project(focal, x + i, y + i, z + i, outX + i, outY + i, count - i);
+        }
+
+        inline const KernelTable &table()
+        {
+            static const KernelTable t = {Isa::sse2, &transform_points, &spheres_outside, &clip_segments, &project};
+            return t;
+        }
+    }
+
+    namespace avx2
+    {
+        MATH_TARGET("avx2")
+        inline void transform_points(const float *mat, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            __m256 m[12];
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 3; ++c)
+                    m[3 * r + c] = _mm256_set1_ps(mat[4 * r + c]);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i), pz = _mm256_loadu_ps(z + i);
+
+                _mm256_storeu_ps(outX + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, m[0]), _mm256_mul_ps(py, m[3])), _mm256_mul_ps(pz, m[6])), m[9]));
+                _mm256_storeu_ps(outY + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, m[1]), _mm256_mul_ps(py, m[4])), _mm256_mul_ps(pz, m[7])), m[10]));
+                _mm256_storeu_ps(outZ + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, m[2]), _mm256_mul_ps(py, m[5])), _mm256_mul_ps(pz, m[8])), m[11]));
+            }
+
+            scalar::transform_points(mat, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+        }
+
+        MATH_TARGET("avx2")
+        inline void spheres_outside(const float *planes, const std::size_t planeCount,
+                                    const float *cx, const float *cy, const float *cz, const float *radius,
+                                    std::uint8_t *outside, const std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+                const __m256 r = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius + i));
+                __m256 out = _mm256_setzero_ps();
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(eq[0]), x), _mm256_mul_ps(_mm256_set1_ps(eq[1]), y)),
+                                                                 _mm256_mul_ps(_mm256_set1_ps(eq[2]), z)), _mm256_set1_ps(eq[3]));
+                    out = _mm256_or_ps(out, _mm256_cmp_ps(d, r, _CMP_LT_OQ));
+                }
+
+                const int bits = _mm256_movemask_ps(out);
+                for (int l = 0; l < 8; ++l)
+                    outside[i + l] = (bits >> l) & 1;
+            }
+
+            scalar::spheres_outside(planes, planeCount, cx + i, cy + i, cz + i, radius + i, outside + i, count - i);
+        }
+
+        MATH_TARGET("avx2")
+        inline void clip_segments(const float *planes, const std::size_t planeCount,
+                                  const float *bx, const float *by, const float *bz,
+                                  const float *ex, const float *ey, const float *ez,
+                                  float *t0, float *t1, const std::size_t count)
+        {
+            const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x0 = _mm256_loadu_ps(bx + i), y0 = _mm256_loadu_ps(by + i), z0 = _mm256_loadu_ps(bz + i);
+                const __m256 x1 = _mm256_loadu_ps(ex + i), y1 = _mm256_loadu_ps(ey + i), z1 = _mm256_loadu_ps(ez + i);
+                __m256 first = zero, last = one;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m256 a = _mm256_set1_ps(eq[0]), b = _mm256_set1_ps(eq[1]), c = _mm256_set1_ps(eq[2]), w = _mm256_set1_ps(eq[3]);
+                    const __m256 d0 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x0), _mm256_mul_ps(b, y0)), _mm256_mul_ps(c, z0)), w);
+                    const __m256 d1 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x1), _mm256_mul_ps(b, y1)), _mm256_mul_ps(c, z1)), w);
+                    const __m256 out0 = _mm256_cmp_ps(d0, zero, _CMP_LT_OQ), out1 = _mm256_cmp_ps(d1, zero, _CMP_LT_OQ);
+                    const __m256 t = _mm256_div_ps(d0, _mm256_sub_ps(d0, d1));
+
+                    const __m256 both = _mm256_and_ps(out0, out1);
+                    const __m256 enter = _mm256_andnot_ps(out1, out0), leave = _mm256_andnot_ps(out0, out1);
+
+                    first = _mm256_blendv_ps(first, _mm256_max_ps(first, t), enter);
+                    last = _mm256_blendv_ps(last, _mm256_min_ps(last, t), leave);
+                    first = _mm256_blendv_ps(first, one, both);
+                    last = _mm256_blendv_ps(last, zero, both);
+                }
+
+                _mm256_storeu_ps(t0 + i, first);
+                _mm256_storeu_ps(t1 + i, last);
+            }
+
+            scalar::clip_segments(planes, planeCount, bx + i, by + i, bz + i, ex + i, ey + i, ez + i, t0 + i, t1 + i, count - i);
+        }
+
+        MATH_TARGET("avx2")
+        inline void project(const float focal, const float *x, const float *y, const float *z,
+                            float *outX, float *outY, const std::size_t count)
+        {
+            const __m256 f = _mm256_set1_ps(0 - focal);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 s = _mm256_div_ps(f, _mm256_loadu_ps(z + i));
+
+                _mm256_storeu_ps(outX + i, _mm256_mul_ps(s, _mm256_loadu_ps(x + i)));
+                _mm256_storeu_ps(outY + i, _mm256_mul_ps(s, _mm256_loadu_ps(y + i)));
+            }
+
+            scalar::project(focal, x + i, y + i, z + i, outX + i, outY + i, count - i);
+        }
+
+        inline const KernelTable &table()
+        {
+            static const KernelTable t = {Isa::avx2, &transform_points, &spheres_outside, &clip_segments, &project};
+            return t;
+        }
+    }
+
+    namespace avx512
+    {
+        MATH_TARGET("avx512f")
+        inline void transform_points(const float *mat, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            __m512 m[12];
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 3; ++c)
+                    m[3 * r + c] = _mm512_set1_ps(mat[4 * r + c]);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 px = _mm512_loadu_ps(x + i), py = _mm512_loadu_ps(y + i), pz = _mm512_loadu_ps(z + i);
+
+                _mm512_storeu_ps(outX + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, m[0]), _mm512_mul_ps(py, m[3])), _mm512_mul_ps(pz, m[6])), m[9]));
+                _mm512_storeu_ps(outY + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, m[1]), _mm512_mul_ps(py, m[4])), _mm512_mul_ps(pz, m[7])), m[10]));
+                _mm512_storeu_ps(outZ + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, m[2]), _mm512_mul_ps(py, m[5])), _mm512_mul_ps(pz, m[8])), m[11]));
+            }
+
+            scalar::transform_points(mat, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+        }
+
+        MATH_TARGET("avx512f")
+        inline void spheres_outside(const float *planes, const std::size_t planeCount,
+                                    const float *cx, const float *cy, const float *cz, const float *radius,
+                                    std::uint8_t *outside, const std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 x = _mm512_loadu_ps(cx + i), y = _mm512_loadu_ps(cy + i), z = _mm512_loadu_ps(cz + i);
+                const __m512 r = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_loadu_ps(radius + i));
+                __mmask16 out = 0;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m512 d = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(eq[0]), x), _mm512_mul_ps(_mm512_set1_ps(eq[1]), y)),
+                                                                 _mm512_mul_ps(_mm512_set1_ps(eq[2]), z)), _mm512_set1_ps(eq[3]));
+                    out |= _mm512_cmp_ps_mask(d, r, _CMP_LT_OQ);
+                }
+
+                _mm512_mask_cvtepi32_storeu_epi8(outside + i, 0xffff, _mm512_maskz_set1_epi32(out, 1));
+            }
+
+            scalar::spheres_outside(planes, planeCount, cx + i, cy + i, cz + i, radius + i, outside + i, count - i);
+        }
+
+        MATH_TARGET("avx512f")
+        inline void clip_segments(const float *planes, const std::size_t planeCount,
+                                  const float *bx, const float *by, const float *bz,
+                                  const float *ex, const float *ey, const float *ez,
+                                  float *t0, float *t1, const std::size_t count)
+        {
+            const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 x0 = _mm512_loadu_ps(bx + i), y0 = _mm512_loadu_ps(by + i), z0 = _mm512_loadu_ps(bz + i);
+                const __m512 x1 = _mm512_loadu_ps(ex + i), y1 = _mm512_loadu_ps(ey + i), z1 = _mm512_loadu_ps(ez + i);
+                __m512 first = zero, last = one;
+
+                for (std::size_t k = 0; k < planeCount; ++k)
+                {
+                    const float *eq = planes + 4 * k;
+                    const __m512 a = _mm512_set1_ps(eq[0]), b = _mm512_set1_ps(eq[1]), c = _mm512_set1_ps(eq[2]), w = _mm512_set1_ps(eq[3]);
+                    const __m512 d0 = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(a, x0), _mm512_mul_ps(b, y0)), _mm512_mul_ps(c, z0)), w);
+                    const __m512 d1 = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(a, x1), _mm512_mul_ps(b, y1)), _mm512_mul_ps(c, z1)), w);
+                    const __mmask16 out0 = _mm512_cmp_ps_mask(d0, zero, _CMP_LT_OQ), out1 = _mm512_cmp_ps_mask(d1, zero, _CMP_LT_OQ);
+                    const __m512 t = _mm512_div_ps(d0, _mm512_sub_ps(d0, d1));
+
+                    const __mmask16 both = out0 & out1;
+                    first = _mm512_mask_max_ps(first, out0 & ~out1, first, t);
+                    last = _mm512_mask_min_ps(last, out1 & ~out0, last, t);
+                    first = _mm512_mask_mov_ps(first, both, one);
+                    last = _mm512_mask_mov_ps(last, both, zero);
+                }
+
+                _mm512_storeu_ps(t0 + i, first);
+                _mm512_storeu_ps(t1 + i, last);
+            }
+
+            scalar::clip_segments(planes, planeCount, bx + i, by + i, bz + i, ex + i, ey + i, ez + i, t0 + i, t1 + i, count - i);
+        }
+
+        MATH_TARGET("avx512f")
+        inline void project(const float focal, const float *x, const float *y, const float *z,
+                            float *outX, float *outY, const std::size_t count)
+        {
+            const __m512 f = _mm512_set1_ps(0 - focal);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 s = _mm512_div_ps(f, _mm512_loadu_ps(z + i));
+
+                _mm512_storeu_ps(outX + i, _mm512_mul_ps(s, _mm512_loadu_ps(x + i)));
+                _mm512_storeu_ps(outY + i, _mm512_mul_ps(s, _mm512_loadu_ps(y + i)));
+            }
+
+            scalar::project(focal, x + i, y + i, z + i, outX + i, outY + i, count - i);
+        }
+
+        inline const KernelTable &table()
+        {
+            static const KernelTable t = {Isa::avx512, &transform_points, &spheres_outside, &clip_segments, &project};
+            return t;
+        }
+    }
+#endif
+
+    /**
+     * @brief Indique si le processeur et le systeme permettent d'utiliser un jeu d'instructions
+     *
+     * Sans MATH_DISPATCH_X86 seule la version scalaire est disponible.
+     */
+    inline bool supported(const Isa isa)
+    {
+#ifdef MATH_DISPATCH_X86
+        __builtin_cpu_init();
+
+        switch (isa)
+        {
+        case Isa::sse2:
+            return __builtin_cpu_supports("sse2");
+        case Isa::avx2:
+            return __builtin_cpu_supports("avx2");
+        case Isa::avx512:
+            return __builtin_cpu_supports("avx512f");
+        default:
+            return true;
+        }
+#else
+        return isa == Isa::scalar;
+#endif
+    }
+
+    /**
+     * @brief Le jeu d'instructions le plus rapide supporte par le processeur
+     */
+    inline Isa detect()
+    {
+        for (Isa isa : {Isa::avx512, Isa::avx2, Isa::sse2})
+            if (supported(isa))
+                return isa;
+
+        return Isa::scalar;
+    }
+
+    /**
+     * @brief Les noyaux d'un jeu d'instructions, qui doit etre supporte
+     */
+    inline const KernelTable &table(const Isa isa)
+    {
+        switch (isa)
+        {
+#ifdef MATH_DISPATCH_X86
+        case Isa::sse2:
+            return sse2::table();
+        case Isa::avx2:
+            return avx2::table();
+        case Isa::avx512:
+            return avx512::table();
+#endif
+        default:
+            return scalar::table();
+        }
+    }
+
+    /**
+     * @brief Jeu d'instructions initial : MATH_KERNELS s'il est defini et
+     * supporte, detect() sinon
+     */
+    inline Isa initial()
+    {
+        const char *env = std::getenv("MATH_KERNELS");
+
+        if (env != nullptr)
+            for (Isa isa : {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512})
+                if (std::strcmp(env, name(isa)) == 0 && supported(isa))
+                    return isa;
+
+        return detect();
+    }
+
+    /**
+     * @brief Table des noyaux en service
+     */
+    inline const KernelTable *&current()
+    {
+        static const KernelTable *t = &table(initial());
+        return t;
+    }
+
+    /**
+     * @brief Les noyaux en service, choisis au premier appel
+     */
+    inline const KernelTable &kernels()
+    {
+        return *current();
+    }
+
+    /**
+     * @brief Impose les noyaux d'un jeu d'instructions, par exemple pour les comparer
+     *
+     * N'est pas protege contre les appels concurrents aux noyaux.
+     * @return false, sans rien changer, si le jeu d'instructions n'est pas supporte
+     */
+    inline bool select(const Isa isa)
+    {
+        if (!supported(isa))
+            return false;
+
+        current() = &table(isa);
+        return true;
+    }
+
+    /**
+     * @brief Affiche les jeux d'instructions supportes et les noyaux en service
+     */
+    inline void print_kernels(std::ostream &out)
+    {
+        out << "Supported:";
+        for (Isa isa : {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512})
+            if (supported(isa))
+                out << ' ' << name(isa);
+        out << '\n';
+
+        const Isa isa = kernels().isa;
+        out << "transform_points: " << name(isa) << '\n'
+            << "spheres_outside: " << name(isa) << '\n'
+            << "clip_segments: " << name(isa) << '\n'
+            << "project: " << name(isa) << '\n';
+    }
+}
+}
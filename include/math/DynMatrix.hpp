@@ -0,0 +1,450 @@
+#pragma once
+
+#include "math/AlignedAllocator.hpp"
+#include "math/Matrix.hpp"
+#include "math/Simd.hpp"
+#include "math/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#define DYN_MATRIX_ALIGNMENT 64
+
+namespace math
+{
+    /**
+     * @class GemmBlocking
+     * @brief Decoupage du produit de grandes matrices
+     *
+     * Un panneau kc x nc de B reste dans le cache de dernier niveau (2 Mo), un
+     * bloc mc x kc de A dans le cache L2 (128 Ko) ; les micro-noyaux parcourent
+     * ces blocs par tuiles mr x nr tenues dans les registres.
+     */
+    template<class T>
+    struct GemmBlocking
+    {
+        typedef simd::GemmKernel<T> kernel;
+
+        static constexpr std::size_t kc = 256; /**< Profondeur d'un bloc */
+        static constexpr std::size_t mc = 131072 / (kc * sizeof(T)) / kernel::mr * kernel::mr; /**< Lignes d'un bloc de A */
+        static constexpr std::size_t nc = 2097152 / (kc * sizeof(T)) / kernel::nr * kernel::nr; /**< Colonnes d'un panneau de B */
+    };
+
+    template<class T> constexpr std::size_t GemmBlocking<T>::kc;
+    template<class T> constexpr std::size_t GemmBlocking<T>::mc;
+    template<class T> constexpr std::size_t GemmBlocking<T>::nc;
+
+    /**
+     * @brief Range un bloc de A en panneaux de mr lignes, colonne par colonne,
+     * en completant la derniere par des zeros
+     */
+    template<class T>
+    void gemm_pack_a(const T *a, const std::size_t lda, const std::size_t rows, const std::size_t depth, T *out)
+    {
+        const unsigned int mr = simd::GemmKernel<T>::mr;
+
+        for (std::size_t i = 0; i < rows; i += mr)
+            for (std::size_t k = 0; k < depth; ++k)
+                for (unsigned int r = 0; r < mr; ++r)
+                    *out++ = i + r < rows ? a[(i + r) * lda + k] : T();
+    }
+
+    /**
+     * @brief Range un panneau de B en bandes de nr colonnes, ligne par ligne,
+     * en completant la derniere par des zeros
+     */
+    template<class T>
+    void gemm_pack_b(const T *b, const std::size_t ldb, const std::size_t depth, const std::size_t cols, T *out)
+    {
+        const unsigned int nr = simd::GemmKernel<T>::nr;
+
+        for (std::size_t j = 0; j < cols; j += nr)
+            for (std::size_t k = 0; k < depth; ++k)
+                for (unsigned int c = 0; c < nr; ++c)
+                    *out++ = j + c < cols ? b[k * ldb + j + c] : T();
+    }
+
+    /**
+     * @brief Calcule c += a * b, a etant rows x inner et b inner x cols, stockees ligne par ligne
+     *
+     * Les blocs de A et B sont recopies dans des tampons alignes, puis chaque tuile
+     * mr x nr de C est calculee par simd::GemmKernel. Les tuiles incompletes du bord
+     * passent par un tampon intermediaire.
+     * @param lda, ldb, ldc L'ecart, en nombre de T, entre deux lignes de chaque matrice
+     */
+    template<class T>
+    void gemm(const std::size_t rows, const std::size_t cols, const std::size_t inner,
+              const T *a, const std::size_t lda, const T *b, const std::size_t ldb, T *c, const std::size_t ldc)
+    {
+        typedef GemmBlocking<T> blocking;
+        typedef simd::GemmKernel<T> kernel;
+        const unsigned int mr = kernel::mr, nr = kernel::nr;
+
+        std::vector<T, AlignedAllocator<T, DYN_MATRIX_ALIGNMENT>> packedA(blocking::mc * blocking::kc);
+        std::vector<T, AlignedAllocator<T, DYN_MATRIX_ALIGNMENT>> packedB(blocking::kc * std::min<std::size_t>(blocking::nc, (cols + nr - 1) / nr * nr));
+        alignas(DYN_MATRIX_ALIGNMENT) T edge[mr * nr];
+
+        for (std::size_t jc = 0; jc < cols; jc += blocking::nc)
+        {
+            const std::size_t nb = std::min(blocking::nc, cols - jc);
+
+            for (std::size_t pc = 0; pc < inner; pc += blocking::kc)
+            {
+                const std::size_t kb = std::min(blocking::kc, inner - pc);
+
+                gemm_pack_b(b + pc * ldb + jc, ldb, kb, nb, packedB.data());
+
+                for (std::size_t ic = 0; ic < rows; ic += blocking::mc)
+                {
+                    const std::size_t mb = std::min(blocking::mc, rows - ic);
+
+                    gemm_pack_a(a + ic * lda + pc, lda, mb, kb, packedA.data());
+
+                    for (std::size_t jr = 0; jr < nb; jr += nr)
+                    {
+                        const T *panelB = packedB.data() + jr * kb;
+
+                        for (std::size_t ir = 0; ir < mb; ir += mr)
+                        {
+                            const T *panelA = packedA.data() + ir * kb;
+                            T *tile = c + (ic + ir) * ldc + jc + jr;
+
+                            if (ir + mr <= mb && jr + nr <= nb)
+                            {
+                                kernel::run(kb, panelA, panelB, tile, ldc);
+                                continue;
+                            }
+
+                            std::fill(edge, edge + mr * nr, T());
+                            kernel::run(kb, panelA, panelB, edge, nr);
+
+                            for (std::size_t i = 0; i < std::min<std::size_t>(mr, mb - ir); ++i)
+                                for (std::size_t j = 0; j < std::min<std::size_t>(nr, nb - jr); ++j)
+                                    tile[i * ldc + j] += edge[i * nr + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Calcule c += a * b en repartissant les lignes de C entre les threads du pool
+     *
+     * Chaque thread traite des lignes consecutives, par multiples de mr, avec sa
+     * propre copie des panneaux de B.
+     */
+    template<class T>
+    void gemm(const std::size_t rows, const std::size_t cols, const std::size_t inner,
+              const T *a, const std::size_t lda, const T *b, const std::size_t ldb, T *c, const std::size_t ldc,
+              ThreadPool &pool)
+    {
+        const unsigned int mr = simd::GemmKernel<T>::mr;
+        const std::size_t tiles = (rows + mr - 1) / mr;
+
+        pool.parallel_for(0, tiles, 64 / mr, [=](const std::size_t first, const std::size_t last) {
+            const std::size_t begin = first * mr, end = std::min(rows, last * mr);
+            gemm(end - begin, cols, inner, a + begin * lda, lda, b, ldb, c + begin * ldc, ldc);
+        });
+    }
+
+    /**
+     * @class DynMatrix
+     * @brief Matrice dense dont la taille est fixee a l'execution
+     *
+     * Les coefficients sont stockes ligne par ligne sur le tas ; chaque ligne est
+     * alignee sur DYN_MATRIX_ALIGNMENT octets et completee par des zeros jusqu'a
+     * stride() coefficients. Le produit passe par gemm, parallelise au-dela de
+     * parallel_threshold operations. Des blocs de taille fixe peuvent etre lus et
+     * ecrits sous forme de Matrix.
+     */
+    template<class T>
+    class DynMatrix
+    {
+    public:
+        typedef std::vector<T, AlignedAllocator<T, DYN_MATRIX_ALIGNMENT>> storage;
+
+        static constexpr std::size_t parallel_threshold = std::size_t(1) << 21; /**< Nombre de multiplications a partir duquel le produit est parallelise */
+
+    private:
+        std::size_t n; /**< Nombre de lignes */
+        std::size_t m; /**< Nombre de colonnes */
+        std::size_t ld; /**< Ecart entre deux lignes, multiple de padding() */
+        storage mat; /**< Coefficients, ligne par ligne */
+
+        /**
+         * @brief Nombre de colonnes de la plus longue ligne
+         */
+        static std::size_t widest(const std::initializer_list<std::initializer_list<T>> &table)
+        {
+            std::size_t cols = 0;
+            for (const std::initializer_list<T> &liste : table)
+                cols = std::max(cols, liste.size());
+
+            return cols;
+        }
+
+        /**
+         * @brief Verifie les dimensions d'un produit res = a * b
+         */
+        static void check_product(const DynMatrix &a, const DynMatrix &b, const DynMatrix &res)
+        {
+            if (a.m != b.n || res.n != a.n || res.m != b.m)
+                throw std::invalid_argument("Matrix dimensions do not match");
+            if (&res == &a || &res == &b)
+                throw std::invalid_argument("The result must not alias an operand");
+        }
+
+        /**
+         * @brief Verifie qu'un bloc de taille rows x cols en i, j est dans la matrice
+         */
+        void check_block(const std::size_t i, const std::size_t j, const std::size_t rows, const std::size_t cols) const
+        {
+            if (i > n || j > m || rows > n - i || cols > m - j)
+                throw std::out_of_range("Block out of the matrix");
+        }
+
+    public:
+        /**
+         * @brief Nombre de coefficients par ligne de cache, stride() en est toujours un multiple
+         */
+        static constexpr std::size_t padding()
+        {
+            return DYN_MATRIX_ALIGNMENT / sizeof(T) > 0 ? DYN_MATRIX_ALIGNMENT / sizeof(T) : 1;
+        }
+
+        /**
+         * @brief Construit une matrice vide
+         */
+        DynMatrix() : n(0), m(0), ld(0)
+        {
+        }
+
+        /**
+         * @brief Construit une matrice nulle
+         * @param rows Le nombre de lignes
+         * @param cols Le nombre de colonnes
+         */
+        DynMatrix(const std::size_t rows, const std::size_t cols) :
+            n(rows), m(cols), ld((cols + padding() - 1) / padding() * padding()), mat(rows * ld, T())
+        {
+        }
+
+        /**
+         * @brief Initialise une matrice ligne par ligne ; les coefficients non precises sont nuls
+         * @param table Les lignes de la matrice
+         */
+        DynMatrix(const std::initializer_list<std::initializer_list<T>> &table) : DynMatrix(table.size(), widest(table))
+        {
+            std::size_t i = 0;
+            for (const std::initializer_list<T> &liste : table)
+                std::copy(liste.begin(), liste.end(), row(i++));
+        }
+
+        /**
+         * @brief Recopie une matrice de taille fixe
+         * @param fixed La matrice a recopier
+         */
+        template<unsigned int rows, unsigned int cols, class P>
+        explicit DynMatrix(const Matrix<T, rows, cols, P> &fixed) : DynMatrix(rows, cols)
+        {
+            set_block(0, 0, fixed);
+        }
+
+        /**
+         * @brief Construit la matrice identite
+         * @param size Le nombre de lignes et de colonnes
+         */
+        static DynMatrix identity(const std::size_t size)
+        {
+            DynMatrix id(size, size);
+
+            for (std::size_t i = 0; i < size; ++i)
+                id(i, i) = T(1);
+
+            return id;
+        }
+
+        std::size_t rows() const { return n; }
+        std::size_t cols() const { return m; }
+
+        /**
+         * @brief Ecart, en nombre de T, entre le debut de deux lignes consecutives
+         */
+        std::size_t stride() const { return ld; }
+
+        /**
+         * @brief Accede aux coefficients, ligne par ligne, espaces de stride()
+         */
+        T *data() { return mat.data(); }
+        const T *data() const { return mat.data(); }
+
+        /**
+         * @brief Accede a la ligne i, alignee sur DYN_MATRIX_ALIGNMENT octets
+         */
+        T *row(const std::size_t i) { return mat.data() + i * ld; }
+        const T *row(const std::size_t i) const { return mat.data() + i * ld; }
+
+        /**
+         * @brief Accede au coefficient i, j sans verification
+         */
+        T &operator()(const std::size_t i, const std::size_t j) { return mat[i * ld + j]; }
+        T operator()(const std::size_t i, const std::size_t j) const { return mat[i * ld + j]; }
+
+        /**
+         * @brief Obtient le coefficient i, j
+         * @return La valeur du coefficient
+         * @throw std::out_of_range Si i ou j est hors de la matrice
+         */
+        T at(const std::size_t i, const std::size_t j) const
+        {
+            if (i >= n || j >= m)
+                throw std::out_of_range("Index out of the matrix");
+
+            return mat[i * ld + j];
+        }
+
+        /**
+         * @brief Recopie le bloc rows x cols commencant en i, j dans une matrice de taille fixe
+         * @throw std::out_of_range Si le bloc depasse de la matrice
+         */
+        template<unsigned int rows, unsigned int cols, class P = Exact>
+        Matrix<T, rows, cols, P> block(const std::size_t i, const std::size_t j) const
+        {
+            check_block(i, j, rows, cols);
+
+            Matrix<T, rows, cols, P> res;
+            for (unsigned int r = 0; r < rows; ++r)
+                std::copy(row(i + r) + j, row(i + r) + j + cols, res.data() + r * cols);
+
+            return res;
+        }
+
+        /**
+         * @brief Remplace le bloc commencant en i, j par une matrice de taille fixe
+         * @throw std::out_of_range Si le bloc depasse de la matrice
+         */
+        template<unsigned int rows, unsigned int cols, class P>
+        void set_block(const std::size_t i, const std::size_t j, const Matrix<T, rows, cols, P> &fixed)
+        {
+            check_block(i, j, rows, cols);
+
+            for (unsigned int r = 0; r < rows; ++r)
+                std::copy(fixed.data() + r * cols, fixed.data() + (r + 1) * cols, row(i + r) + j);
+        }
+
+        /**
+         * @brief Calcule la transposee
+         */
+        DynMatrix transpose() const
+        {
+            DynMatrix res(m, n);
+
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < m; ++j)
+                    res(j, i) = (*this)(i, j);
+
+            return res;
+        }
+
+        /**
+         * @brief Addition terme a terme
+         * @throw std::invalid_argument Si les dimensions different
+         */
+        DynMatrix &operator+=(const DynMatrix &m2)
+        {
+            if (n != m2.n || m != m2.m)
+                throw std::invalid_argument("Matrix dimensions do not match");
+
+            for (std::size_t k = 0; k < mat.size(); ++k)
+                mat[k] += m2.mat[k];
+
+            return *this;
+        }
+
+        DynMatrix operator+(const DynMatrix &m2) const
+        {
+            DynMatrix res(*this);
+            return res += m2;
+        }
+
+        DynMatrix &operator*=(const T scalar)
+        {
+            for (T &coef : mat)
+                coef *= scalar;
+
+            return *this;
+        }
+
+        /**
+         * @brief Produit matriciel, reparti sur ThreadPool::global() pour les grandes tailles
+         * @throw std::invalid_argument Si le nombre de colonnes ne correspond pas au nombre de lignes de m2
+         */
+        DynMatrix operator*(const DynMatrix &m2) const
+        {
+            DynMatrix res(n, m2.m);
+
+            if (n * m * m2.m >= parallel_threshold)
+                multiply(*this, m2, res, ThreadPool::global());
+            else
+                multiply(*this, m2, res);
+
+            return res;
+        }
+
+        /**
+         * @brief Calcule res = a * b sur le thread appelant
+         * @param res La matrice resultat, deja dimensionnee a a.rows() x b.cols() et distincte de a et b
+         * @throw std::invalid_argument Si les dimensions ne correspondent pas
+         */
+        static void multiply(const DynMatrix &a, const DynMatrix &b, DynMatrix &res)
+        {
+            check_product(a, b, res);
+            std::fill(res.mat.begin(), res.mat.end(), T());
+            gemm(a.n, b.m, a.m, a.data(), a.ld, b.data(), b.ld, res.data(), res.ld);
+        }
+
+        /**
+         * @brief Calcule res = a * b en repartissant les lignes entre les threads de pool
+         * @param res La matrice resultat, deja dimensionnee a a.rows() x b.cols() et distincte de a et b
+         * @throw std::invalid_argument Si les dimensions ne correspondent pas
+         */
+        static void multiply(const DynMatrix &a, const DynMatrix &b, DynMatrix &res, ThreadPool &pool)
+        {
+            check_product(a, b, res);
+            std::fill(res.mat.begin(), res.mat.end(), T());
+            gemm(a.n, b.m, a.m, a.data(), a.ld, b.data(), b.ld, res.data(), res.ld, pool);
+        }
+
+        /**
+         * @brief Compare les dimensions et les coefficients
+         */
+        bool operator==(const DynMatrix &m2) const
+        {
+            return n == m2.n && m == m2.m && mat == m2.mat;
+        }
+
+        bool operator!=(const DynMatrix &m2) const
+        {
+            return !(*this == m2);
+        }
+    };
+
+    template<class T>
+    std::ostream &operator<<(std::ostream &out, const DynMatrix<T> &mat)
+    {
+        for (std::size_t i = 0; i < mat.rows(); ++i)
+        {
+            out << "[";
+            for (std::size_t j = 0; j < mat.cols(); ++j)
+                out << (j > 0 ? ", " : "") << mat(i, j);
+            out << "]" << std::endl;
+        }
+
+        return out;
+    }
+}
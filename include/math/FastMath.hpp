@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "math/Simd.hpp"
+
+/**
+ * @namespace math
+ *
+ * Fonctions mathematiques utilisees par Vector, Quaternion et Transformation.
+ * StdMath repose sur la bibliotheque standard, FastMath sur des approximations
+ * (racine carree inverse affinee par une iteration de Newton, polynomes pour
+ * sinus et cosinus). DefaultMath designe FastMath lorsque MATH_FAST_MATH est
+ * defini a la compilation, StdMath sinon.
+ */
+namespace math
+{
+    /**
+     * @class StdMath
+     * @brief Fonctions de la bibliotheque standard, comportement historique
+     */
+    struct StdMath
+    {
+        /**
+         * @brief Calcule la racine carree inverse
+         * @param x La valeur, strictement positive
+         * @return 1 / sqrt(x)
+         */
+        static float rsqrt(const float x)
+        {
+            return 1 / std::sqrt(x);
+        }
+
+        /**
+         * @brief Calcule le sinus et le cosinus d'un angle
+         * @param x L'angle en radians
+         * @param s Le sinus de l'angle
+         * @param c Le cosinus de l'angle
+         */
+        template<class T>
+        static void sincos(const T x, T &s, T &c)
+        {
+            s = std::sin(x);
+            c = std::cos(x);
+        }
+
+        /**
+         * @brief Normalise un ensemble de vecteurs de dimension 3
+         * @param v Les composantes du premier vecteur
+         * @param count Le nombre de vecteurs
+         * @param stride L'ecart, en nombre de float, entre deux vecteurs consecutifs
+         */
+        static void normalize(float *v, const std::size_t count, const std::size_t stride)
+        {
+            for (std::size_t i = 0; i < count; ++i, v += stride)
+            {
+                const float r = rsqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+                v[0] *= r;
+                v[1] *= r;
+                v[2] *= r;
+            }
+        }
+    };
+
+    /**
+     * @class FastMath
+     * @brief Approximations en simple precision
+     *
+     * rsqrt a une erreur relative de l'ordre de 1e-7 (estimation materielle sur
+     * 12 bits puis une iteration de Newton), sincos une erreur absolue inferieure
+     * a 1e-6 pour |x| < 8192.
+     */
+    struct FastMath
+    {
+        /**
+         * @brief Calcule une approximation de la racine carree inverse
+         * @param x La valeur, strictement positive
+         * @return Une approximation de 1 / sqrt(x)
+         */
+        static float rsqrt(const float x)
+        {
+#ifdef MATH_SIMD_SSE
+            const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+            // Estimation initiale par manipulation de l'exposant, precise a 4 bits pres,
+            // affinee par deux iterations supplementaires
+            std::uint32_t i;
+            std::memcpy(&i, &x, sizeof(float));
+            i = 0x5f3759df - (i >> 1);
+
+            float y;
+            std::memcpy(&y, &i, sizeof(float));
+            y = y * (1.5f - 0.5f * x * y * y);
+            y = y * (1.5f - 0.5f * x * y * y);
+#endif
+            return y * (1.5f - 0.5f * x * y * y);
+        }
+
+        /**
+         * @brief Calcule une approximation du sinus et du cosinus d'un angle
+         *
+         * L'angle est ramene dans [-pi/4, pi/4] par octant, puis sinus et cosinus
+         * sont evalues par des polynomes de degre 7 et 8.
+         * @param x L'angle en radians
+         * @param s Le sinus de l'angle
+         * @param c Le cosinus de l'angle
+         */
+        template<class T>
+        static void sincos(const T x, T &s, T &c)
+        {
+            float a = std::fabs(float(x));
+            int j = int(a * 1.27323954473516f); // 4 / pi
+            j += j & 1;
+
+            const float y = float(j);
+            a = ((a - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+
+            const float z = a * a;
+            const float sp = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * a + a;
+            const float cp = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1;
+
+            // Octants 2 et 6 : sinus et cosinus sont echanges. Le signe du sinus change
+            // dans les octants 4 et 6, celui du cosinus dans les octants 2 et 4.
+            const bool swap = (j & 2) != 0;
+            const float fs = swap ? cp : sp;
+            const float fc = swap ? sp : cp;
+            const bool negS = ((j & 4) != 0) != (x < 0);
+            const bool negC = (((j + 2) & 4) != 0);
+
+            s = T(negS ? -fs : fs);
+            c = T(negC ? -fc : fc);
+        }
+
+        /**
+         * @brief Normalise un ensemble de vecteurs de dimension 3
+         *
+         * Avec SSE, les vecteurs alignes sur 16 octets et stockes sur quatre composantes
+         * (stride = 4, quatrieme composante nulle) sont traites par groupes de quatre.
+         * Un vecteur nul donne des composantes NaN.
+         * @param v Les composantes du premier vecteur
+         * @param count Le nombre de vecteurs
+         * @param stride L'ecart, en nombre de float, entre deux vecteurs consecutifs
+         */
+        static void normalize(float *v, const std::size_t count, const std::size_t stride)
+        {
+            std::size_t i = 0;
+#ifdef MATH_SIMD_SSE
+            const __m128 half = _mm_set1_ps(0.5f), threeHalves = _mm_set1_ps(1.5f);
+
+            const bool packed = stride == 4 && reinterpret_cast<std::uintptr_t>(v) % 16 == 0;
+
+            for (; packed && i + 4 <= count; i += 4, v += 4 * stride)
+            {
+                __m128 a = _mm_load_ps(v), b = _mm_load_ps(v + stride);
+                __m128 c = _mm_load_ps(v + 2 * stride), d = _mm_load_ps(v + 3 * stride);
+
+                _MM_TRANSPOSE4_PS(a, b, c, d);
+
+                const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c));
+                __m128 r = _mm_rsqrt_ps(len2);
+                r = _mm_mul_ps(r, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, len2), _mm_mul_ps(r, r))));
+
+                a = _mm_mul_ps(a, r);
+                b = _mm_mul_ps(b, r);
+                c = _mm_mul_ps(c, r);
+
+                _MM_TRANSPOSE4_PS(a, b, c, d);
+
+                _mm_store_ps(v, a);
+                _mm_store_ps(v + stride, b);
+                _mm_store_ps(v + 2 * stride, c);
+                _mm_store_ps(v + 3 * stride, d);
+            }
+#endif
+            for (; i < count; ++i, v += stride)
+            {
+                const float r = rsqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+                v[0] *= r;
+                v[1] *= r;
+                v[2] *= r;
+            }
+        }
+    };
+
+#ifdef MATH_FAST_MATH
+    typedef FastMath DefaultMath; /**< Fonctions utilisees par Vector, Quaternion et Transformation */
+#else
+    typedef StdMath DefaultMath; /**< Fonctions utilisees par Vector, Quaternion et Transformation */
+#endif
+}
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "math/Vector.hpp"
+#include "math/Simd.hpp"
+#include "math/Precision.hpp"
+#include "math/MatrixView.hpp"
 
 #include <array>
 #include <exception>
+#include <stdexcept>
+#include <type_traits>
 #include <cmath>
 #include <iostream>
 
@@ -11,52 +16,165 @@ using namespace std;
 
 namespace math
 {
+    template<class T, unsigned int n, unsigned int m, class P = Exact>
+    class Matrix;
+
+    /**
+     * @class MatrixExpr
+     * @brief Expression matricielle evaluee a l'affectation
+     *
+     * Comme pour VectorExpr, l'addition et le produit par un scalaire
+     * construisent une expression evaluee en une seule passe par la
+     * matrice qui la recoit.
+     */
+    template<class E, class T, unsigned int n, unsigned int m>
+    class MatrixExpr
+    {
+    public:
+        typedef T value_type;
+
+        /**
+         * @brief Accede a l'expression concrete
+         * @return L'expression concrete
+         */
+        const E &self() const
+        {
+            return static_cast<const E &>(*this);
+        }
+
+        /**
+         * @brief Evalue le coefficient i, j de l'expression
+         * @param i La ligne du coefficient
+         * @param j La colonne du coefficient
+         * @return La valeur du coefficient i, j
+         */
+        T operator()(const unsigned int i, const unsigned int j) const
+        {
+            return self()(i, j);
+        }
+    };
+
+    /**
+     * @brief Facon dont une expression conserve ses operandes : les matrices
+     * par reference, les sous-expressions par valeur
+     */
+    template<class E>
+    struct MatrixOperand
+    {
+        typedef const E type;
+    };
+
+    template<class T, unsigned int n, unsigned int m, class P>
+    struct MatrixOperand<Matrix<T, n, m, P>>
+    {
+        typedef const Matrix<T, n, m, P> &type;
+    };
+
+    /**
+     * @class MatrixSum
+     * @brief Somme de deux expressions matricielles
+     */
+    template<class L, class R, class T, unsigned int n, unsigned int m>
+    class MatrixSum : public MatrixExpr<MatrixSum<L, R, T, n, m>, T, n, m>
+    {
+    private:
+        typename MatrixOperand<L>::type l;
+        typename MatrixOperand<R>::type r;
+    public:
+        MatrixSum(const L &l, const R &r) : l(l), r(r) {}
+
+        T operator()(const unsigned int i, const unsigned int j) const
+        {
+            return l(i, j) + r(i, j);
+        }
+    };
+
+    /**
+     * @class MatrixScale
+     * @brief Produit d'une expression matricielle avec un scalaire
+     */
+    template<class E, class T, unsigned int n, unsigned int m>
+    class MatrixScale : public MatrixExpr<MatrixScale<E, T, n, m>, T, n, m>
+    {
+    private:
+        typename MatrixOperand<E>::type e;
+        float scalar;
+    public:
+        MatrixScale(const E &e, const float scalar) : e(e), scalar(scalar) {}
+
+        T operator()(const unsigned int i, const unsigned int j) const
+        {
+            return e(i, j) * scalar;
+        }
+    };
+
     /**
      * @class Matrix
      * @author xavier
      * @date 22/11/17
      * @file Matrix.hpp
      * @brief Utilitaire pour la manipulation de matrice
+     *
+     * P est la politique de precision : Exact (par defaut) ou RoundTo2Decimals.
      */
-    template<class T, unsigned int n, unsigned int m>
-    class Matrix
+    template<class T, unsigned int n, unsigned int m, class P>
+    class Matrix : public MatrixExpr<Matrix<T, n, m, P>, T, n, m>
     {
     private:
-        array<array<T, m>, n> mat;
+        alignas(simd::Traits<T, m>::alignment) array<T, n * m> mat; /**< Coefficients, ligne par ligne */
+
+        static_assert(n > 0 && m > 0, "Incorrect size");
+
+        Matrix<float, n, m, P> inverse(true_type) const
+        {
+            return cofactor_inverse();
+        }
+
+        Matrix<float, n, m, P> inverse(false_type) const
+        {
+            return gauss_jordan_inverse();
+        }
+
+        /**
+         * @brief Construit la transformation [lin -lin t ; 0 1] ou t est la
+         * translation de la matrice courante
+         * @param lin La partie lineaire de la transformation inverse
+         */
+        Matrix<float, n, m, P> affine(const array<array<float, 3>, 3> &lin) const
+        {
+            Matrix<float, n, m, P> res;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    res[i][j] = P::round(lin[i][j]);
+
+                res[i][3] = P::round(-(lin[i][0] * (*this)(0, 3) + lin[i][1] * (*this)(1, 3) + lin[i][2] * (*this)(2, 3)));
+            }
+            res[3][3] = 1;
+
+            return res;
+        }
 
     public:
         /**
          * @brief Construit une matrice nulle
          * @return La matrice nulle de dimension n, m
          */
-        Matrix() 
+        constexpr Matrix() : mat()
         {
-            if (n == 0 || m == 0)
-                throw "Incorrect size";
-            
-            for (int i = 0; i < n; ++i )
-            {
-                for (int j = 0; j < m; ++j)
-                {
-                    mat[i][j] = T();
-                }
-            }
         }
-        
+
         /**
-         * @brief Constructeur par recopie
-         * @param m2 La matrice a recopier
-         * @return Une copie de la matrice m2
+         * @brief Construit une matrice a partir de ses coefficients, ligne par ligne,
+         * utilisable dans une expression constante ; les coefficients non precises sont nuls
+         * @param a, b, rest Les coefficients de la matrice
+         * @return La matrice initialisee avec les coefficients specifies
          */
-        Matrix(const Matrix &m2)
+        template<class... U>
+        constexpr Matrix(const T a, const T b, const U... rest) : mat{{a, b, T(rest)...}}
         {
-            for (int i = 0; i < n; ++i)
-            {
-                for (int j = 0; j < m; ++j)
-                {
-                    mat[i][j] = m2[i][j];
-                }
-            }
+            static_assert(sizeof...(U) + 2 <= n * m, "Too many coefficients for the matrix");
         }
 
         /**
@@ -65,13 +183,15 @@ namespace math
          */
         Matrix(const initializer_list<initializer_list<T>> &table)
         {
+            mat.fill(T());
+
             int i = 0;
             for (const initializer_list<T> *liste = table.begin(); liste != table.end(); ++liste, ++i)
             {
                 int j = 0;
                 for (const T* element = liste->begin(); element != liste->end(); ++element, ++j)
                 {
-                    mat[i][j] = *element;
+                    mat[i * m + j] = *element;
                 }
             }
         }
@@ -80,13 +200,22 @@ namespace math
          * @brief Constructeur avec la structure de la STL
          * @param a le tableau de tableau de la STL
          */
-        Matrix(array<array<T, m>, n> &a): mat(a) {}
+        Matrix(array<array<T, m>, n> &a)
+        {
+            (*this) = a;
+        }
 
         /**
-         * @brief Destructeur
+         * @brief Evalue une expression matricielle
+         * @param e L'expression a evaluer
+         * @return La matrice resultant de l'expression
          */
-        ~Matrix() {}
-        
+        template<class E>
+        Matrix(const MatrixExpr<E, T, n, m> &e)
+        {
+            (*this) = e;
+        }
+
         /**
          * @brief Obtient la valeur situé à la coordonnées i, j
          * @param i La coordonnées i de la matrice
@@ -98,25 +227,46 @@ namespace math
             if (i >= n || j >= m)
                 throw ("Index out of the matrix");
             
-            return mat[i][j];
+            return mat[i * m + j];
+        }
+
+        /**
+         * @brief Accede au coefficient i, j sans verification
+         * @param i La ligne du coefficient
+         * @param j La colonne du coefficient
+         * @return La valeur du coefficient i, j
+         */
+        T operator()(const unsigned int i, const unsigned int j) const
+        {
+            return mat[i * m + j];
         }
 
         /**
          * @brief Calcule la matrice inverse
+         *
+         * Les matrices 4x4 sont inversees par la methode des cofacteurs, les autres
+         * par l'elimination de Gauss-Jordan.
          * @return La matrice inverse de la matrice courante
          */
-        Matrix<float, n, m> inverse() const
+        Matrix<float, n, m, P> inverse() const
         {
+            return inverse(integral_constant<bool, n == 4 && m == 4>());
+        }
 
-            if (n != m)
-                throw "La matrice n'est pas carré";
+        /**
+         * @brief Calcule la matrice inverse par l'elimination de Gauss-Jordan
+         * @return La matrice inverse de la matrice courante
+         */
+        Matrix<float, n, m, P> gauss_jordan_inverse() const
+        {
+            static_assert(n == m, "La matrice n'est pas carré");
     
-            Matrix<float, n, m> copie;
-            Matrix<float, n, m> id(copie.identite());
+            Matrix<float, n, m, P> copie;
+            Matrix<float, n, m, P> id(copie.identite());
 
             for (int i = 0; i < n; ++i)
                 for (int j = 0; j < m; ++j)
-                    copie[i][j] = (float) (mat[i][j]);
+                    copie[i][j] = (float) (mat[i * m + j]);
 
             int r = -1;
         
@@ -134,7 +284,7 @@ namespace math
                 }
 
                 if (k == -1)
-                    throw "Matrix not inversible";
+                    throw domain_error("Matrix not inversible");
 
                 float mkj = copie[k][j];
 
@@ -148,8 +298,8 @@ namespace math
                 // Echange des lignes si nécessaire
                 if (k != r)
                 {
-                    swap(copie[k], copie[r]);
-                    swap(id[k], id[r]);
+                    copie.swap_rows(k, r);
+                    id.swap_rows(k, r);
                 }
 
                 // Simplification des autres lignes
@@ -171,11 +321,152 @@ namespace math
     
             for (int i = 0; i < n; ++i)
                 for (int j = 0; j < m; ++j)
-                    id[i][j] = ROUND(id[i][j]);
+                    id[i][j] = P::round(id[i][j]);
 
             return id;
         }
 
+        /**
+         * @brief Calcule l'inverse d'une matrice 4x4 par la methode des cofacteurs
+         *
+         * Le calcul ne comporte ni recherche de pivot ni branchement : les douze
+         * determinants 2x2 des deux premieres et des deux dernieres lignes
+         * suffisent a obtenir le determinant et la comatrice.
+         * @return La matrice inverse de la matrice courante
+         */
+        Matrix<float, n, m, P> cofactor_inverse() const
+        {
+            static_assert(n == 4 && m == 4, "La methode des cofacteurs est reservee aux matrices 4x4");
+
+            const float a00 = (*this)(0, 0), a01 = (*this)(0, 1), a02 = (*this)(0, 2), a03 = (*this)(0, 3);
+            const float a10 = (*this)(1, 0), a11 = (*this)(1, 1), a12 = (*this)(1, 2), a13 = (*this)(1, 3);
+            const float a20 = (*this)(2, 0), a21 = (*this)(2, 1), a22 = (*this)(2, 2), a23 = (*this)(2, 3);
+            const float a30 = (*this)(3, 0), a31 = (*this)(3, 1), a32 = (*this)(3, 2), a33 = (*this)(3, 3);
+
+            // Determinants 2x2 des lignes 0 et 1
+            const float s0 = a00 * a11 - a10 * a01;
+            const float s1 = a00 * a12 - a10 * a02;
+            const float s2 = a00 * a13 - a10 * a03;
+            const float s3 = a01 * a12 - a11 * a02;
+            const float s4 = a01 * a13 - a11 * a03;
+            const float s5 = a02 * a13 - a12 * a03;
+
+            // Determinants 2x2 des lignes 2 et 3
+            const float c5 = a22 * a33 - a32 * a23;
+            const float c4 = a21 * a33 - a31 * a23;
+            const float c3 = a21 * a32 - a31 * a22;
+            const float c2 = a20 * a33 - a30 * a23;
+            const float c1 = a20 * a32 - a30 * a22;
+            const float c0 = a20 * a31 - a30 * a21;
+
+            const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+            if (det == 0)
+                throw domain_error("Matrix not inversible");
+
+            const float inv = 1 / det;
+            Matrix<float, n, m, P> res;
+
+            res[0][0] = P::round(( a11 * c5 - a12 * c4 + a13 * c3) * inv);
+            res[0][1] = P::round((-a01 * c5 + a02 * c4 - a03 * c3) * inv);
+            res[0][2] = P::round(( a31 * s5 - a32 * s4 + a33 * s3) * inv);
+            res[0][3] = P::round((-a21 * s5 + a22 * s4 - a23 * s3) * inv);
+
+            res[1][0] = P::round((-a10 * c5 + a12 * c2 - a13 * c1) * inv);
+            res[1][1] = P::round(( a00 * c5 - a02 * c2 + a03 * c1) * inv);
+            res[1][2] = P::round((-a30 * s5 + a32 * s2 - a33 * s1) * inv);
+            res[1][3] = P::round(( a20 * s5 - a22 * s2 + a23 * s1) * inv);
+
+            res[2][0] = P::round(( a10 * c4 - a11 * c2 + a13 * c0) * inv);
+            res[2][1] = P::round((-a00 * c4 + a01 * c2 - a03 * c0) * inv);
+            res[2][2] = P::round(( a30 * s4 - a31 * s2 + a33 * s0) * inv);
+            res[2][3] = P::round((-a20 * s4 + a21 * s2 - a23 * s0) * inv);
+
+            res[3][0] = P::round((-a10 * c3 + a11 * c1 - a12 * c0) * inv);
+            res[3][1] = P::round(( a00 * c3 - a01 * c1 + a02 * c0) * inv);
+            res[3][2] = P::round((-a30 * s3 + a31 * s1 - a32 * s0) * inv);
+            res[3][3] = P::round(( a20 * s3 - a21 * s1 + a22 * s0) * inv);
+
+            return res;
+        }
+
+        /**
+         * @brief Calcule l'inverse d'une transformation affine
+         *
+         * La matrice doit etre de la forme [A t ; 0 1] : seule la partie lineaire A
+         * (3x3) est inversee, la translation devient -A^-1 t.
+         * @return La matrice inverse de la matrice courante
+         */
+        Matrix<float, n, m, P> inverse_affine() const
+        {
+            static_assert(n == 4 && m == 4, "Seules les matrices 4x4 representent une transformation affine");
+
+            const float a00 = (*this)(0, 0), a01 = (*this)(0, 1), a02 = (*this)(0, 2);
+            const float a10 = (*this)(1, 0), a11 = (*this)(1, 1), a12 = (*this)(1, 2);
+            const float a20 = (*this)(2, 0), a21 = (*this)(2, 1), a22 = (*this)(2, 2);
+
+            // Comatrice de A
+            const float c00 = a11 * a22 - a12 * a21;
+            const float c01 = a12 * a20 - a10 * a22;
+            const float c02 = a10 * a21 - a11 * a20;
+
+            const float det = a00 * c00 + a01 * c01 + a02 * c02;
+
+            if (det == 0)
+                throw domain_error("Matrix not inversible");
+
+            const float inv = 1 / det;
+            array<array<float, 3>, 3> lin {{
+                {{c00 * inv, (a02 * a21 - a01 * a22) * inv, (a01 * a12 - a02 * a11) * inv}},
+                {{c01 * inv, (a00 * a22 - a02 * a20) * inv, (a02 * a10 - a00 * a12) * inv}},
+                {{c02 * inv, (a01 * a20 - a00 * a21) * inv, (a00 * a11 - a01 * a10) * inv}}
+            }};
+
+            return affine(lin);
+        }
+
+        /**
+         * @brief Calcule l'inverse d'une transformation rigide (rotation et translation)
+         *
+         * La partie lineaire etant orthogonale, son inverse est sa transposee et
+         * la translation devient -R^T t.
+         * @return La matrice inverse de la matrice courante
+         */
+        Matrix<float, n, m, P> inverse_rigid() const
+        {
+            static_assert(n == 4 && m == 4, "Seules les matrices 4x4 representent une transformation rigide");
+
+            array<array<float, 3>, 3> lin {{
+                {{(float) (*this)(0, 0), (float) (*this)(1, 0), (float) (*this)(2, 0)}},
+                {{(float) (*this)(0, 1), (float) (*this)(1, 1), (float) (*this)(2, 1)}},
+                {{(float) (*this)(0, 2), (float) (*this)(1, 2), (float) (*this)(2, 2)}}
+            }};
+
+            return affine(lin);
+        }
+
+        /**
+         * @brief Calcule la transposee de l'inverse de la partie lineaire, utilisee
+         * pour transformer les normales
+         *
+         * La matrice doit representer une transformation affine, la translation
+         * du resultat est nulle.
+         * @return La matrice des normales
+         */
+        Matrix<float, n, m, P> inverse_transpose() const
+        {
+            Matrix<float, n, m, P> inv = inverse_affine();
+            Matrix<float, n, m, P> res;
+
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    res[i][j] = inv[j][i];
+
+            res[3][3] = 1;
+
+            return res;
+        }
+
         /**
          * @brief Calcule la matrice identite de dimension n, m
          * @return La matrice identite de dimension n, m
@@ -204,7 +495,7 @@ namespace math
             {
                 for (int j = 0; j < m; ++j)
                 {
-                    if (isnan(mat[i][j]))
+                    if (isnan(mat[i * m + j]))
                         return true;
                 }
             }
@@ -217,7 +508,7 @@ namespace math
          */
         bool is_ortho() const
         {
-            Matrix<float, n, m> rev;
+            Matrix<float, n, m, P> rev;
             if (n != m)
                 throw "The matrix must be squared to check if it's orthogonal";
 
@@ -230,15 +521,18 @@ namespace math
          * @brief Calcule la transpose de la matrice
          * @return La transpose de la matrice courante
          */
-        Matrix<T, m ,n> transpose() const
+        Matrix<T, m ,n, P> transpose() const
         {
-            Matrix<T, m, n> res;
+            Matrix<T, m, n, P> res;
 
             for (int i = 0; i < m; ++i)
             {
+                MatrixView<const T, n, m> colonne = column(i);
+                MatrixView<T, n, 1> ligne = res.row(i);
+
                 for (int j = 0; j < n; ++j)
                 {
-                    res[i][j] = mat[j][i];
+                    ligne[j] = colonne[j];
                 }
             }
 
@@ -246,42 +540,78 @@ namespace math
         }
 
         /**
-         * @brief Accede à la ligne i de la matrice
-         * @param i l'index de la ligne voulu
-         * @return La i-eme ligne
+         * @brief Accede au stockage contigu de la matrice, ligne par ligne
+         * @return Un pointeur sur le premier coefficient
          */
-        array<T, m> operator[](const int i) const
+        const T *data() const
+        {
+            return mat.data();
+        }
+
+        T *data()
         {
-            return mat[i];
+            return mat.data();
         }
 
         /**
-         * @brief Permet d'obtenir une reference sur la ieme ligne
+         * @brief Vue sur la ligne i de la matrice, sans recopie
          * @param i l'index de la ligne
-         * @return Une reference sur la ieme ligne
+         * @return La vue sur la ligne i
          */
-        array<T, m> &operator[](const int i)
+        MatrixView<const T, m, 1> row(const unsigned int i) const
         {
-            return mat[i];
+            return MatrixView<const T, m, 1>(mat.data() + i * m);
+        }
+
+        MatrixView<T, m, 1> row(const unsigned int i)
+        {
+            return MatrixView<T, m, 1>(mat.data() + i * m);
         }
 
         /**
-         * @brief Additionne deux matrice
-         * @param m2 la matrice a additionner a la matrice courante
-         * @return La matrice resultant de la matrice courante
+         * @brief Vue sur la colonne j de la matrice, sans recopie
+         * @param j l'index de la colonne
+         * @return La vue sur la colonne j
          */
-        Matrix operator+(const Matrix &m2) const
+        MatrixView<const T, n, m> column(const unsigned int j) const
         {
-            Matrix res;
+            return MatrixView<const T, n, m>(mat.data() + j);
+        }
 
-            for (int i = 0; i < n; ++i)
-            {
-                for (int j = 0; j < m; ++j)
-                {
-                    res[i][j] = mat[i][j] + m2[i][j];
-                }
-            }
-            return res;
+        MatrixView<T, n, m> column(const unsigned int j)
+        {
+            return MatrixView<T, n, m>(mat.data() + j);
+        }
+
+        /**
+         * @brief Accède à la ligne i de la matrice
+         * @param i l'index de la ligne voulu
+         * @return La vue sur la i-eme ligne
+         */
+        MatrixView<const T, m, 1> operator[](const int i) const
+        {
+            return row(i);
+        }
+
+        /**
+         * @brief Permet de modifier la ieme ligne
+         * @param i l'index de la ligne
+         * @return Une vue modifiable sur la ieme ligne
+         */
+        MatrixView<T, m, 1> operator[](const int i)
+        {
+            return row(i);
+        }
+
+        /**
+         * @brief Echange deux lignes de la matrice
+         * @param i l'index de la premiere ligne
+         * @param k l'index de la seconde ligne
+         */
+        void swap_rows(const unsigned int i, const unsigned int k)
+        {
+            for (int j = 0; j < m; ++j)
+                swap(mat[i * m + j], mat[k * m + j]);
         }
 
         /**
@@ -294,87 +624,74 @@ namespace math
             {
                 for (int j = 0; j < m; ++j)
                 {
-                    mat[i][j] = a[i][j];
+                    mat[i * m + j] = a[i][j];
                 }
             }
             return *this;
         }
 
         /**
-         * @brief Addition directement une matrice a la matrice courante
-         * @param m2 la matrice a ajouter a la matrice courante
+         * @brief Affecte le resultat d'une expression a la matrice
+         * @param e L'expression a evaluer
          */
-        Matrix &operator+=(const Matrix &m2)
+        template<class E>
+        Matrix &operator=(const MatrixExpr<E, T, n, m> &e)
         {
+            const E &expr = e.self();
+
             for (int i = 0; i < n; ++i)
             {
                 for (int j = 0; j < m; ++j)
                 {
-                    mat[i][j] += m2[i][j];
+                    mat[i * m + j] = expr(i, j);
                 }
             }
+            return *this;
         }
 
         /**
-         * @brief Multiplie un vecteur a la matrice courante
-         * @param v le vecteur a multiplier a la matrice courante
+         * @brief Addition directement une matrice a la matrice courante
+         * @param m2 la matrice a ajouter a la matrice courante
          */
-        Matrix<T, n, 1> operator*(const Vector<T, m> &v) const
+        template<class E>
+        Matrix &operator+=(const MatrixExpr<E, T, n, m> &m2)
         {
-            Matrix<T, n, 1> res;
-             
-            for (int i = 0; i < n; ++i)
-            {
-                res[i][0] = 0;
-                for (int j = 0; j < m; ++j)
-                {
-                    res[i][0] += mat[i][j] * v[j];
-                }
-            }
-            return res;
+            return (*this) = (*this) + m2;
         }
 
         /**
-         * @brief Multiplication de matrice avec un scalaire
-         * @param scalar le scalaire a multiplier a la matrice
-         * @return La matrice resultant de la multiplication
+         * @brief Multiplie un vecteur a la matrice courante
+         * @param v le vecteur a multiplier a la matrice courante
          */
-        Matrix operator*(const float scalar) const
+        Matrix<T, n, 1, P> operator*(const Vector<T, m, P> &v) const
         {
-            Matrix res;
+            Matrix<T, n, 1, P> res;
+            array<T, n> produit;
+
+            simd::MatrixKernel<T, n, m>::mul_vector(mat.data(), v.data(), produit.data());
 
             for (int i = 0; i < n; ++i)
             {
-                for (int j = 0; j < m; ++j)
-                {
-                    res[i][j] = mat[i][j] * scalar;
-                }
+                res[i][0] = produit[i];
             }
-
             return res;
         }
 
         /**
          * @brief Multiplication de deux matrice non identique
+         *
+         * Pour les dimensions jusqu'a 4, le produit est entierement deroule a la
+         * compilation (voir simd::MatrixKernel).
          * @param m2 La matrice a multiplier a la matrice courante
          * @return La matrice resultant de la multiplication
          */
         template<unsigned int o>
-        Matrix<T, n, o> operator*(const Matrix<T, m, o> &m2) const
+        Matrix<T, n, o, P> operator*(const Matrix<T, m, o, P> &m2) const
         {
-            Matrix res;
-            
-            for (int i = 0; i < n; ++i)
-            {
-                for (int j = 0; j < o; ++j)
-                {
-                    for (int k = 0; k < m; ++k)
-                    {
-                       res[i][j] += mat[i][k] * m2[k][o];
-                    }
-                }
-            }
-            
+            Matrix<T, n, o, P> res;
+
+            simd::MatrixKernel<T, n, m>::template mul_matrix<o>(mat.data(), m2.data(), res.data());
+
             return res;
         }
 
@@ -382,15 +699,9 @@ namespace math
          * @brief Multiplie directement la matrice courante a un scalaire
          * @param scalar le scalaire a multiplier a la matrice courante
          */
-        Matrix operator*=(const float scalar)
+        Matrix &operator*=(const float scalar)
         {
-            for (int i = 0; i < n; ++i)
-            {
-                for (int j = 0; j < m; ++j)
-                {
-                    mat[i][j] *= scalar;
-                }
-            }
+            return (*this) = (*this) * scalar;
         }
 
         /**
@@ -404,7 +715,7 @@ namespace math
             {
                 for (int j = 0; j < m; ++j)
                 {
-                    if (mat[i][j] != m2[i][j])
+                    if (mat[i * m + j] != m2[i][j])
                         return false;
                 }
             }
@@ -418,13 +729,13 @@ namespace math
          * @return true si les matrices sont egales, false sinon
          */
         template <class U>
-        bool operator==(const Matrix<U, n, m> &m2) const
+        bool operator==(const Matrix<U, n, m, P> &m2) const
         {
             for (int i = 0; i < n; ++i)
             {
                 for (int j = 0; j < m; ++j)
                 {
-                    if (mat[i][j] != (T) m2[i][j])
+                    if (mat[i * m + j] != (T) m2[i][j])
                         return false;
                 }
             }
@@ -439,8 +750,8 @@ namespace math
      * @param m2 Une matrice
      * @return true si m1=m2, false sinon
      */
-    template <class T, class U, unsigned int n, unsigned int m>
-    bool operator==(const Matrix<T, n, m> &m1, const Matrix<U, n, m> &m2)
+    template <class T, class U, unsigned int n, unsigned int m, class P>
+    bool operator==(const Matrix<T, n, m, P> &m1, const Matrix<U, n, m, P> &m2)
     {
         for (int i = 0; i < n; ++i)
         {
@@ -454,36 +765,54 @@ namespace math
         return true;
     }
 
+    /**
+     * @brief Additionne deux matrices
+     * @param m1 la premiere matrice
+     * @param m2 la matrice a additionner
+     * @return L'expression de l'addition
+     */
+    template<class L, class R, class T, unsigned int n, unsigned int m>
+    MatrixSum<L, R, T, n, m> operator+(const MatrixExpr<L, T, n, m> &m1, const MatrixExpr<R, T, n, m> &m2)
+    {
+        return MatrixSum<L, R, T, n, m>(m1.self(), m2.self());
+    }
+
+    /**
+     * @brief Multiplication de matrice avec un scalaire
+     * @param matrice la matrice a multiplier
+     * @param scalar le scalaire a multiplier a la matrice
+     * @return L'expression de la multiplication
+     */
+    template<class E, class T, unsigned int n, unsigned int m>
+    MatrixScale<E, T, n, m> operator*(const MatrixExpr<E, T, n, m> &matrice, const float scalar)
+    {
+        return MatrixScale<E, T, n, m>(matrice.self(), scalar);
+    }
+
     /**
      * @brief Produit d'une matrice avec un scalaire
      * @param scalar le scalaire a multiplier a la matrice
      * @param matrice La matrice a multiplier
-     * @return la matrice resultant de la multplication
+     * @return L'expression de la multplication
      */
-    template<class T, unsigned int n, unsigned int m>
-    Matrix<T, n, m> &operator*(float scalar, Matrix<T, n, m> &matrice)
+    template<class E, class T, unsigned int n, unsigned int m>
+    MatrixScale<E, T, n, m> operator*(const float scalar, const MatrixExpr<E, T, n, m> &matrice)
     {
-        Matrix<T, n, m> res;
-        
-        for (int i = 0; i < n; ++i)
-        {
-            for (int j = 0; j < m; ++j)
-            {
-                res[i][j] = matrice[i][j] * scalar;
-            }
-        }
-        
-        return res;
+        return MatrixScale<E, T, n, m>(matrice.self(), scalar);
     }
     
-    //
-    template<class T, unsigned int n, unsigned int m>
-    Vector<T, m> operator*(const Vector<T, m>& v, const Matrix<T, n, m>& mat)
+    /**
+     * @brief Produit d'un vecteur ligne avec une matrice
+     * @param v le vecteur ligne
+     * @param mat la matrice
+     * @return le vecteur resultant de la multiplication
+     */
+    template<class T, unsigned int n, unsigned int m, class P>
+    Vector<T, m, P> operator*(const Vector<T, n, P>& v, const Matrix<T, n, m, P>& mat)
     {
-        Vector<T, m> vec;
-        for (int i = 0; i < m; ++i)
-            for (int j = 0; j < n; ++j)
-                vec[i] += v[j] * mat[j][i];
+        Vector<T, m, P> vec;
+
+        simd::MatrixKernel<T, n, m>::vector_mul(v.data(), mat.data(), vec.data());
 
         return vec;
     }
@@ -494,8 +823,8 @@ namespace math
      * @param matrice la matrice a afficher
      * @return le flux pour enchainer les affichages
      */
-    template<class T, unsigned int n, unsigned int m>
-    ostream &operator<<(ostream &out, const Matrix<T, n, m> &matrice)
+    template<class T, unsigned int n, unsigned int m, class P>
+    ostream &operator<<(ostream &out, const Matrix<T, n, m, P> &matrice)
     {
         for (int i = 0; i < n; ++i)
         {
@@ -513,6 +842,9 @@ namespace math
 
     using Mat44r = Matrix<real, 4, 4>;
 
-    static const Matrix<int, 4, 4> Identity4i({{1,0,0,0}, {0,1,0,0}, {0,0,1,0}, {0,0,0,1}});
-    static const Matrix<float, 4, 4> Identity4r({{1,0,0,0}, {0,1,0,0}, {0,0,1,0}, {0,0,0,1}});
+    constexpr Matrix<int, 4, 4> Identity4i(1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1);
+    constexpr Matrix<float, 4, 4> Identity4r(1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1);
+
+    static_assert(std::is_trivially_copyable<Mat44r>::value, "Matrix must be trivially copyable");
+    static_assert(std::is_trivially_copyable<Matrix<int, 4, 4>>::value, "Matrix must be trivially copyable");
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+namespace math
+{
+    /**
+     * @class MatrixView
+     * @brief Vue sur une ligne ou une colonne d'une matrice, sans recopie
+     *
+     * Les composantes de la vue sont espacees de stride elements dans le stockage
+     * de la matrice : 1 pour une ligne, le nombre de colonnes pour une colonne.
+     * T est qualifie const pour une vue en lecture seule. Une vue ne doit pas
+     * survivre a la matrice qu'elle reference.
+     */
+    template<class T, unsigned int length, unsigned int stride>
+    class MatrixView
+    {
+    private:
+        T *first; /**< Premiere composante de la vue */
+    public:
+        typedef typename std::remove_const<T>::type value_type;
+
+        /**
+         * @brief Construit une vue a partir de sa premiere composante
+         * @param first L'adresse de la premiere composante
+         */
+        explicit MatrixView(T *first) : first(first) {}
+
+        /**
+         * @brief Convertit une vue modifiable en vue en lecture seule
+         * @param v La vue a convertir
+         */
+        template<class U, class = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        MatrixView(const MatrixView<U, length, stride> &v) : first(v.data()) {}
+
+        /**
+         * @brief Accede a la composante i de la vue
+         * @param i L'index de la composante
+         * @return Une reference sur la composante i
+         */
+        T &operator[](const unsigned int i) const
+        {
+            return first[i * stride];
+        }
+
+        /**
+         * @brief Nombre de composantes de la vue
+         */
+        static constexpr unsigned int size()
+        {
+            return length;
+        }
+
+        /**
+         * @brief Accede a la premiere composante, les suivantes etant espacees de stride
+         * @return L'adresse de la premiere composante
+         */
+        T *data() const
+        {
+            return first;
+        }
+
+        /**
+         * @brief Recopie la vue dans un tableau
+         * @return Le tableau contenant les composantes de la vue
+         */
+        operator std::array<value_type, length>() const
+        {
+            std::array<value_type, length> copie;
+
+            for (unsigned int i = 0; i < length; ++i)
+                copie[i] = first[i * stride];
+
+            return copie;
+        }
+    };
+}
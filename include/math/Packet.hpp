@@ -0,0 +1,595 @@
+#pragma once
+
+#include "math/Simd.hpp"
+#include "math/Vector.hpp"
+#include "math/Matrix.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @namespace math
+ *
+ * Paquets de W valeurs traitees ensemble (SIMD entre elements) : un paquet de
+ * Vec3 contient W vecteurs ranges coordonnee par coordonnee, de sorte qu'une
+ * operation traite W objets a la fois. Le gabarit generique est une boucle
+ * scalaire ; avec SSE, Packet<float, 4> tient dans un registre et
+ * Packet<float, 8> dans deux.
+ */
+namespace math
+{
+    /**
+     * @class Mask
+     * @brief Resultat d'une comparaison de paquets, un booleen par voie
+     *
+     * La voie i correspond au bit i de bits().
+     */
+    template<class T, unsigned int W>
+    class Mask
+    {
+        static_assert(W > 0 && W <= 32, "A mask holds at most 32 lanes");
+    private:
+        unsigned int lanes; /**< Un bit par voie */
+    public:
+        static constexpr unsigned int full = W == 32 ? ~0u : (1u << W) - 1; /**< Toutes les voies actives */
+
+        constexpr Mask() : lanes(0)
+        {
+        }
+
+        /**
+         * @brief Construit un masque a partir de ses bits, la voie i etant le bit i
+         */
+        explicit constexpr Mask(const unsigned int bits) : lanes(bits & full)
+        {
+        }
+
+        unsigned int bits() const { return lanes; }
+        bool operator[](const unsigned int i) const { return (lanes >> i) & 1; }
+        bool any() const { return lanes != 0; }
+        bool all() const { return lanes == full; }
+        bool none() const { return lanes == 0; }
+
+        friend Mask operator&(const Mask &a, const Mask &b) { return Mask(a.lanes & b.lanes); }
+        friend Mask operator|(const Mask &a, const Mask &b) { return Mask(a.lanes | b.lanes); }
+        friend Mask operator^(const Mask &a, const Mask &b) { return Mask(a.lanes ^ b.lanes); }
+        friend Mask operator~(const Mask &a) { return Mask(~a.lanes); }
+    };
+
+    /**
+     * @class Packet
+     * @brief W valeurs de type T traitees voie par voie
+     *
+     * Un scalaire se convertit implicitement en paquet dont toutes les voies
+     * valent ce scalaire. load et store demandent une adresse alignee sur
+     * alignment octets, loadu et storeu non.
+     */
+    template<class T, unsigned int W>
+    class Packet
+    {
+    private:
+        std::array<T, W> v; /**< Les voies */
+
+        template<class F>
+        static Packet map(const Packet &a, const Packet &b, F f)
+        {
+            Packet r;
+            for (unsigned int i = 0; i < W; ++i)
+                r.v[i] = f(a.v[i], b.v[i]);
+            return r;
+        }
+
+        template<class F>
+        static Mask<T, W> compare(const Packet &a, const Packet &b, F f)
+        {
+            unsigned int bits = 0;
+            for (unsigned int i = 0; i < W; ++i)
+                bits |= unsigned(f(a.v[i], b.v[i])) << i;
+            return Mask<T, W>(bits);
+        }
+
+    public:
+        typedef T value_type;
+        typedef Mask<T, W> mask;
+        static constexpr unsigned int width = W; /**< Nombre de voies */
+        static constexpr std::size_t alignment = alignof(T); /**< Alignement requis par load et store */
+
+        Packet() : v()
+        {
+        }
+
+        /**
+         * @brief Diffuse un scalaire dans toutes les voies
+         */
+        Packet(const T s)
+        {
+            v.fill(s);
+        }
+
+        static Packet load(const T *p)
+        {
+            return loadu(p);
+        }
+
+        static Packet loadu(const T *p)
+        {
+            Packet r;
+            for (unsigned int i = 0; i < W; ++i)
+                r.v[i] = p[i];
+            return r;
+        }
+
+        void store(T *p) const
+        {
+            storeu(p);
+        }
+
+        void storeu(T *p) const
+        {
+            for (unsigned int i = 0; i < W; ++i)
+                p[i] = v[i];
+        }
+
+        /**
+         * @brief Lit la voie i
+         */
+        T operator[](const unsigned int i) const
+        {
+            return v[i];
+        }
+
+        friend Packet operator+(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return x + y; }); }
+        friend Packet operator-(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return x - y; }); }
+        friend Packet operator*(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return x * y; }); }
+        friend Packet operator/(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return x / y; }); }
+        friend Packet operator-(const Packet &a) { return Packet() - a; }
+        friend Packet min(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return y < x ? y : x; }); }
+        friend Packet max(const Packet &a, const Packet &b) { return map(a, b, [](const T x, const T y) { return x < y ? y : x; }); }
+        friend Packet abs(const Packet &a) { return map(a, a, [](const T x, const T) { return x < T() ? -x : x; }); }
+        friend Packet sqrt(const Packet &a) { return map(a, a, [](const T x, const T) { return T(std::sqrt(x)); }); }
+
+        /**
+         * @brief Calcule a * b + c voie par voie
+         */
+        friend Packet madd(const Packet &a, const Packet &b, const Packet &c) { return a * b + c; }
+
+        friend Mask<T, W> operator<(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x < y; }); }
+        friend Mask<T, W> operator<=(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x <= y; }); }
+        friend Mask<T, W> operator>(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x > y; }); }
+        friend Mask<T, W> operator>=(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x >= y; }); }
+        friend Mask<T, W> operator==(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x == y; }); }
+        friend Mask<T, W> operator!=(const Packet &a, const Packet &b) { return compare(a, b, [](const T x, const T y) { return x != y; }); }
+
+        /**
+         * @brief Choisit voie par voie a la ou le masque est vrai, b ailleurs
+         */
+        friend Packet select(const Mask<T, W> &m, const Packet &a, const Packet &b)
+        {
+            Packet r;
+            for (unsigned int i = 0; i < W; ++i)
+                r.v[i] = m[i] ? a.v[i] : b.v[i];
+            return r;
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Masque de quatre voies SSE : chaque voie vaut tous les bits a 1 ou a 0
+     */
+    template<>
+    class Mask<float, 4>
+    {
+    private:
+        __m128 m;
+    public:
+        static constexpr unsigned int full = 0xf;
+
+        Mask() : m(_mm_setzero_ps())
+        {
+        }
+
+        explicit Mask(const __m128 m) : m(m)
+        {
+        }
+
+        explicit Mask(const unsigned int bits) :
+            m(_mm_castsi128_ps(_mm_set_epi32(-int((bits >> 3) & 1), -int((bits >> 2) & 1), -int((bits >> 1) & 1), -int(bits & 1))))
+        {
+        }
+
+        __m128 native() const { return m; }
+        unsigned int bits() const { return unsigned(_mm_movemask_ps(m)); }
+        bool operator[](const unsigned int i) const { return (bits() >> i) & 1; }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == full; }
+        bool none() const { return bits() == 0; }
+
+        friend Mask operator&(const Mask &a, const Mask &b) { return Mask(_mm_and_ps(a.m, b.m)); }
+        friend Mask operator|(const Mask &a, const Mask &b) { return Mask(_mm_or_ps(a.m, b.m)); }
+        friend Mask operator^(const Mask &a, const Mask &b) { return Mask(_mm_xor_ps(a.m, b.m)); }
+        friend Mask operator~(const Mask &a) { return Mask(_mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1)))); }
+    };
+
+    /**
+     * @brief Paquet de quatre float dans un registre SSE
+     */
+    template<>
+    class Packet<float, 4>
+    {
+    private:
+        __m128 v;
+    public:
+        typedef float value_type;
+        typedef Mask<float, 4> mask;
+        static constexpr unsigned int width = 4;
+        static constexpr std::size_t alignment = 16;
+
+        Packet() : v(_mm_setzero_ps())
+        {
+        }
+
+        Packet(const float s) : v(_mm_set1_ps(s))
+        {
+        }
+
+        explicit Packet(const __m128 v) : v(v)
+        {
+        }
+
+        __m128 native() const { return v; }
+
+        static Packet load(const float *p) { return Packet(_mm_load_ps(p)); }
+        static Packet loadu(const float *p) { return Packet(_mm_loadu_ps(p)); }
+        void store(float *p) const { _mm_store_ps(p, v); }
+        void storeu(float *p) const { _mm_storeu_ps(p, v); }
+
+        float operator[](const unsigned int i) const
+        {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, v);
+            return lanes[i];
+        }
+
+        friend Packet operator+(const Packet &a, const Packet &b) { return Packet(_mm_add_ps(a.v, b.v)); }
+        friend Packet operator-(const Packet &a, const Packet &b) { return Packet(_mm_sub_ps(a.v, b.v)); }
+        friend Packet operator*(const Packet &a, const Packet &b) { return Packet(_mm_mul_ps(a.v, b.v)); }
+        friend Packet operator/(const Packet &a, const Packet &b) { return Packet(_mm_div_ps(a.v, b.v)); }
+        friend Packet operator-(const Packet &a) { return Packet(_mm_xor_ps(a.v, _mm_set1_ps(-0.f))); }
+        friend Packet min(const Packet &a, const Packet &b) { return Packet(_mm_min_ps(a.v, b.v)); }
+        friend Packet max(const Packet &a, const Packet &b) { return Packet(_mm_max_ps(a.v, b.v)); }
+        friend Packet abs(const Packet &a) { return Packet(_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)); }
+        friend Packet sqrt(const Packet &a) { return Packet(_mm_sqrt_ps(a.v)); }
+        friend Packet madd(const Packet &a, const Packet &b, const Packet &c) { return Packet(_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)); }
+
+        friend Mask<float, 4> operator<(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmplt_ps(a.v, b.v)); }
+        friend Mask<float, 4> operator<=(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmple_ps(a.v, b.v)); }
+        friend Mask<float, 4> operator>(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmpgt_ps(a.v, b.v)); }
+        friend Mask<float, 4> operator>=(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmpge_ps(a.v, b.v)); }
+        friend Mask<float, 4> operator==(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmpeq_ps(a.v, b.v)); }
+        friend Mask<float, 4> operator!=(const Packet &a, const Packet &b) { return Mask<float, 4>(_mm_cmpneq_ps(a.v, b.v)); }
+
+        friend Packet select(const Mask<float, 4> &m, const Packet &a, const Packet &b)
+        {
+            return Packet(_mm_or_ps(_mm_and_ps(m.native(), a.v), _mm_andnot_ps(m.native(), b.v)));
+        }
+    };
+
+    /**
+     * @brief Masque de huit voies, forme de deux masques SSE
+     */
+    template<>
+    class Mask<float, 8>
+    {
+    private:
+        Mask<float, 4> lo, hi;
+    public:
+        static constexpr unsigned int full = 0xff;
+
+        Mask()
+        {
+        }
+
+        Mask(const Mask<float, 4> &lo, const Mask<float, 4> &hi) : lo(lo), hi(hi)
+        {
+        }
+
+        explicit Mask(const unsigned int bits) : lo(bits & 0xf), hi((bits >> 4) & 0xf)
+        {
+        }
+
+        const Mask<float, 4> &low() const { return lo; }
+        const Mask<float, 4> &high() const { return hi; }
+        unsigned int bits() const { return lo.bits() | (hi.bits() << 4); }
+        bool operator[](const unsigned int i) const { return (bits() >> i) & 1; }
+        bool any() const { return bits() != 0; }
+        bool all() const { return bits() == full; }
+        bool none() const { return bits() == 0; }
+
+        friend Mask operator&(const Mask &a, const Mask &b) { return Mask(a.lo & b.lo, a.hi & b.hi); }
+        friend Mask operator|(const Mask &a, const Mask &b) { return Mask(a.lo | b.lo, a.hi | b.hi); }
+        friend Mask operator^(const Mask &a, const Mask &b) { return Mask(a.lo ^ b.lo, a.hi ^ b.hi); }
+        friend Mask operator~(const Mask &a) { return Mask(~a.lo, ~a.hi); }
+    };
+
+    /**
+     * @brief Paquet de huit float dans deux registres SSE
+     */
+    template<>
+    class Packet<float, 8>
+    {
+    private:
+        Packet<float, 4> lo, hi;
+    public:
+        typedef float value_type;
+        typedef Mask<float, 8> mask;
+        static constexpr unsigned int width = 8;
+        static constexpr std::size_t alignment = 16;
+
+        Packet()
+        {
+        }
+
+        Packet(const float s) : lo(s), hi(s)
+        {
+        }
+
+        Packet(const Packet<float, 4> &lo, const Packet<float, 4> &hi) : lo(lo), hi(hi)
+        {
+        }
+
+        const Packet<float, 4> &low() const { return lo; }
+        const Packet<float, 4> &high() const { return hi; }
+
+        static Packet load(const float *p) { return Packet(Packet<float, 4>::load(p), Packet<float, 4>::load(p + 4)); }
+        static Packet loadu(const float *p) { return Packet(Packet<float, 4>::loadu(p), Packet<float, 4>::loadu(p + 4)); }
+        void store(float *p) const { lo.store(p); hi.store(p + 4); }
+        void storeu(float *p) const { lo.storeu(p); hi.storeu(p + 4); }
+
+        float operator[](const unsigned int i) const
+        {
+            return i < 4 ? lo[i] : hi[i - 4];
+        }
+
+        friend Packet operator+(const Packet &a, const Packet &b) { return Packet(a.lo + b.lo, a.hi + b.hi); }
+        friend Packet operator-(const Packet &a, const Packet &b) { return Packet(a.lo - b.lo, a.hi - b.hi); }
+        friend Packet operator*(const Packet &a, const Packet &b) { return Packet(a.lo * b.lo, a.hi * b.hi); }
+        friend Packet operator/(const Packet &a, const Packet &b) { return Packet(a.lo / b.lo, a.hi / b.hi); }
+        friend Packet operator-(const Packet &a) { return Packet(-a.lo, -a.hi); }
+        friend Packet min(const Packet &a, const Packet &b) { return Packet(min(a.lo, b.lo), min(a.hi, b.hi)); }
+        friend Packet max(const Packet &a, const Packet &b) { return Packet(max(a.lo, b.lo), max(a.hi, b.hi)); }
+        friend Packet abs(const Packet &a) { return Packet(abs(a.lo), abs(a.hi)); }
+        friend Packet sqrt(const Packet &a) { return Packet(sqrt(a.lo), sqrt(a.hi)); }
+        friend Packet madd(const Packet &a, const Packet &b, const Packet &c) { return Packet(madd(a.lo, b.lo, c.lo), madd(a.hi, b.hi, c.hi)); }
+
+        friend Mask<float, 8> operator<(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo < b.lo, a.hi < b.hi); }
+        friend Mask<float, 8> operator<=(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo <= b.lo, a.hi <= b.hi); }
+        friend Mask<float, 8> operator>(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo > b.lo, a.hi > b.hi); }
+        friend Mask<float, 8> operator>=(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo >= b.lo, a.hi >= b.hi); }
+        friend Mask<float, 8> operator==(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo == b.lo, a.hi == b.hi); }
+        friend Mask<float, 8> operator!=(const Packet &a, const Packet &b) { return Mask<float, 8>(a.lo != b.lo, a.hi != b.hi); }
+
+        friend Packet select(const Mask<float, 8> &m, const Packet &a, const Packet &b)
+        {
+            return Packet(select(m.low(), a.lo, b.lo), select(m.high(), a.hi, b.hi));
+        }
+    };
+#endif
+
+    /**
+     * @class Vec3Packet
+     * @brief W vecteurs de dimension 3 ranges coordonnee par coordonnee
+     */
+    template<class T, unsigned int W>
+    class Vec3Packet
+    {
+    public:
+        typedef Packet<T, W> packet;
+
+        packet x; /**< Abscisses des W vecteurs */
+        packet y; /**< Ordonnees des W vecteurs */
+        packet z; /**< Cotes des W vecteurs */
+
+        Vec3Packet()
+        {
+        }
+
+        Vec3Packet(const packet &x, const packet &y, const packet &z) : x(x), y(y), z(z)
+        {
+        }
+
+        /**
+         * @brief Diffuse un vecteur dans toutes les voies
+         */
+        template<class P>
+        explicit Vec3Packet(const Vector<T, 3, P> &v) : x(v[0]), y(v[1]), z(v[2])
+        {
+        }
+
+        /**
+         * @brief Charge W vecteurs stockes coordonnee par coordonnee (par exemple un VertexStream)
+         * @param px, py, pz Les coordonnees, alignees sur packet::alignment octets
+         */
+        static Vec3Packet load(const T *px, const T *py, const T *pz)
+        {
+            return Vec3Packet(packet::load(px), packet::load(py), packet::load(pz));
+        }
+
+        /**
+         * @brief Rassemble W vecteurs consecutifs d'un tableau de Vector ou de Point
+         * @param v Le premier vecteur
+         */
+        template<class V>
+        static Vec3Packet gather(const V *v)
+        {
+            alignas(64) T px[W], py[W], pz[W];
+
+            for (unsigned int i = 0; i < W; ++i)
+            {
+                px[i] = v[i][0];
+                py[i] = v[i][1];
+                pz[i] = v[i][2];
+            }
+
+            return Vec3Packet(packet::loadu(px), packet::loadu(py), packet::loadu(pz));
+        }
+
+        /**
+         * @brief Ecrit les W vecteurs coordonnee par coordonnee
+         * @param px, py, pz Les coordonnees, alignees sur packet::alignment octets
+         */
+        void store(T *px, T *py, T *pz) const
+        {
+            x.store(px);
+            y.store(py);
+            z.store(pz);
+        }
+
+        /**
+         * @brief Extrait le vecteur de la voie i
+         */
+        Vector<T, 3> operator[](const unsigned int i) const
+        {
+            return Vector<T, 3>(x[i], y[i], z[i]);
+        }
+
+        friend Vec3Packet operator+(const Vec3Packet &a, const Vec3Packet &b) { return Vec3Packet(a.x + b.x, a.y + b.y, a.z + b.z); }
+        friend Vec3Packet operator-(const Vec3Packet &a, const Vec3Packet &b) { return Vec3Packet(a.x - b.x, a.y - b.y, a.z - b.z); }
+        friend Vec3Packet operator-(const Vec3Packet &a) { return Vec3Packet(-a.x, -a.y, -a.z); }
+        friend Vec3Packet operator*(const Vec3Packet &a, const packet &s) { return Vec3Packet(a.x * s, a.y * s, a.z * s); }
+        friend Vec3Packet operator*(const packet &s, const Vec3Packet &a) { return a * s; }
+
+        friend packet dot(const Vec3Packet &a, const Vec3Packet &b) { return madd(a.x, b.x, madd(a.y, b.y, a.z * b.z)); }
+
+        friend Vec3Packet cross(const Vec3Packet &a, const Vec3Packet &b)
+        {
+            return Vec3Packet(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+        }
+
+        friend Vec3Packet min(const Vec3Packet &a, const Vec3Packet &b) { return Vec3Packet(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z)); }
+        friend Vec3Packet max(const Vec3Packet &a, const Vec3Packet &b) { return Vec3Packet(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z)); }
+
+        friend Vec3Packet select(const Mask<T, W> &m, const Vec3Packet &a, const Vec3Packet &b)
+        {
+            return Vec3Packet(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z));
+        }
+    };
+
+    /**
+     * @class PlanePacket
+     * @brief W plans d'equation n . p + d = 0, ou un meme plan diffuse dans toutes les voies
+     *
+     * La distance signee suit la convention de geometry::Plane::positionFrom :
+     * negative derriere le plan.
+     */
+    template<class T, unsigned int W>
+    class PlanePacket
+    {
+    public:
+        typedef Packet<T, W> packet;
+
+        Vec3Packet<T, W> normal; /**< Normales unitaires */
+        packet d; /**< Termes constants des equations */
+
+        PlanePacket()
+        {
+        }
+
+        PlanePacket(const Vec3Packet<T, W> &normal, const packet &d) : normal(normal), d(d)
+        {
+        }
+
+        /**
+         * @brief Diffuse l'equation (a, b, c, d) d'un plan dans toutes les voies
+         */
+        template<class P>
+        explicit PlanePacket(const Vector<T, 4, P> &equation) :
+            normal(packet(equation[0]), packet(equation[1]), packet(equation[2])), d(equation[3])
+        {
+        }
+
+        /**
+         * @brief Rassemble W equations (a, b, c, d) consecutives
+         */
+        template<class V>
+        static PlanePacket gather(const V *equations)
+        {
+            alignas(64) T pd[W];
+
+            for (unsigned int i = 0; i < W; ++i)
+                pd[i] = equations[i][3];
+
+            return PlanePacket(Vec3Packet<T, W>::gather(equations), packet::loadu(pd));
+        }
+
+        /**
+         * @brief Distance signee de W points aux plans
+         */
+        packet distance(const Vec3Packet<T, W> &p) const
+        {
+            return madd(normal.x, p.x, madd(normal.y, p.y, madd(normal.z, p.z, d)));
+        }
+
+        /**
+         * @brief Indique, voie par voie, si une sphere est entierement derriere le plan
+         * @param center Les centres des spheres
+         * @param radius Les rayons des spheres
+         */
+        Mask<T, W> behind(const Vec3Packet<T, W> &center, const packet &radius) const
+        {
+            return distance(center) < -radius;
+        }
+    };
+
+    /**
+     * @class Mat44Packet
+     * @brief Matrice 4x4 dont chaque coefficient utile est diffuse sur W voies,
+     * pour transformer W points a la fois
+     *
+     * Comme Transformation, les points sont des vecteurs lignes : p' = (p, 1) * M.
+     */
+    template<class T, unsigned int W>
+    class Mat44Packet
+    {
+    public:
+        typedef Packet<T, W> packet;
+
+    private:
+        packet m[4][3]; /**< Les trois premieres colonnes de la matrice */
+
+    public:
+        template<class P>
+        explicit Mat44Packet(const Matrix<T, 4, 4, P> &mat)
+        {
+            for (unsigned int i = 0; i < 4; ++i)
+                for (unsigned int j = 0; j < 3; ++j)
+                    m[i][j] = packet(mat(i, j));
+        }
+
+        /**
+         * @brief Transforme W points
+         */
+        Vec3Packet<T, W> point(const Vec3Packet<T, W> &p) const
+        {
+            return Vec3Packet<T, W>(madd(p.x, m[0][0], madd(p.y, m[1][0], madd(p.z, m[2][0], m[3][0]))),
+                                    madd(p.x, m[0][1], madd(p.y, m[1][1], madd(p.z, m[2][1], m[3][1]))),
+                                    madd(p.x, m[0][2], madd(p.y, m[1][2], madd(p.z, m[2][2], m[3][2]))));
+        }
+
+        /**
+         * @brief Transforme W directions, sans la translation
+         */
+        Vec3Packet<T, W> direction(const Vec3Packet<T, W> &d) const
+        {
+            return Vec3Packet<T, W>(madd(d.x, m[0][0], madd(d.y, m[1][0], d.z * m[2][0])),
+                                    madd(d.x, m[0][1], madd(d.y, m[1][1], d.z * m[2][1])),
+                                    madd(d.x, m[0][2], madd(d.y, m[1][2], d.z * m[2][2])));
+        }
+    };
+
+    using Vec3x4 = Vec3Packet<real, 4>;
+    using Vec3x8 = Vec3Packet<real, 8>;
+
+    static_assert(std::is_trivially_copyable<Vec3x8>::value, "Vec3x8 must be trivially copyable");
+}
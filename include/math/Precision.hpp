@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "math/Simd.hpp"
+
+/**
+ * @namespace math
+ *
+ * Politiques de precision utilisees par Vector et Matrix. Une politique
+ * decide si le resultat des operations arithmetiques est arrondi.
+ */
+namespace math
+{
+    /**
+     * @class Exact
+     * @brief Aucun arrondi : les resultats sont ceux de l'arithmetique flottante
+     *
+     * Politique par defaut, utilisee pour le rendu.
+     */
+    struct Exact
+    {
+        /**
+         * @brief Arrondit une valeur
+         * @param x La valeur a arrondir
+         * @return La valeur inchangee
+         */
+        template<class T>
+        static T round(const T x)
+        {
+            return x;
+        }
+
+        /**
+         * @brief Arrondit toutes les composantes d'un registre
+         * @param p Le registre a arrondir
+         * @return Le registre inchange
+         */
+        template<class T, unsigned int size>
+        static typename simd::Kernel<T, size>::packet round_packet(const typename simd::Kernel<T, size>::packet &p)
+        {
+            return p;
+        }
+    };
+
+    /**
+     * @class RoundTo2Decimals
+     * @brief Les resultats sont arrondis au centieme
+     *
+     * Reproduit le comportement historique de la bibliotheque, sur lequel
+     * reposent les tests qui comparent des valeurs exactes.
+     */
+    struct RoundTo2Decimals
+    {
+        template<class T>
+        static T round(const T x)
+        {
+            return std::round(x * 100) / 100;
+        }
+
+        template<class T, unsigned int size>
+        static typename simd::Kernel<T, size>::packet round_packet(const typename simd::Kernel<T, size>::packet &p)
+        {
+            alignas(simd::Traits<T, size>::alignment) std::array<T, simd::Traits<T, size>::length> composantes;
+
+            simd::Kernel<T, size>::store(composantes.data(), p);
+
+            for (unsigned int i = 0; i < size; ++i)
+                composantes[i] = round(composantes[i]);
+
+            return simd::Kernel<T, size>::load(composantes.data());
+        }
+    };
+}
@@ -0,0 +1,1167 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) && !defined(MATH_NO_SIMD)
+#include <emmintrin.h>
+#define MATH_SIMD_SSE 1 /**< Les noyaux SSE sont disponibles */
+#endif
+
+#if defined(__GNUC__)
+#define MATH_FORCE_INLINE inline __attribute__((always_inline)) /**< Force l'expansion des recursions deroulees */
+#elif defined(_MSC_VER)
+#define MATH_FORCE_INLINE __forceinline
+#else
+#define MATH_FORCE_INLINE inline
+#endif
+
+/**
+ * @namespace math::simd
+ *
+ * Noyaux de calcul utilises par Vector et Matrix. Le gabarit generique est
+ * une boucle scalaire, les specialisations float de dimension 3 et 4
+ * utilisent les registres SSE. Definir MATH_NO_SIMD force les boucles scalaires.
+ */
+namespace math
+{
+namespace simd
+{
+    /**
+     * @brief Caracteristiques de stockage d'un vecteur de dimension size
+     *
+     * Par defaut un vecteur est stocke sur size composantes avec l'alignement de T.
+     */
+    template<class T, unsigned int size>
+    struct Traits
+    {
+        static constexpr unsigned int length = size; /**< Nombre de composantes stockees */
+        static constexpr std::size_t alignment = alignof(T); /**< Alignement du stockage */
+        static constexpr bool vectorized = false; /**< Indique si les calculs passent par les registres SIMD */
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Vec3r est complete a quatre composantes (la derniere toujours nulle)
+     * pour tenir dans un registre SSE
+     */
+    template<>
+    struct Traits<float, 3>
+    {
+        static constexpr unsigned int length = 4;
+        static constexpr std::size_t alignment = 16;
+        static constexpr bool vectorized = true;
+    };
+
+    template<>
+    struct Traits<float, 4>
+    {
+        static constexpr unsigned int length = 4;
+        static constexpr std::size_t alignment = 16;
+        static constexpr bool vectorized = true;
+    };
+#endif
+
+    /**
+     * @class Kernel
+     * @brief Operations composante par composante sur le stockage d'un vecteur
+     *
+     * Version scalaire, utilisee pour tous les types non vectorises.
+     */
+    template<class T, unsigned int size, bool = Traits<T, size>::vectorized>
+    struct Kernel
+    {
+        typedef std::array<T, Traits<T, size>::length> packet;
+
+        static packet load(const T *p)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = p[i];
+            return r;
+        }
+
+        static void store(T *p, const packet &a)
+        {
+            for (unsigned int i = 0; i < a.size(); ++i)
+                p[i] = a[i];
+        }
+
+        static packet add(const packet &a, const packet &b)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = a[i] + b[i];
+            return r;
+        }
+
+        static packet sub(const packet &a, const packet &b)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = a[i] - b[i];
+            return r;
+        }
+
+        static packet neg(const packet &a)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = -a[i];
+            return r;
+        }
+
+        static packet mul(const packet &a, const packet &b)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = a[i] * b[i];
+            return r;
+        }
+
+        static packet scale(const packet &a, const T scalar)
+        {
+            packet r;
+            for (unsigned int i = 0; i < r.size(); ++i)
+                r[i] = a[i] * scalar;
+            return r;
+        }
+
+        /**
+         * @brief Somme des size premieres composantes, dans l'ordre
+         */
+        static T sum(const packet &a)
+        {
+            T somme = T();
+            for (unsigned int i = 0; i < size; ++i)
+                somme += a[i];
+            return somme;
+        }
+
+        static T dot(const packet &a, const packet &b)
+        {
+            return sum(mul(a, b));
+        }
+
+        /**
+         * @brief Produit vectoriel sur les trois premieres composantes, les autres sont nulles
+         */
+        static packet cross(const packet &a, const packet &b)
+        {
+            packet r;
+            r.fill(T());
+            r[0] = (a[1] * b[2]) - (a[2] * b[1]);
+            r[1] = (a[2] * b[0]) - (a[0] * b[2]);
+            r[2] = (a[0] * b[1]) - (a[1] * b[0]);
+            return r;
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE pour Vec3r et Vec4r
+     */
+    template<unsigned int size>
+    struct Kernel<float, size, true>
+    {
+        typedef __m128 packet;
+
+        static packet load(const float *p)
+        {
+            return _mm_load_ps(p);
+        }
+
+        static void store(float *p, const packet a)
+        {
+            _mm_store_ps(p, a);
+        }
+
+        static packet add(const packet a, const packet b)
+        {
+            return _mm_add_ps(a, b);
+        }
+
+        static packet sub(const packet a, const packet b)
+        {
+            return _mm_sub_ps(a, b);
+        }
+
+        static packet neg(const packet a)
+        {
+            return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+        }
+
+        static packet mul(const packet a, const packet b)
+        {
+            return _mm_mul_ps(a, b);
+        }
+
+        static packet scale(const packet a, const float scalar)
+        {
+            return _mm_mul_ps(a, _mm_set1_ps(scalar));
+        }
+
+        /**
+         * @brief Somme horizontale, dans le meme ordre que la boucle scalaire
+         */
+        static float sum(const packet a)
+        {
+            __m128 s = _mm_add_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+            s = _mm_add_ss(s, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)));
+            if (size == 4)
+                s = _mm_add_ss(s, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)));
+            return _mm_cvtss_f32(s);
+        }
+
+        static float dot(const packet a, const packet b)
+        {
+            return sum(_mm_mul_ps(a, b));
+        }
+
+        static packet cross(const packet a, const packet b)
+        {
+            const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m128 b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+            const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+            return _mm_and_ps(_mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx)), xyz);
+        }
+    };
+#endif
+
+    /**
+     * @brief Dimension maximale deroulee a la compilation par les produits matriciels
+     */
+    constexpr unsigned int max_unrolled = 4;
+
+    /**
+     * @class Dot
+     * @brief Produit scalaire de longueur length deroule a la compilation :
+     * acc + a[0] * b[0] + a[1] * b[stride] + ..., somme de gauche a droite
+     * comme la boucle equivalente
+     */
+    template<class T, unsigned int length, unsigned int stride, unsigned int k = 0>
+    struct Dot
+    {
+        static MATH_FORCE_INLINE T run(const T acc, const T *a, const T *b)
+        {
+            return Dot<T, length, stride, k + 1>::run(acc + a[k] * b[k * stride], a, b);
+        }
+    };
+
+    template<class T, unsigned int length, unsigned int stride>
+    struct Dot<T, length, stride, length>
+    {
+        static MATH_FORCE_INLINE T run(const T acc, const T *, const T *)
+        {
+            return acc;
+        }
+    };
+
+    /**
+     * @class Product
+     * @brief Coefficients idx a count - 1 du produit d'une matrice n x m par une
+     * matrice m x o, deroules a la compilation ; res[i][j] est le produit scalaire
+     * de la ligne i de a et de la colonne j de b
+     */
+    template<class T, unsigned int n, unsigned int m, unsigned int o, unsigned int idx = 0, unsigned int count = n * o>
+    struct Product
+    {
+        static MATH_FORCE_INLINE void run(const T *a, const T *b, T *res)
+        {
+            const T *row = a + (idx / o) * m, *col = b + idx % o;
+
+            // Le premier terme initialise la somme : 0 + x ne se simplifie pas en flottant
+            res[idx] = Dot<T, m, o, 1>::run(row[0] * col[0], row, col);
+            Product<T, n, m, o, idx + 1, count>::run(a, b, res);
+        }
+    };
+
+    template<class T, unsigned int n, unsigned int m, unsigned int o, unsigned int count>
+    struct Product<T, n, m, o, count, count>
+    {
+        static MATH_FORCE_INLINE void run(const T *, const T *, T *)
+        {
+        }
+    };
+
+    /**
+     * @class MatrixKernel
+     * @brief Produits matrice/vecteur sur le stockage contigu d'une matrice n x m,
+     * ligne par ligne
+     *
+     * Jusqu'a max_unrolled lignes et colonnes, les produits sont entierement
+     * deroules a la compilation ; au-dela ce sont des boucles.
+     */
+    template<class T, unsigned int n, unsigned int m, bool = (n == 4 && m == 4 && Traits<T, 4>::vectorized),
+             bool = (n <= max_unrolled && m <= max_unrolled)>
+    struct MatrixKernel
+    {
+        /**
+         * @brief res[i] = somme des mat[i][j] * v[j]
+         */
+        static void mul_vector(const T *mat, const T *v, T *res)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                res[i] = 0;
+                for (unsigned int j = 0; j < m; ++j)
+                    res[i] += mat[i * m + j] * v[j];
+            }
+        }
+
+        /**
+         * @brief res[i] = somme des v[j] * mat[j][i]
+         */
+        static void vector_mul(const T *v, const T *mat, T *res)
+        {
+            for (unsigned int i = 0; i < m; ++i)
+            {
+                res[i] = T();
+                for (unsigned int j = 0; j < n; ++j)
+                    res[i] += v[j] * mat[j * m + i];
+            }
+        }
+
+        /**
+         * @brief res = a * b, b etant une matrice m x o
+         */
+        template<unsigned int o>
+        static void mul_matrix(const T *a, const T *b, T *res)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+                MatrixKernel<T, m, o>::vector_mul(a + i * m, b, res + i * o);
+        }
+    };
+
+    /**
+     * @brief Version deroulee pour les petites matrices
+     */
+    template<class T, unsigned int n, unsigned int m>
+    struct MatrixKernel<T, n, m, false, true>
+    {
+        static void mul_vector(const T *mat, const T *v, T *res)
+        {
+            // Un vecteur colonne est une matrice m x 1
+            Product<T, n, m, 1>::run(mat, v, res);
+        }
+
+        static void vector_mul(const T *v, const T *mat, T *res)
+        {
+            // Un vecteur ligne est une matrice 1 x n
+            Product<T, 1, n, m>::run(v, mat, res);
+        }
+
+        template<unsigned int o>
+        static void mul_matrix(const T *a, const T *b, T *res)
+        {
+            Product<T, n, m, o>::run(a, b, res);
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE pour Mat44r, les lignes (alignees sur 16 octets) sont
+     * chargees une seule fois
+     */
+    template<>
+    struct MatrixKernel<float, 4, 4, true, true>
+    {
+        static void mul_vector(const float *mat, const float *v, float *res)
+        {
+            __m128 c0 = _mm_load_ps(mat);
+            __m128 c1 = _mm_load_ps(mat + 4);
+            __m128 c2 = _mm_load_ps(mat + 8);
+            __m128 c3 = _mm_load_ps(mat + 12);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+            __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+            _mm_storeu_ps(res, r);
+        }
+
+        static void vector_mul(const float *v, const float *mat, float *res)
+        {
+            __m128 r = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_load_ps(mat));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_load_ps(mat + 4)));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_load_ps(mat + 8)));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_load_ps(mat + 12)));
+            _mm_storeu_ps(res, r);
+        }
+
+        /**
+         * @brief Produit par une matrice 4 x o, deroule comme pour les autres petites tailles
+         */
+        template<unsigned int o>
+        static void mul_matrix(const float *a, const float *b, float *res)
+        {
+            Product<float, 4, 4, o>::run(a, b, res);
+        }
+    };
+
+    /**
+     * @brief Produit de deux Mat44r : les lignes de b sont chargees une seule fois
+     * et chaque ligne du resultat est une combinaison de ces lignes
+     */
+    template<>
+    inline void MatrixKernel<float, 4, 4, true, true>::mul_matrix<4>(const float *a, const float *b, float *res)
+    {
+        const __m128 b0 = _mm_load_ps(b), b1 = _mm_load_ps(b + 4), b2 = _mm_load_ps(b + 8), b3 = _mm_load_ps(b + 12);
+
+        for (unsigned int i = 0; i < 4; ++i, a += 4, res += 4)
+        {
+            __m128 r = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+            _mm_store_ps(res, r);
+        }
+    }
+#endif
+
+    /**
+     * @class TransformKernel
+     * @brief Transformation d'un ensemble de points par une matrice 4x4 (stockee
+     * ligne par ligne), avec la convention du vecteur ligne : p' = (p, 1) * mat
+     */
+    template<class T, bool = Traits<T, 4>::vectorized>
+    struct TransformKernel
+    {
+        /**
+         * @brief Transforme des points stockes les uns a la suite des autres
+         * @param mat La matrice de transformation
+         * @param in Les coordonnees du premier point
+         * @param out Les coordonnees du premier point transforme (peut etre egal a in)
+         * @param count Le nombre de points
+         * @param stride L'ecart, en nombre de T, entre deux points consecutifs
+         */
+        static void points(const T *mat, const T *in, T *out, const std::size_t count, const std::size_t stride)
+        {
+            for (std::size_t p = 0; p < count; ++p, in += stride, out += stride)
+            {
+                const T x = in[0], y = in[1], z = in[2];
+
+                for (unsigned int j = 0; j < 3; ++j)
+                    out[j] = x * mat[j] + y * mat[4 + j] + z * mat[8 + j] + mat[12 + j];
+            }
+        }
+
+        /**
+         * @brief Transforme des points stockes coordonnee par coordonnee
+         * @param mat La matrice de transformation
+         * @param x, y, z Les coordonnees des points
+         * @param outX, outY, outZ Les coordonnees des points transformes (peuvent etre egales aux entrees)
+         * @param count Le nombre de points
+         */
+        static void soa(const T *mat, const T *x, const T *y, const T *z, T *outX, T *outY, T *outZ, const std::size_t count)
+        {
+            for (std::size_t p = 0; p < count; ++p)
+            {
+                const T px = x[p], py = y[p], pz = z[p];
+
+                outX[p] = px * mat[0] + py * mat[4] + pz * mat[8] + mat[12];
+                outY[p] = px * mat[1] + py * mat[5] + pz * mat[9] + mat[13];
+                outZ[p] = px * mat[2] + py * mat[6] + pz * mat[10] + mat[14];
+            }
+        }
+
+        /**
+         * @brief Transforme des points quantifies sur 16 bits, stockes coordonnee par coordonnee
+         *
+         * Le decodage (offset + q * scale) doit avoir ete integre a la matrice par
+         * l'appelant : les coordonnees entieres sont converties puis transformees directement.
+         * @param mat La matrice de decodage et de transformation
+         * @param x, y, z Les coordonnees quantifiees des points
+         * @param outX, outY, outZ Les coordonnees des points transformes
+         * @param count Le nombre de points
+         */
+        static void quantized(const T *mat, const std::uint16_t *x, const std::uint16_t *y, const std::uint16_t *z, T *outX, T *outY, T *outZ, const std::size_t count)
+        {
+            for (std::size_t p = 0; p < count; ++p)
+            {
+                const T px = T(x[p]), py = T(y[p]), pz = T(z[p]);
+
+                outX[p] = px * mat[0] + py * mat[4] + pz * mat[8] + mat[12];
+                outY[p] = px * mat[1] + py * mat[5] + pz * mat[9] + mat[13];
+                outZ[p] = px * mat[2] + py * mat[6] + pz * mat[10] + mat[14];
+            }
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE : la matrice est chargee une seule fois dans les registres
+     */
+    template<>
+    struct TransformKernel<float, true>
+    {
+        /**
+         * @brief Les points doivent etre alignes sur 16 octets et comporter quatre
+         * composantes (stride = 4), la quatrieme etant remise a zero
+         */
+        static void points(const float *mat, const float *in, float *out, const std::size_t count, const std::size_t stride)
+        {
+            const __m128 r0 = _mm_load_ps(mat);
+            const __m128 r1 = _mm_load_ps(mat + 4);
+            const __m128 r2 = _mm_load_ps(mat + 8);
+            const __m128 r3 = _mm_load_ps(mat + 12);
+            const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+            for (std::size_t p = 0; p < count; ++p, in += stride, out += stride)
+            {
+                const __m128 v = _mm_load_ps(in);
+
+                __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+                r = _mm_add_ps(r, r3);
+                _mm_store_ps(out, _mm_and_ps(r, xyz));
+            }
+        }
+
+        /**
+         * @brief Quatre points sont transformes a chaque iteration, les derniers un par un
+         */
+        static void soa(const float *mat, const float *x, const float *y, const float *z, float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            const __m128 m00 = _mm_set1_ps(mat[0]), m01 = _mm_set1_ps(mat[1]), m02 = _mm_set1_ps(mat[2]);
+            const __m128 m10 = _mm_set1_ps(mat[4]), m11 = _mm_set1_ps(mat[5]), m12 = _mm_set1_ps(mat[6]);
+            const __m128 m20 = _mm_set1_ps(mat[8]), m21 = _mm_set1_ps(mat[9]), m22 = _mm_set1_ps(mat[10]);
+            const __m128 m30 = _mm_set1_ps(mat[12]), m31 = _mm_set1_ps(mat[13]), m32 = _mm_set1_ps(mat[14]);
+
+            std::size_t p = 0;
+
+            for (; p + 4 <= count; p += 4)
+            {
+                const __m128 px = _mm_loadu_ps(x + p);
+                const __m128 py = _mm_loadu_ps(y + p);
+                const __m128 pz = _mm_loadu_ps(z + p);
+
+                _mm_storeu_ps(outX + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m00), _mm_mul_ps(py, m10)), _mm_mul_ps(pz, m20)), m30));
+                _mm_storeu_ps(outY + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m01), _mm_mul_ps(py, m11)), _mm_mul_ps(pz, m21)), m31));
+                _mm_storeu_ps(outZ + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m02), _mm_mul_ps(py, m12)), _mm_mul_ps(pz, m22)), m32));
+            }
+
+            TransformKernel<float, false>::soa(mat, x + p, y + p, z + p, outX + p, outY + p, outZ + p, count - p);
+        }
+
+        /**
+         * @brief Huit points sont decodes et transformes a chaque iteration, les derniers un par un
+         */
+        static void quantized(const float *mat, const std::uint16_t *x, const std::uint16_t *y, const std::uint16_t *z, float *outX, float *outY, float *outZ, const std::size_t count)
+        {
+            const __m128 m00 = _mm_set1_ps(mat[0]), m01 = _mm_set1_ps(mat[1]), m02 = _mm_set1_ps(mat[2]);
+            const __m128 m10 = _mm_set1_ps(mat[4]), m11 = _mm_set1_ps(mat[5]), m12 = _mm_set1_ps(mat[6]);
+            const __m128 m20 = _mm_set1_ps(mat[8]), m21 = _mm_set1_ps(mat[9]), m22 = _mm_set1_ps(mat[10]);
+            const __m128 m30 = _mm_set1_ps(mat[12]), m31 = _mm_set1_ps(mat[13]), m32 = _mm_set1_ps(mat[14]);
+            const __m128i zero = _mm_setzero_si128();
+
+            std::size_t p = 0;
+
+            for (; p + 8 <= count; p += 8)
+            {
+                const __m128i qx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + p));
+                const __m128i qy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + p));
+                const __m128i qz = _mm_loadu_si128(reinterpret_cast<const __m128i *>(z + p));
+
+                const __m128 px0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(qx, zero)), px1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(qx, zero));
+                const __m128 py0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(qy, zero)), py1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(qy, zero));
+                const __m128 pz0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(qz, zero)), pz1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(qz, zero));
+
+                _mm_storeu_ps(outX + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px0, m00), _mm_mul_ps(py0, m10)), _mm_mul_ps(pz0, m20)), m30));
+                _mm_storeu_ps(outX + p + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px1, m00), _mm_mul_ps(py1, m10)), _mm_mul_ps(pz1, m20)), m30));
+                _mm_storeu_ps(outY + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px0, m01), _mm_mul_ps(py0, m11)), _mm_mul_ps(pz0, m21)), m31));
+                _mm_storeu_ps(outY + p + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px1, m01), _mm_mul_ps(py1, m11)), _mm_mul_ps(pz1, m21)), m31));
+                _mm_storeu_ps(outZ + p, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px0, m02), _mm_mul_ps(py0, m12)), _mm_mul_ps(pz0, m22)), m32));
+                _mm_storeu_ps(outZ + p + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px1, m02), _mm_mul_ps(py1, m12)), _mm_mul_ps(pz1, m22)), m32));
+            }
+
+            TransformKernel<float, false>::quantized(mat, x + p, y + p, z + p, outX + p, outY + p, outZ + p, count - p);
+        }
+    };
+#endif
+
+    /**
+     * @class AffineKernel
+     * @brief Transformation d'un ensemble de points par une matrice affine 3x4
+     * [A | t], stockee ligne par ligne : p' = A p + t, soit 12 multiplications-additions
+     */
+    template<class T, bool = Traits<T, 4>::vectorized>
+    struct AffineKernel
+    {
+        /**
+         * @brief Transforme des points stockes les uns a la suite des autres
+         * @param mat Les 12 coefficients de la matrice
+         * @param in Les coordonnees du premier point
+         * @param out Les coordonnees du premier point transforme (peut etre egal a in)
+         * @param count Le nombre de points
+         * @param stride L'ecart, en nombre de T, entre deux points consecutifs
+         */
+        static void points(const T *mat, const T *in, T *out, const std::size_t count, const std::size_t stride)
+        {
+            for (std::size_t p = 0; p < count; ++p, in += stride, out += stride)
+            {
+                const T x = in[0], y = in[1], z = in[2];
+
+                for (unsigned int j = 0; j < 3; ++j)
+                    out[j] = x * mat[4 * j] + y * mat[4 * j + 1] + z * mat[4 * j + 2] + mat[4 * j + 3];
+            }
+        }
+
+        /**
+         * @brief Compose deux matrices affines : appliquer out revient a appliquer a puis b
+         * @param a La premiere transformation
+         * @param b La seconde transformation
+         * @param out Le resultat b * a (peut etre egal a a ou b)
+         */
+        static void concat(const T *a, const T *b, T *out)
+        {
+            T res[12];
+
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                const T b0 = b[4 * i], b1 = b[4 * i + 1], b2 = b[4 * i + 2];
+
+                for (unsigned int j = 0; j < 4; ++j)
+                    res[4 * i + j] = b0 * a[j] + b1 * a[4 + j] + b2 * a[8 + j];
+                res[4 * i + 3] += b[4 * i + 3];
+            }
+
+            for (unsigned int k = 0; k < 12; ++k)
+                out[k] = res[k];
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE : quatre points sont transposes puis transformes a chaque
+     * iteration, les coefficients restant dans les registres
+     */
+    template<>
+    struct AffineKernel<float, true>
+    {
+        /**
+         * @brief Les points doivent etre alignes sur 16 octets et comporter quatre
+         * composantes (stride = 4), la quatrieme etant remise a zero
+         */
+        static void points(const float *mat, const float *in, float *out, const std::size_t count, const std::size_t stride)
+        {
+            const __m128 a00 = _mm_set1_ps(mat[0]), a01 = _mm_set1_ps(mat[1]), a02 = _mm_set1_ps(mat[2]), t0 = _mm_set1_ps(mat[3]);
+            const __m128 a10 = _mm_set1_ps(mat[4]), a11 = _mm_set1_ps(mat[5]), a12 = _mm_set1_ps(mat[6]), t1 = _mm_set1_ps(mat[7]);
+            const __m128 a20 = _mm_set1_ps(mat[8]), a21 = _mm_set1_ps(mat[9]), a22 = _mm_set1_ps(mat[10]), t2 = _mm_set1_ps(mat[11]);
+
+            std::size_t p = 0;
+
+            for (; p + 4 <= count; p += 4, in += 4 * stride, out += 4 * stride)
+            {
+                __m128 x = _mm_load_ps(in), y = _mm_load_ps(in + stride), z = _mm_load_ps(in + 2 * stride), w = _mm_load_ps(in + 3 * stride);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, a00), _mm_mul_ps(y, a01)), _mm_mul_ps(z, a02)), t0);
+                __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, a10), _mm_mul_ps(y, a11)), _mm_mul_ps(z, a12)), t1);
+                __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, a20), _mm_mul_ps(y, a21)), _mm_mul_ps(z, a22)), t2);
+                __m128 rw = _mm_setzero_ps();
+                _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+
+                _mm_store_ps(out, rx);
+                _mm_store_ps(out + stride, ry);
+                _mm_store_ps(out + 2 * stride, rz);
+                _mm_store_ps(out + 3 * stride, rw);
+            }
+
+            AffineKernel<float, false>::points(mat, in, out, count - p, stride);
+        }
+
+        /**
+         * @brief Chaque ligne du resultat est une combinaison des lignes de a
+         */
+        static void concat(const float *a, const float *b, float *out)
+        {
+            const __m128 r0 = _mm_loadu_ps(a), r1 = _mm_loadu_ps(a + 4), r2 = _mm_loadu_ps(a + 8);
+            const __m128 t = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+            __m128 res[3];
+
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                const __m128 row = _mm_loadu_ps(b + 4 * i);
+
+                __m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+                res[i] = _mm_add_ps(r, _mm_and_ps(row, t));
+            }
+
+            _mm_storeu_ps(out, res[0]);
+            _mm_storeu_ps(out + 4, res[1]);
+            _mm_storeu_ps(out + 8, res[2]);
+        }
+    };
+#endif
+
+    /**
+     * @class QuaternionKernel
+     * @brief Calculs sur des tableaux de quaternions, ranges (w, x, y, z) les uns a la suite des autres
+     */
+    template<class T, bool = Traits<T, 4>::vectorized>
+    struct QuaternionKernel
+    {
+        /**
+         * @brief Produit de Hamilton terme a terme : out[i] = a[i] * b[i]
+         * @param a, b Les quaternions a multiplier
+         * @param out Les produits (peut etre egal a a ou b)
+         * @param count Le nombre de quaternions
+         */
+        static void multiply(const T *a, const T *b, T *out, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i, a += 4, b += 4, out += 4)
+            {
+                const T aw = a[0], ax = a[1], ay = a[2], az = a[3];
+                const T bw = b[0], bx = b[1], by = b[2], bz = b[3];
+
+                out[0] = aw * bw - ax * bx - ay * by - az * bz;
+                out[1] = aw * bx + ax * bw + ay * bz - az * by;
+                out[2] = aw * by - ax * bz + ay * bw + az * bx;
+                out[3] = aw * bz + ax * by - ay * bx + az * bw;
+            }
+        }
+
+        /**
+         * @brief Matrices de rotation 4x4, stockees ligne par ligne, des quaternions unitaires
+         *
+         * Les coefficients sont ceux de Transformation(const Quaternion &), avec la
+         * convention du vecteur ligne : la matrice est la transposee de la matrice
+         * de rotation R habituelle, M[0][1] = R[1][0] = 2xy + 2wz, etc. ; la derniere
+         * ligne et la derniere colonne sont celles de l'identite.
+         * @param q Les quaternions
+         * @param out Les 16 coefficients de chaque matrice
+         * @param count Le nombre de quaternions
+         */
+        static void to_matrix(const T *q, T *out, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i, q += 4, out += 16)
+            {
+                const T w2 = 2 * q[0], x = q[1], y = q[2], z = q[3];
+                const T x2 = 2 * x, y2 = 2 * y, z2 = 2 * z;
+
+                out[0] = 1 - y2 * y - z2 * z;
+                out[1] = x2 * y + w2 * z;
+                out[2] = x2 * z - w2 * y;
+                out[4] = x2 * y - w2 * z;
+                out[5] = 1 - x2 * x - z2 * z;
+                out[6] = y2 * z + w2 * x;
+                out[8] = x2 * z + w2 * y;
+                out[9] = y2 * z - w2 * x;
+                out[10] = 1 - x2 * x - y2 * y;
+                out[3] = out[7] = out[11] = out[12] = out[13] = out[14] = 0;
+                out[15] = 1;
+            }
+        }
+
+        /**
+         * @brief Interpolation lineaire normalisee, par le chemin le plus court :
+         * out[i] = normalise(a[i] + t (+-b[i] - a[i]))
+         * @param a, b Les quaternions unitaires a interpoler
+         * @param t Les parametres d'interpolation, dans [0, 1]
+         * @param step L'ecart entre deux parametres : 1 pour un parametre par
+         * quaternion, 0 pour un meme parametre pour tous
+         * @param out Les quaternions interpoles
+         * @param count Le nombre de quaternions
+         */
+        static void nlerp(const T *a, const T *b, const T *t, const std::size_t step, T *out, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i, a += 4, b += 4, t += step, out += 4)
+            {
+                const T u = *t;
+                const T sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0 ? -1 : 1;
+
+                T r[4];
+                for (unsigned int c = 0; c < 4; ++c)
+                    r[c] = a[c] + u * (sign * b[c] - a[c]);
+
+                normalize(r, out);
+            }
+        }
+
+        /**
+         * @brief Interpolation spherique par le chemin le plus court, sans fonction
+         * trigonometrique
+         *
+         * Les coefficients sin((1 - t) theta) / sin(theta) et sin(t theta) / sin(theta)
+         * sont approches par le polynome de D. Eberly (A Fast and Accurate Algorithm
+         * for Computing SLERP, 2011), d'erreur relative inferieure a 1e-6 ; le resultat est
+         * ensuite renormalise. Les parametres sont ceux de nlerp.
+         */
+        static void slerp(const T *a, const T *b, const T *t, const std::size_t step, T *out, const std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i, a += 4, b += 4, t += step, out += 4)
+            {
+                const T u = *t, d = 1 - u;
+                T x = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+                const T sign = x < 0 ? -1 : 1;
+                x *= sign;
+
+                const T cb = sign * u * series(u * u, x - 1);
+                const T ca = d * series(d * d, x - 1);
+
+                T r[4];
+                for (unsigned int c = 0; c < 4; ++c)
+                    r[c] = ca * a[c] + cb * b[c];
+
+                normalize(r, out);
+            }
+        }
+
+        /**
+         * @brief Coefficients du polynome de slerp : (1 + (u_k t^2 - v_k) (x - 1) ...), k = 1..8
+         */
+        static T u(const int k)
+        {
+            return k < 8 ? T(1) / (k * (2 * k + 1)) : T(1.85298109240830) / (8 * 17);
+        }
+
+        static T v(const int k)
+        {
+            return k < 8 ? T(k) / (2 * k + 1) : T(1.85298109240830) * 8 / 17;
+        }
+
+    private:
+        static T series(const T sq, const T xm1)
+        {
+            T f = 1;
+            for (int k = 8; k >= 1; --k)
+                f = 1 + (u(k) * sq - v(k)) * xm1 * f;
+
+            return f;
+        }
+
+        static void normalize(const T *r, T *out)
+        {
+            const T n = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+
+            for (unsigned int c = 0; c < 4; ++c)
+                out[c] = r[c] / n;
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE : quatre quaternions sont transposes en registres (w, x, y, z)
+     * et traites a chaque iteration, les derniers par la version generique
+     */
+    template<>
+    struct QuaternionKernel<float, true>
+    {
+        static void multiply(const float *a, const float *b, float *out, const std::size_t count)
+        {
+            std::size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, a += 16, b += 16, out += 16)
+            {
+                __m128 aw = _mm_loadu_ps(a), ax = _mm_loadu_ps(a + 4), ay = _mm_loadu_ps(a + 8), az = _mm_loadu_ps(a + 12);
+                __m128 bw = _mm_loadu_ps(b), bx = _mm_loadu_ps(b + 4), by = _mm_loadu_ps(b + 8), bz = _mm_loadu_ps(b + 12);
+                _MM_TRANSPOSE4_PS(aw, ax, ay, az);
+                _MM_TRANSPOSE4_PS(bw, bx, by, bz);
+
+                __m128 w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+                __m128 x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+                __m128 y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+                __m128 z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+                _MM_TRANSPOSE4_PS(w, x, y, z);
+
+                _mm_storeu_ps(out, w);
+                _mm_storeu_ps(out + 4, x);
+                _mm_storeu_ps(out + 8, y);
+                _mm_storeu_ps(out + 12, z);
+            }
+
+            QuaternionKernel<float, false>::multiply(a, b, out, count - i);
+        }
+
+        static void to_matrix(const float *q, float *out, const std::size_t count)
+        {
+            const __m128 one = _mm_set1_ps(1), two = _mm_set1_ps(2), zero = _mm_setzero_ps();
+            const __m128 last = _mm_set_ps(1, 0, 0, 0);
+
+            std::size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, q += 16, out += 64)
+            {
+                __m128 w = _mm_loadu_ps(q), x = _mm_loadu_ps(q + 4), y = _mm_loadu_ps(q + 8), z = _mm_loadu_ps(q + 12);
+                _MM_TRANSPOSE4_PS(w, x, y, z);
+
+                const __m128 w2 = _mm_mul_ps(two, w), x2 = _mm_mul_ps(two, x), y2 = _mm_mul_ps(two, y), z2 = _mm_mul_ps(two, z);
+
+                __m128 m00 = _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(y2, y)), _mm_mul_ps(z2, z));
+                __m128 m01 = _mm_add_ps(_mm_mul_ps(x2, y), _mm_mul_ps(w2, z));
+                __m128 m02 = _mm_sub_ps(_mm_mul_ps(x2, z), _mm_mul_ps(w2, y));
+                __m128 m10 = _mm_sub_ps(_mm_mul_ps(x2, y), _mm_mul_ps(w2, z));
+                __m128 m11 = _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(x2, x)), _mm_mul_ps(z2, z));
+                __m128 m12 = _mm_add_ps(_mm_mul_ps(y2, z), _mm_mul_ps(w2, x));
+                __m128 m20 = _mm_add_ps(_mm_mul_ps(x2, z), _mm_mul_ps(w2, y));
+                __m128 m21 = _mm_sub_ps(_mm_mul_ps(y2, z), _mm_mul_ps(w2, x));
+                __m128 m22 = _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(x2, x)), _mm_mul_ps(y2, y));
+                __m128 r0 = zero, r1 = zero, r2 = zero;
+
+                // Chaque transposition donne une meme ligne des quatre matrices
+                _MM_TRANSPOSE4_PS(m00, m01, m02, r0);
+                _MM_TRANSPOSE4_PS(m10, m11, m12, r1);
+                _MM_TRANSPOSE4_PS(m20, m21, m22, r2);
+
+                const __m128 rows[4][3] = {{m00, m10, m20}, {m01, m11, m21}, {m02, m12, m22}, {r0, r1, r2}};
+                for (int k = 0; k < 4; ++k)
+                {
+                    _mm_storeu_ps(out + 16 * k, rows[k][0]);
+                    _mm_storeu_ps(out + 16 * k + 4, rows[k][1]);
+                    _mm_storeu_ps(out + 16 * k + 8, rows[k][2]);
+                    _mm_storeu_ps(out + 16 * k + 12, last);
+                }
+            }
+
+            QuaternionKernel<float, false>::to_matrix(q, out, count - i);
+        }
+
+        static void nlerp(const float *a, const float *b, const float *t, const std::size_t step, float *out, const std::size_t count)
+        {
+            std::size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, a += 16, b += 16, t += 4 * step, out += 16)
+            {
+                __m128 aw, ax, ay, az, bw, bx, by, bz;
+                load(a, aw, ax, ay, az);
+                load(b, bw, bx, by, bz);
+
+                const __m128 u = step ? _mm_loadu_ps(t) : _mm_set1_ps(*t);
+                const __m128 sign = _mm_and_ps(dot(aw, ax, ay, az, bw, bx, by, bz), _mm_set1_ps(-0.f));
+
+                __m128 w = _mm_add_ps(aw, _mm_mul_ps(u, _mm_sub_ps(_mm_xor_ps(bw, sign), aw)));
+                __m128 x = _mm_add_ps(ax, _mm_mul_ps(u, _mm_sub_ps(_mm_xor_ps(bx, sign), ax)));
+                __m128 y = _mm_add_ps(ay, _mm_mul_ps(u, _mm_sub_ps(_mm_xor_ps(by, sign), ay)));
+                __m128 z = _mm_add_ps(az, _mm_mul_ps(u, _mm_sub_ps(_mm_xor_ps(bz, sign), az)));
+
+                store(out, w, x, y, z);
+            }
+
+            QuaternionKernel<float, false>::nlerp(a, b, t, step, out, count - i);
+        }
+
+        static void slerp(const float *a, const float *b, const float *t, const std::size_t step, float *out, const std::size_t count)
+        {
+            const __m128 one = _mm_set1_ps(1), signBit = _mm_set1_ps(-0.f);
+            __m128 u[8], v[8];
+            for (int k = 0; k < 8; ++k)
+            {
+                u[k] = _mm_set1_ps(QuaternionKernel<float, false>::u(k + 1));
+                v[k] = _mm_set1_ps(QuaternionKernel<float, false>::v(k + 1));
+            }
+
+            std::size_t i = 0;
+
+            for (; i + 4 <= count; i += 4, a += 16, b += 16, t += 4 * step, out += 16)
+            {
+                __m128 aw, ax, ay, az, bw, bx, by, bz;
+                load(a, aw, ax, ay, az);
+                load(b, bw, bx, by, bz);
+
+                const __m128 tb = step ? _mm_loadu_ps(t) : _mm_set1_ps(*t);
+                const __m128 ta = _mm_sub_ps(one, tb);
+                const __m128 cos = dot(aw, ax, ay, az, bw, bx, by, bz);
+                const __m128 sign = _mm_and_ps(cos, signBit);
+                const __m128 xm1 = _mm_sub_ps(_mm_andnot_ps(signBit, cos), one);
+                const __m128 sqa = _mm_mul_ps(ta, ta), sqb = _mm_mul_ps(tb, tb);
+
+                __m128 fa = one, fb = one;
+                for (int k = 7; k >= 0; --k)
+                {
+                    fa = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u[k], sqa), v[k]), xm1), fa));
+                    fb = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u[k], sqb), v[k]), xm1), fb));
+                }
+
+                const __m128 ca = _mm_mul_ps(ta, fa);
+                const __m128 cb = _mm_xor_ps(_mm_mul_ps(tb, fb), sign);
+
+                __m128 w = _mm_add_ps(_mm_mul_ps(ca, aw), _mm_mul_ps(cb, bw));
+                __m128 x = _mm_add_ps(_mm_mul_ps(ca, ax), _mm_mul_ps(cb, bx));
+                __m128 y = _mm_add_ps(_mm_mul_ps(ca, ay), _mm_mul_ps(cb, by));
+                __m128 z = _mm_add_ps(_mm_mul_ps(ca, az), _mm_mul_ps(cb, bz));
+
+                store(out, w, x, y, z);
+            }
+
+            QuaternionKernel<float, false>::slerp(a, b, t, step, out, count - i);
+        }
+
+    private:
+        static void load(const float *q, __m128 &w, __m128 &x, __m128 &y, __m128 &z)
+        {
+            w = _mm_loadu_ps(q);
+            x = _mm_loadu_ps(q + 4);
+            y = _mm_loadu_ps(q + 8);
+            z = _mm_loadu_ps(q + 12);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+        }
+
+        static __m128 dot(const __m128 aw, const __m128 ax, const __m128 ay, const __m128 az,
+                          const __m128 bw, const __m128 bx, const __m128 by, const __m128 bz)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        }
+
+        /**
+         * @brief Normalise quatre quaternions, les transpose et les range
+         */
+        static void store(float *out, __m128 w, __m128 x, __m128 y, __m128 z)
+        {
+            const __m128 n = _mm_sqrt_ps(dot(w, x, y, z, w, x, y, z));
+
+            w = _mm_div_ps(w, n);
+            x = _mm_div_ps(x, n);
+            y = _mm_div_ps(y, n);
+            z = _mm_div_ps(z, n);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+
+            _mm_storeu_ps(out, w);
+            _mm_storeu_ps(out + 4, x);
+            _mm_storeu_ps(out + 8, y);
+            _mm_storeu_ps(out + 12, z);
+        }
+    };
+#endif
+
+    /**
+     * @class GemmKernel
+     * @brief Micro-noyau du produit de grandes matrices : ajoute a un bloc mr x nr
+     * de C le produit d'un panneau de A (mr lignes) par un panneau de B (nr colonnes)
+     *
+     * Les panneaux sont ranges par DynMatrix : pour chaque k, les mr coefficients
+     * de la colonne k du panneau de A puis les nr coefficients de la ligne k du
+     * panneau de B sont contigus. Le bloc de C reste dans les registres pendant
+     * toute la profondeur kc.
+     */
+    template<class T>
+    struct GemmKernel
+    {
+        static constexpr unsigned int mr = 4; /**< Lignes d'un bloc de C */
+        static constexpr unsigned int nr = 4; /**< Colonnes d'un bloc de C */
+
+        /**
+         * @brief c += a * b sur un bloc mr x nr
+         * @param kc La profondeur des panneaux
+         * @param a Le panneau de A
+         * @param b Le panneau de B
+         * @param c Le premier coefficient du bloc de C
+         * @param ldc L'ecart, en nombre de T, entre deux lignes de C
+         */
+        static void run(const std::size_t kc, const T *a, const T *b, T *c, const std::size_t ldc)
+        {
+            T acc[mr][nr] = {};
+
+            for (std::size_t k = 0; k < kc; ++k, a += mr, b += nr)
+                for (unsigned int i = 0; i < mr; ++i)
+                    for (unsigned int j = 0; j < nr; ++j)
+                        acc[i][j] += a[i] * b[j];
+
+            for (unsigned int i = 0; i < mr; ++i)
+                for (unsigned int j = 0; j < nr; ++j)
+                    c[i * ldc + j] += acc[i][j];
+        }
+    };
+
+#ifdef MATH_SIMD_SSE
+    /**
+     * @brief Version SSE en simple precision : bloc 4 x 8 tenu dans huit registres
+     */
+    template<>
+    struct GemmKernel<float>
+    {
+        static constexpr unsigned int mr = 4;
+        static constexpr unsigned int nr = 8;
+
+        static void run(const std::size_t kc, const float *a, const float *b, float *c, const std::size_t ldc)
+        {
+            __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps(), c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+            __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps(), c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+
+            for (std::size_t k = 0; k < kc; ++k, a += mr, b += nr)
+            {
+                const __m128 b0 = _mm_load_ps(b), b1 = _mm_load_ps(b + 4);
+                __m128 ai = _mm_set1_ps(a[0]);
+                c00 = _mm_add_ps(c00, _mm_mul_ps(ai, b0));
+                c01 = _mm_add_ps(c01, _mm_mul_ps(ai, b1));
+                ai = _mm_set1_ps(a[1]);
+                c10 = _mm_add_ps(c10, _mm_mul_ps(ai, b0));
+                c11 = _mm_add_ps(c11, _mm_mul_ps(ai, b1));
+                ai = _mm_set1_ps(a[2]);
+                c20 = _mm_add_ps(c20, _mm_mul_ps(ai, b0));
+                c21 = _mm_add_ps(c21, _mm_mul_ps(ai, b1));
+                ai = _mm_set1_ps(a[3]);
+                c30 = _mm_add_ps(c30, _mm_mul_ps(ai, b0));
+                c31 = _mm_add_ps(c31, _mm_mul_ps(ai, b1));
+            }
+
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), c00));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c01));
+            c += ldc;
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), c10));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c11));
+            c += ldc;
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), c20));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c21));
+            c += ldc;
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), c30));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c31));
+        }
+    };
+
+    /**
+     * @brief Version SSE2 en double precision : bloc 4 x 4 tenu dans huit registres
+     */
+    template<>
+    struct GemmKernel<double>
+    {
+        static constexpr unsigned int mr = 4;
+        static constexpr unsigned int nr = 4;
+
+        static void run(const std::size_t kc, const double *a, const double *b, double *c, const std::size_t ldc)
+        {
+            __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd(), c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+            __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd(), c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+            for (std::size_t k = 0; k < kc; ++k, a += mr, b += nr)
+            {
+                const __m128d b0 = _mm_load_pd(b), b1 = _mm_load_pd(b + 2);
+                __m128d ai = _mm_set1_pd(a[0]);
+                c00 = _mm_add_pd(c00, _mm_mul_pd(ai, b0));
+                c01 = _mm_add_pd(c01, _mm_mul_pd(ai, b1));
+                ai = _mm_set1_pd(a[1]);
+                c10 = _mm_add_pd(c10, _mm_mul_pd(ai, b0));
+                c11 = _mm_add_pd(c11, _mm_mul_pd(ai, b1));
+                ai = _mm_set1_pd(a[2]);
+                c20 = _mm_add_pd(c20, _mm_mul_pd(ai, b0));
+                c21 = _mm_add_pd(c21, _mm_mul_pd(ai, b1));
+                ai = _mm_set1_pd(a[3]);
+                c30 = _mm_add_pd(c30, _mm_mul_pd(ai, b0));
+                c31 = _mm_add_pd(c31, _mm_mul_pd(ai, b1));
+            }
+
+            _mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c00));
+            _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c01));
+            c += ldc;
+            _mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c10));
+            _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c11));
+            c += ldc;
+            _mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c20));
+            _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c21));
+            c += ldc;
+            _mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c30));
+            _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c31));
+        }
+    };
+#endif
+}
+}
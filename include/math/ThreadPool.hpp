@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace math
+{
+    /**
+     * @class ThreadPool
+     * @brief Ensemble de threads executant des taches decoupees par parallel_for
+     *
+     * Le thread appelant participe au calcul : il traite le premier morceau puis,
+     * en attendant les autres, execute les taches encore en file. Un parallel_for
+     * lance depuis une tache ne bloque donc jamais le pool. Une exception levee
+     * par une tache est relancee dans le thread appelant.
+     */
+    class ThreadPool
+    {
+    private:
+        /**
+         * @brief Suivi d'un appel a parallel_for
+         */
+        struct Batch
+        {
+            std::size_t remaining; /**< Nombre de morceaux non termines */
+            std::exception_ptr error; /**< Premiere exception levee par un morceau */
+        };
+
+        std::vector<std::thread> workers; /**< Threads du pool */
+        std::queue<std::function<void()>> tasks; /**< Taches en attente */
+        std::mutex lock; /**< Protege tasks, stopping et les Batch */
+        std::condition_variable available; /**< Signale une nouvelle tache ou l'arret */
+        std::condition_variable finished; /**< Signale la fin d'un morceau */
+        bool stopping; /**< Le pool est en cours de destruction */
+
+        /**
+         * @brief Boucle d'un thread du pool
+         */
+        void work()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            for (;;)
+            {
+                available.wait(guard, [this]() { return stopping || !tasks.empty(); });
+
+                if (tasks.empty())
+                    return;
+
+                std::function<void()> task = std::move(tasks.front());
+                tasks.pop();
+
+                guard.unlock();
+                task();
+                guard.lock();
+            }
+        }
+
+        /**
+         * @brief Execute un morceau et met a jour son Batch
+         */
+        template<class F>
+        void run(Batch &batch, F &f, const std::size_t first, const std::size_t last)
+        {
+            std::exception_ptr error;
+
+            try
+            {
+                f(first, last);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            if (error && !batch.error)
+                batch.error = error;
+            if (--batch.remaining == 0)
+                finished.notify_all();
+        }
+
+    public:
+        /**
+         * @brief Demarre le pool
+         * @param threads Le nombre de threads en plus du thread appelant ; par defaut,
+         * un de moins que le nombre de coeurs
+         */
+        explicit ThreadPool(const unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u) - 1) : stopping(false)
+        {
+            for (unsigned int i = 0; i < threads; ++i)
+                workers.emplace_back(&ThreadPool::work, this);
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Termine les taches en file puis arrete les threads
+         */
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+            }
+
+            available.notify_all();
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+
+        /**
+         * @brief Nombre de threads participant a un calcul, thread appelant compris
+         */
+        unsigned int size() const
+        {
+            return unsigned(workers.size()) + 1;
+        }
+
+        /**
+         * @brief Applique f a l'intervalle [begin, end) decoupe en morceaux et attend la fin
+         *
+         * L'intervalle est decoupe en au plus size() morceaux contigus d'au moins
+         * grain elements ; f(first, last) est appele une fois par morceau.
+         * @param begin Le debut de l'intervalle
+         * @param end La fin de l'intervalle, exclue
+         * @param grain La taille minimale d'un morceau
+         * @param f La fonction a appliquer
+         */
+        template<class F>
+        void parallel_for(const std::size_t begin, const std::size_t end, const std::size_t grain, F f)
+        {
+            if (begin >= end)
+                return;
+
+            const std::size_t count = end - begin;
+            const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(size(), count / std::max<std::size_t>(grain, 1)));
+
+            if (chunks == 1)
+            {
+                f(begin, end);
+                return;
+            }
+
+            Batch batch{chunks, nullptr};
+            const std::size_t step = count / chunks, extra = count % chunks;
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+
+                std::size_t first = begin + step + (extra > 0);
+                for (std::size_t c = 1; c < chunks; ++c)
+                {
+                    const std::size_t last = first + step + (c < extra);
+                    tasks.push([this, &batch, &f, first, last]() { run(batch, f, first, last); });
+                    first = last;
+                }
+            }
+            available.notify_all();
+
+            run(batch, f, begin, begin + step + (extra > 0));
+
+            std::unique_lock<std::mutex> guard(lock);
+            while (batch.remaining > 0)
+            {
+                if (tasks.empty())
+                {
+                    finished.wait(guard);
+                    continue;
+                }
+
+                std::function<void()> task = std::move(tasks.front());
+                tasks.pop();
+
+                guard.unlock();
+                task();
+                guard.lock();
+            }
+
+            if (batch.error)
+                std::rethrow_exception(batch.error);
+        }
+
+        /**
+         * @brief Pool partage par les calculs qui ne precisent pas le leur
+         */
+        static ThreadPool &global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+    };
+}
@@ -2,7 +2,11 @@
 #include <array>
 #include <cmath>
 #include <iostream>
-#define ROUND(x) (round((x) * 100) / 100)
+#include <type_traits>
+
+#include "math/Simd.hpp"
+#include "math/Precision.hpp"
+#include "math/FastMath.hpp"
 
 using real = float;
 
@@ -13,25 +17,173 @@ const unsigned int MIN_ARGS_CROSS = 3;
 
 namespace math
 {
+  template<class T, unsigned int size, class P = Exact>
+  class Vector;
+
+  /**
+   * @class VectorExpr
+   * @brief Expression vectorielle evaluee a l'affectation
+   *
+   * Les operations composante par composante (addition, soustraction, negation,
+   * produit par un scalaire) ne construisent pas de vecteur intermediaire : elles
+   * retournent une expression, evaluee en une seule passe lorsqu'elle est
+   * affectee a un Vector. Une expression ne doit pas survivre aux vecteurs
+   * qu'elle reference. P est la politique de precision appliquee par les
+   * operations qui arrondissent (soustraction, produit par un scalaire).
+   */
+  template<class E, class T, unsigned int size, class P>
+  class VectorExpr
+  {
+  public:
+    typedef T value_type;
+    typedef P precision;
+    typedef typename simd::Kernel<T, size>::packet packet_type;
+
+    /**
+     * @brief Accede a l'expression concrete
+     * @return L'expression concrete
+     */
+    const E &self() const
+    {
+      return static_cast<const E &>(*this);
+    }
+
+    /**
+     * @brief Evalue la composante i de l'expression
+     * @param i l'index de la composante
+     * @return La valeur de la composante i
+     */
+    T operator[](int i) const
+    {
+      return self()[i];
+    }
+
+    /**
+     * @brief Evalue l'expression dans un registre
+     * @return Le registre contenant toutes les composantes
+     */
+    packet_type packet() const
+    {
+      return self().packet();
+    }
+  };
+
+  /**
+   * @brief Facon dont une expression conserve ses operandes : les vecteurs
+   * par reference, les sous-expressions par valeur
+   */
+  template<class E>
+  struct VectorOperand
+  {
+    typedef const E type;
+  };
+
+  template<class T, unsigned int size, class P>
+  struct VectorOperand<Vector<T, size, P>>
+  {
+    typedef const Vector<T, size, P> &type;
+  };
+
+  /**
+   * @brief Evaluation d'une expression, composante par composante
+   */
+  template<class T, unsigned int size, bool = simd::Traits<T, size>::vectorized>
+  struct VectorEvaluator
+  {
+    template<class E, class P>
+    static void store(const VectorExpr<E, T, size, P> &e, T *out)
+    {
+      const E &expr = e.self();
+
+      for (unsigned int i = 0; i < size; ++i)
+        out[i] = expr[i];
+    }
+
+    template<class E, class P>
+    static T sum(const VectorExpr<E, T, size, P> &e)
+    {
+      T somme = T();
+
+      for (unsigned int i = 0; i < size; ++i)
+        somme += e.self()[i];
+
+      return somme;
+    }
+
+    template<class L, class R, class P>
+    static T dot(const VectorExpr<L, T, size, P> &l, const VectorExpr<R, T, size, P> &r)
+    {
+      T somme = T();
+
+      for (unsigned int i = 0; i < size; ++i)
+        somme += l.self()[i] * r.self()[i];
+
+      return somme;
+    }
+  };
+
+  /**
+   * @brief Evaluation d'une expression dans les registres SIMD
+   */
   template<class T, unsigned int size>
-  class Vector
+  struct VectorEvaluator<T, size, true>
+  {
+    template<class E, class P>
+    static void store(const VectorExpr<E, T, size, P> &e, T *out)
+    {
+      simd::Kernel<T, size>::store(out, e.self().packet());
+    }
+
+    template<class E, class P>
+    static T sum(const VectorExpr<E, T, size, P> &e)
+    {
+      return simd::Kernel<T, size>::sum(e.self().packet());
+    }
+
+    template<class L, class R, class P>
+    static T dot(const VectorExpr<L, T, size, P> &l, const VectorExpr<R, T, size, P> &r)
+    {
+      return simd::Kernel<T, size>::dot(l.self().packet(), r.self().packet());
+    }
+  };
+
+  /**
+   * @class Vector
+   * @brief Vecteur de dimension size
+   *
+   * P est la politique de precision : Exact (par defaut) ou RoundTo2Decimals.
+   */
+  template<class T, unsigned int size, class P>
+  class Vector : public VectorExpr<Vector<T, size, P>, T, size, P>
   {
   protected:
-    array<T, size> vec;
+    typedef simd::Traits<T, size> storage; /**< Taille et alignement du stockage */
+    typedef simd::Kernel<T, size> kernel; /**< Noyau de calcul (SIMD pour Vec3r et Vec4r) */
+
+    alignas(storage::alignment) array<T, storage::length> vec; /**< Composantes, completees par des zeros */
+
+    static_assert(size > 0, "Invalid size specified");
     public:
     /**
      * @brief Constructeur par défaut
      * @return Le vecteur nul
      */
-    Vector()
+    constexpr Vector() : vec()
     {
-      if (size == 0)
-        throw "Invalid size specified";
+    }
 
-      for (int i = 0; i < size; ++i)
-        vec[i] = T();
+    /**
+     * @brief Construit un vecteur a partir de ses composantes, utilisable dans une
+     * expression constante ; les composantes non precisees sont nulles
+     * @param x, y, rest Les composantes du vecteur
+     * @return Le vecteur initialisé avec les composantes spécifiées
+     */
+    template<class... U>
+    constexpr Vector(const T x, const T y, const U... rest) : vec{{x, y, T(rest)...}}
+    {
+      static_assert(sizeof...(U) + 2 <= size, "Too many components for the vector");
     }
-    
+
     /**
      * @brief Construit un vecteur avec une liste de coordonnées
      * @param list La liste des coordonnées que doit comporter le vecteur
@@ -39,6 +191,8 @@ namespace math
      */
     Vector(const initializer_list<T> &list)
     {
+      vec.fill(T());
+
       int i = 0;
       for (const T* element = list.begin(); element != list.end(); ++element, ++i)
       {
@@ -47,27 +201,35 @@ namespace math
     }
 
     /**
-     * @brief COnstructeur par recopie
-     * @param v Le vecteur à recopier
-     * @return Une copie du vecteur passé en paramètre
+     * @brief Evalue une expression vectorielle, eventuellement d'une autre politique
+     * de precision
+     * @param e L'expression a evaluer
+     * @return Le vecteur resultant de l'expression
      */
-    Vector(const Vector &v)
+    template<class E, class Q>
+    Vector(const VectorExpr<E, T, size, Q> &e)
     {
-      for (int i = 0; i < size; ++i)
-        vec[i] = v[i];
+      vec.fill(T());
+      VectorEvaluator<T, size>::store(e, vec.data());
     }
 
     /**
-     * @brief Destructeur
+     * @brief Affecte le resultat d'une expression au vecteur courant
+     * @param e L'expression a evaluer
      */
-    ~Vector() {}
-    
+    template<class E>
+    Vector &operator=(const VectorExpr<E, T, size, P> &e)
+    {
+      VectorEvaluator<T, size>::store(e, vec.data());
+      return (*this);
+    }
+
     /**
      * @brief Accède à la coordonnées i
      * @param i l'index de la coordonnée
      * @return La valeur de la coordonnée à l'index i
      */
-    inline T at(const unsigned int i) const { if (i > size) throw "Index out of the vector"; return vec.at(i); }
+    inline T at(const unsigned int i) const { if (i >= size) throw "Index out of the vector"; return vec.at(i); }
 
     /**
      * @brief Produit vectoriel
@@ -81,9 +243,7 @@ namespace math
       if (size < MIN_ARGS_CROSS)
         throw "The vector must have at least three arguments";
 
-      res[0] = ROUND((vec[1] * v[2]) - (vec[2] * v[1]));
-      res[1] = ROUND((vec[2] * v[0]) - (vec[0] * v[2]));
-      res[2] = ROUND((vec[0] * v[1]) - (vec[1] * v[0]));
+      kernel::store(res.vec.data(), P::template round_packet<T, size>(kernel::cross(packet(), v.packet())));
 
       return res;
     }
@@ -135,10 +295,9 @@ namespace math
      */
     Vector to_unit() const
     {
-      Vector<T, size> v;
-      for (int i = 0; i < size; i++)
-        v.vec[i] = ROUND((1 / norm()) * (vec[i]));
-      return v;
+      const float inv = DefaultMath::rsqrt(dot(*this, *this));
+
+      return (*this) * inv;
     }
 
     /**
@@ -157,211 +316,329 @@ namespace math
     }
 
     /**
-     * @brief Verifie l'egalite du vecteur courant avec un autre vecteur
-     * @param v le vecteur avec lequel effectué la comparaison
-     * @return true si les deux vecteurs sont égaux, false sinon
+     * @brief Charge le vecteur dans un registre
+     * @return Le registre contenant les composantes du vecteur
      */
-    bool operator==(const Vector &v) const
+    typename kernel::packet packet() const
     {
-      for (int i = 0; i < size; ++i)
-        if (v[i] != vec[i])
-          return false;
-      return true;
+      return kernel::load(vec.data());
     }
 
     /**
-     * @brief Verifie l'inegalite du vecteur courant avec un autre vecteur
-     * @param v le vecteur avec lequel effectue la comparaison
-     * @return true si les deux vecteurs sont inegaux, false sinon
+     * @brief Additione une expression à ce vecteur
+     * @param v L'expression a additionner au vecteur courant
      */
-    bool operator!=(const Vector &v) const
+    template<class E>
+    Vector &operator+=(const VectorExpr<E, T, size, P> &v)
     {
-      for (int i = 0; i < size; ++i)
-        if (v[i] != vec[i])
-          return true;
-      return false;
+      return (*this) = (*this) + v;
     }
 
     /**
-     * @brief Additionne le vecteur courant avec un autre vecteur
-     * @param v Le vecteur avec lequel effectuer la comparaison
-     * @return Le vecteur résultant de l'addition
+     * @brief Soustrait directement une expression au vecteur courant
+     * @param v L'expression a soustraire au vecteur courant
      */
-    Vector operator+(const Vector &v) const
+    template<class E>
+    Vector &operator-=(const VectorExpr<E, T, size, P> &v)
     {
-      Vector result;
-
-      for (int i = 0; i < size; ++i)
-      {
-        result[i] = this->at(i) + v[i];
-      }
-
-      return result;
+      return (*this) = (*this) - v;
     }
 
     /**
-     * @brief Additione un autre vecteur à celui-ci
-     * @param v Le vecteur a additionner au vecteur courant
+     * @brief Accede au stockage brut du vecteur
+     * @return Un pointeur sur la premiere composante
      */
-    Vector &operator+=(const Vector &v)
+    const T *data() const
     {
-      for (int i = 0; i < size; ++i)
-      {
-        vec[i] = vec[i] + v[i];
-      }
-
-      return (*this);
+      return vec.data();
     }
 
-    /**
-     * @brief Calcule la negation du vecteur courant
-     * @return La negation du vecteur courant
-     */
-    Vector operator-() const
+    T *data()
     {
-      Vector<T, size> res;
+      return vec.data();
+    }
+  };
 
-      for (int i = 0; i < size; ++i)
-        res[i] = -vec[i];
+  /**
+   * @class VectorSum
+   * @brief Somme de deux expressions
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  class VectorSum : public VectorExpr<VectorSum<L, R, T, size, P>, T, size, P>
+  {
+  private:
+    typename VectorOperand<L>::type l;
+    typename VectorOperand<R>::type r;
+  public:
+    VectorSum(const L &l, const R &r) : l(l), r(r) {}
 
-      return res;
+    T operator[](int i) const
+    {
+      return l[i] + r[i];
     }
 
-    /**
-     * @brief Soustrait un vecteur au vecteur courant
-     * @param v Le vecteur a soustraire au vecteur courant
-     * @return Le vecteur resultant de la soustraction
-     */
-    Vector operator-(const Vector &v) const
+    typename simd::Kernel<T, size>::packet packet() const
     {
-      Vector<T, size> res;
+      return simd::Kernel<T, size>::add(l.packet(), r.packet());
+    }
+  };
 
-      for (int i = 0; i < size; ++i)
-        res[i] =  ROUND(vec[i] - v[i]);
+  /**
+   * @class VectorDifference
+   * @brief Difference de deux expressions, arrondie selon la politique P
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  class VectorDifference : public VectorExpr<VectorDifference<L, R, T, size, P>, T, size, P>
+  {
+  private:
+    typename VectorOperand<L>::type l;
+    typename VectorOperand<R>::type r;
+  public:
+    VectorDifference(const L &l, const R &r) : l(l), r(r) {}
 
-      return res;
+    T operator[](int i) const
+    {
+      return P::round(l[i] - r[i]);
     }
 
-    /**
-     * @brief Soustrait directement un vecteur au vecteur courant
-     * @param v Le vecteur a soustraire au vecteur courant
-     */
-    Vector &operator-=(const Vector &v)
+    typename simd::Kernel<T, size>::packet packet() const
     {
-      for (int i = 0; i < size; ++i)
-        vec[i] = ROUND(vec[i] - v[i]);
+      return P::template round_packet<T, size>(simd::Kernel<T, size>::sub(l.packet(), r.packet()));
+    }
+  };
 
-      return (*this);
+  /**
+   * @class VectorNegation
+   * @brief Negation d'une expression
+   */
+  template<class E, class T, unsigned int size, class P>
+  class VectorNegation : public VectorExpr<VectorNegation<E, T, size, P>, T, size, P>
+  {
+  private:
+    typename VectorOperand<E>::type e;
+  public:
+    VectorNegation(const E &e) : e(e) {}
+
+    T operator[](int i) const
+    {
+      return -e[i];
     }
 
-    /**
-     * @brief Produit du vecteur courant avec un scalaire
-     * @param scalar Le scalaire a multiplier au vecteur courant
-     * @return Le vecteur resultant du produit
-     */
-    Vector operator*(const float scalar) const
+    typename simd::Kernel<T, size>::packet packet() const
     {
-      Vector v;
+      return simd::Kernel<T, size>::neg(e.packet());
+    }
+  };
 
-      for (int i = 0; i < size; ++i)
-      {
-        v[i] = ROUND(vec[i] * scalar);
-      }
+  /**
+   * @class VectorScale
+   * @brief Produit d'une expression avec un scalaire, arrondi selon la politique P
+   */
+  template<class E, class T, unsigned int size, class P>
+  class VectorScale : public VectorExpr<VectorScale<E, T, size, P>, T, size, P>
+  {
+  private:
+    typename VectorOperand<E>::type e;
+    float scalar;
+  public:
+    VectorScale(const E &e, const float scalar) : e(e), scalar(scalar) {}
 
-      return v;
+    T operator[](int i) const
+    {
+      return P::round(e[i] * scalar);
     }
 
-    /**
-     * @brief Produit scalaire du vecteur courant avec un autre vecteur
-     * @param v Le vecteur a multiplier au vecteur courant
-     * @return Le resultat du produit scalaire
-     */
-    T operator*(const Vector &v) const
+    typename simd::Kernel<T, size>::packet packet() const
     {
-      T somme = T();
+      return P::template round_packet<T, size>(simd::Kernel<T, size>::scale(e.packet(), scalar));
+    }
+  };
 
-      for (int i = 0; i < size; ++i)
-      {
-        somme += vec[i] * v[i];
-      }
+  /**
+   * @class VectorProduct
+   * @brief Produit composante par composante de deux expressions, arrondi selon
+   * la politique P
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  class VectorProduct : public VectorExpr<VectorProduct<L, R, T, size, P>, T, size, P>
+  {
+  private:
+    typename VectorOperand<L>::type l;
+    typename VectorOperand<R>::type r;
+  public:
+    VectorProduct(const L &l, const R &r) : l(l), r(r) {}
 
-      return somme;
+    T operator[](int i) const
+    {
+      return P::round(l[i] * r[i]);
     }
 
-    /**
-     * @see operator*(float scalar) 
-     */
-    friend Vector operator*(float scalar, Vector &v2)
+    typename simd::Kernel<T, size>::packet packet() const
     {
-      return v2 * scalar;
+      return P::template round_packet<T, size>(simd::Kernel<T, size>::mul(l.packet(), r.packet()));
     }
   };
 
-  template <class T, unsigned int size>
-  ostream &operator<<(ostream &s, const Vector<T, size> &v)
+  /**
+   * @brief Verifie l'egalite de deux vecteurs
+   * @param v1 Le premier vecteur
+   * @param v2 le vecteur avec lequel effectué la comparaison
+   * @return true si les deux vecteurs sont égaux, false sinon
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  bool operator==(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
   {
-    s << "(";
-    s << v[0];
+    for (int i = 0; i < size; ++i)
+      if (v1.self()[i] != v2.self()[i])
+        return false;
+    return true;
+  }
 
-    for (int i = 1; i < size; ++i)
-      s << ", " << v[i];
+  /**
+   * @brief Verifie l'inegalite de deux vecteurs
+   * @param v1 Le premier vecteur
+   * @param v2 le vecteur avec lequel effectue la comparaison
+   * @return true si les deux vecteurs sont inegaux, false sinon
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  bool operator!=(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
+  {
+    return !(v1 == v2);
+  }
 
-    s << ")";
+  /**
+   * @brief Additionne deux vecteurs
+   * @param v1 Le premier vecteur
+   * @param v2 Le vecteur a additionner
+   * @return L'expression de l'addition
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  VectorSum<L, R, T, size, P> operator+(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
+  {
+    return VectorSum<L, R, T, size, P>(v1.self(), v2.self());
+  }
 
-    return s;
+  /**
+   * @brief Soustrait un vecteur a un autre
+   * @param v1 Le premier vecteur
+   * @param v2 Le vecteur a soustraire
+   * @return L'expression de la soustraction
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  VectorDifference<L, R, T, size, P> operator-(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
+  {
+    return VectorDifference<L, R, T, size, P>(v1.self(), v2.self());
   }
 
-  template<class T, unsigned int size>
-  Vector<T, size> cross(const Vector<T, size> &v1, const Vector<T, size> &v2)
+  /**
+   * @brief Calcule la negation d'un vecteur
+   * @param v Le vecteur
+   * @return L'expression de la negation
+   */
+  template<class E, class T, unsigned int size, class P>
+  VectorNegation<E, T, size, P> operator-(const VectorExpr<E, T, size, P> &v)
   {
-    Vector<T, size> res;
+    return VectorNegation<E, T, size, P>(v.self());
+  }
 
-    if (size < MIN_ARGS_CROSS)
-      throw "The vector must have at least three arguments";
+  /**
+   * @brief Produit d'un vecteur avec un scalaire
+   * @param v Le vecteur
+   * @param scalar Le scalaire a multiplier au vecteur
+   * @return L'expression du produit
+   */
+  template<class E, class T, unsigned int size, class P>
+  VectorScale<E, T, size, P> operator*(const VectorExpr<E, T, size, P> &v, const float scalar)
+  {
+    return VectorScale<E, T, size, P>(v.self(), scalar);
+  }
 
-    res[0] = ROUND((v1[1] * v2[2]) - (v1[2] * v2[1]));
-    res[1] = ROUND((v1[2] * v2[0]) - (v1[0] * v2[2]));
-    res[2] = ROUND((v1[0] * v2[1]) - (v1[1] * v2[0]));
+  /**
+   * @see operator*(VectorExpr v, float scalar)
+   */
+  template<class E, class T, unsigned int size, class P>
+  VectorScale<E, T, size, P> operator*(const float scalar, const VectorExpr<E, T, size, P> &v)
+  {
+    return VectorScale<E, T, size, P>(v.self(), scalar);
+  }
 
-    return res;
+  /**
+   * @brief Produit scalaire de deux vecteurs
+   * @param v1 Le premier vecteur
+   * @param v2 Le vecteur a multiplier
+   * @return Le resultat du produit scalaire
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  T operator*(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
+  {
+    return VectorEvaluator<T, size>::dot(v1, v2);
   }
 
-  template<class T, unsigned int size>
-  Vector<T, size> dot(Vector<T, size> &vec, float scalar)
+  template <class T, unsigned int size, class P>
+  ostream &operator<<(ostream &s, const Vector<T, size, P> &v)
   {
-    Vector<T, size> v;
+    s << "(";
+    s << v[0];
 
-    for (int i = 0; i < size; ++i)
-    {
-      v[i] = ROUND(vec[i] * scalar);
-    }
+    for (int i = 1; i < size; ++i)
+      s << ", " << v[i];
 
-    return v;
+    s << ")";
+
+    return s;
   }
 
-  template<class T, unsigned int size>
-  T dot(const Vector<T, size> &vec, const Vector<T, size> &v)
+  template<class L, class R, class T, unsigned int size, class P>
+  Vector<T, size, P> cross(const VectorExpr<L, T, size, P> &v1, const VectorExpr<R, T, size, P> &v2)
   {
-    T somme = 0;
+    return Vector<T, size, P>(v1).cross(Vector<T, size, P>(v2));
+  }
 
-    for (int i = 0; i < size; ++i)
-    {
-      somme += ROUND(vec[i] * v[i]);
-    }
+  template<class T, unsigned int size, class P>
+  Vector<T, size, P> dot(Vector<T, size, P> &vec, float scalar)
+  {
+    return vec * scalar;
+  }
 
-    return somme;
+  /**
+   * @brief Produit scalaire, chaque produit etant arrondi selon la politique P
+   */
+  template<class L, class R, class T, unsigned int size, class P>
+  T dot(const VectorExpr<L, T, size, P> &vec, const VectorExpr<R, T, size, P> &v)
+  {
+    return VectorEvaluator<T, size>::sum(VectorProduct<L, R, T, size, P>(vec.self(), v.self()));
   }
 
-  template<class T, unsigned int size>
-  Vector<T, size> dot(float scalar, Vector<T, size> &v2)
+  template<class T, unsigned int size, class P>
+  Vector<T, size, P> dot(float scalar, Vector<T, size, P> &v2)
   {
     return v2 * scalar;
   }
 
+  /**
+   * @brief Normalise un tableau de vecteurs de dimension 3 en place, avec les
+   * fonctions de DefaultMath, puis arrondit les composantes selon la politique P
+   * @param v Le premier vecteur
+   * @param count Le nombre de vecteurs
+   */
+  template<class P>
+  void normalize(Vector<float, 3, P> *v, const std::size_t count)
+  {
+    DefaultMath::normalize(v->data(), count, sizeof(Vector<float, 3, P>) / sizeof(float));
+
+    for (std::size_t i = 0; i < count; ++i)
+      for (unsigned int j = 0; j < 3; ++j)
+        v[i][j] = P::round(v[i][j]);
+  }
+
   using Vec2i = Vector<int, 2>;
   using Vec3i = Vector<int, 3>;
   using Vec4i = Vector<int, 4>;
   using Vec2r = Vector<real, 2>;
   using Vec3r = Vector<real, 3>;
   using Vec4r = Vector<real, 4>;
+
+  static_assert(std::is_trivially_copyable<Vec3r>::value, "Vector must be trivially copyable");
+  static_assert(std::is_trivially_copyable<Vec4r>::value, "Vector must be trivially copyable");
+  static_assert(std::is_trivially_copyable<Vec3i>::value, "Vector must be trivially copyable");
 }
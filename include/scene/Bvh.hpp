@@ -0,0 +1,487 @@
+#pragma once
+
+#include "geometry/Sphere.hpp"
+#include "math/Dispatch.hpp"
+#include "scene/Frustum.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace scene
+{
+    /** @class Bvh
+     *
+     * Hierarchie de volumes englobants (boites alignees sur les axes) construite
+     * sur les spheres englobantes des objets d'une scene, pour le rejet par le
+     * champ de vision.
+     *
+     * La construction decoupe chaque noeud selon l'heuristique des surfaces (SAH)
+     * evaluee sur des intervalles (binning) le long de l'axe ou les centres sont
+     * les plus etales. Les objets d'un sous-arbre etant contigus, un sous-arbre
+     * entierement dans le champ de vision est accepte d'un coup ; un noeud
+     * entierement du cote interieur d'un plan ne le teste plus pour ses enfants.
+     */
+    class Bvh
+    {
+    public:
+        static constexpr std::size_t leafSize = 4; /**< Un noeud d'au plus leafSize objets n'est pas decoupe */
+        static constexpr unsigned int bins = 16; /**< Nombre d'intervalles evalues pour chaque decoupe */
+
+    private:
+        struct Node
+        {
+            float min[3]; /**< Coin minimal de la boite */
+            float max[3]; /**< Coin maximal de la boite */
+            std::uint32_t left; /**< Premier enfant (le second le suit), 0 pour une feuille */
+            std::uint32_t parent; /**< Parent, lui-meme pour la racine */
+            std::uint32_t begin; /**< Premier objet du sous-arbre, dans l'ordre de la hierarchie */
+            std::uint32_t end; /**< Fin des objets du sous-arbre */
+        };
+
+        struct Bin
+        {
+            float min[3];
+            float max[3];
+            std::size_t count;
+        };
+
+        std::vector<Node> nodes; /**< Noeuds, la racine en premier, les enfants apres leur parent */
+        std::vector<std::uint32_t> objects; /**< Index des objets, dans l'ordre de la hierarchie */
+        std::vector<std::uint32_t> leaves; /**< Feuille contenant chaque objet */
+        std::vector<float> soa; /**< Spheres dans l'ordre de la hierarchie : x, y, z, puis rayons */
+
+        std::size_t size() const
+        {
+            return objects.size();
+        }
+
+        float *x() { return soa.data(); }
+        float *y() { return soa.data() + size(); }
+        float *z() { return soa.data() + 2 * size(); }
+        float *radius() { return soa.data() + 3 * size(); }
+        const float *x() const { return soa.data(); }
+        const float *y() const { return soa.data() + size(); }
+        const float *z() const { return soa.data() + 2 * size(); }
+        const float *radius() const { return soa.data() + 3 * size(); }
+
+        static void empty(float *min, float *max)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                min[c] = std::numeric_limits<float>::max();
+                max[c] = -std::numeric_limits<float>::max();
+            }
+        }
+
+        static void grow(float *min, float *max, const float *otherMin, const float *otherMax)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                min[c] = std::min(min[c], otherMin[c]);
+                max[c] = std::max(max[c], otherMax[c]);
+            }
+        }
+
+        static float area(const float *min, const float *max)
+        {
+            const float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+            return dx < 0 ? 0 : dx * dy + dy * dz + dz * dx;
+        }
+
+        /** \brief Boite englobant la sphere d'un objet, a sa place dans la hierarchie
+         */
+        void box(const std::size_t i, float *min, float *max) const
+        {
+            const float c[3] = {x()[i], y()[i], z()[i]};
+
+            for (int k = 0; k < 3; ++k)
+            {
+                min[k] = c[k] - radius()[i];
+                max[k] = c[k] + radius()[i];
+            }
+        }
+
+        /** \brief Recalcule la boite d'un noeud a partir de ses enfants ou de ses objets
+         *
+         * \return true si la boite a change
+         */
+        bool fit(Node &node) const
+        {
+            float min[3], max[3];
+            empty(min, max);
+
+            if (node.left != 0)
+            {
+                grow(min, max, nodes[node.left].min, nodes[node.left].max);
+                grow(min, max, nodes[node.left + 1].min, nodes[node.left + 1].max);
+            }
+            else
+            {
+                for (std::size_t i = node.begin; i < node.end; ++i)
+                {
+                    float objectMin[3], objectMax[3];
+                    box(i, objectMin, objectMax);
+                    grow(min, max, objectMin, objectMax);
+                }
+            }
+
+            bool changed = false;
+            for (int c = 0; c < 3; ++c)
+            {
+                changed = changed || node.min[c] != min[c] || node.max[c] != max[c];
+                node.min[c] = min[c];
+                node.max[c] = max[c];
+            }
+            return changed;
+        }
+
+        /** \brief Cherche la meilleure decoupe d'un noeud selon l'heuristique des surfaces
+         *
+         * \param index Le noeud
+         * \param centers Les centres des spheres, ranges trois par trois dans l'ordre de la hierarchie
+         * \param axis L'axe de la decoupe
+         * \param split La position de la decoupe
+         * \return false si le noeud doit rester une feuille
+         */
+        bool bestSplit(const std::size_t index, const std::vector<float> &centers, int &axis, float &split) const
+        {
+            const Node &node = nodes[index];
+            const std::size_t count = node.end - node.begin;
+
+            float cmin[3], cmax[3];
+            empty(cmin, cmax);
+            for (std::size_t i = node.begin; i < node.end; ++i)
+                grow(cmin, cmax, &centers[3 * i], &centers[3 * i]);
+
+            axis = 0;
+            for (int c = 1; c < 3; ++c)
+                if (cmax[c] - cmin[c] > cmax[axis] - cmin[axis])
+                    axis = c;
+
+            const float extent = cmax[axis] - cmin[axis];
+            if (extent <= 0)
+                return false;
+
+            Bin bin[bins];
+            for (Bin &b : bin)
+            {
+                empty(b.min, b.max);
+                b.count = 0;
+            }
+
+            const float scale = bins / extent;
+            for (std::size_t i = node.begin; i < node.end; ++i)
+            {
+                const unsigned int b = std::min(bins - 1, (unsigned int) ((centers[3 * i + axis] - cmin[axis]) * scale));
+                float objectMin[3], objectMax[3];
+                box(i, objectMin, objectMax);
+                grow(bin[b].min, bin[b].max, objectMin, objectMax);
+                ++bin[b].count;
+            }
+
+            // Cout des decoupes entre l'intervalle b - 1 et b, de gauche a droite puis de droite a gauche
+            float rightCost[bins];
+            float min[3], max[3];
+            std::size_t n = 0;
+            empty(min, max);
+            for (unsigned int b = bins - 1; b > 0; --b)
+            {
+                grow(min, max, bin[b].min, bin[b].max);
+                n += bin[b].count;
+                rightCost[b] = n * area(min, max);
+            }
+
+            float best = std::numeric_limits<float>::max();
+            unsigned int bestBin = 0;
+            n = 0;
+            empty(min, max);
+            for (unsigned int b = 1; b < bins; ++b)
+            {
+                grow(min, max, bin[b - 1].min, bin[b - 1].max);
+                n += bin[b - 1].count;
+
+                const float cost = n * area(min, max) + rightCost[b];
+                if (n > 0 && n < count && cost < best)
+                {
+                    best = cost;
+                    bestBin = b;
+                }
+            }
+
+            // Une feuille coute un test par objet, une decoupe le test du noeud en plus de ceux des enfants
+            const float nodeArea = area(node.min, node.max);
+            if (bestBin == 0 || nodeArea + best >= count * nodeArea)
+                return false;
+
+            split = cmin[axis] + bestBin / scale;
+            return true;
+        }
+
+        /** \brief Partage les objets d'un noeud en deux moities autour du centre median
+         *
+         * Sert quand la position de la decoupe, arrondie en simple precision, laisse
+         * tous les objets du meme cote : chaque enfant a alors moins d'objets que
+         * son parent, meme si tous les centres sont confondus.
+         * \param index Le noeud
+         * \param centers Les centres des spheres, ranges trois par trois dans l'ordre de la hierarchie
+         * \param axis L'axe de la decoupe
+         * \return L'index du premier objet du second enfant
+         */
+        std::size_t median(const std::size_t index, std::vector<float> &centers, const int axis)
+        {
+            const std::size_t begin = nodes[index].begin, count = nodes[index].end - begin;
+            std::vector<std::size_t> order(count);
+            for (std::size_t k = 0; k < count; ++k)
+                order[k] = begin + k;
+            std::nth_element(order.begin(), order.begin() + count / 2, order.end(), [&](const std::size_t a, const std::size_t b) {
+                return centers[3 * a + axis] < centers[3 * b + axis];
+            });
+
+            const std::vector<std::uint32_t> oldObjects(objects.begin() + begin, objects.begin() + begin + count);
+            const std::vector<float> oldCenters(centers.begin() + 3 * begin, centers.begin() + 3 * (begin + count));
+            std::vector<float> oldSoa(4 * count);
+            for (int c = 0; c < 4; ++c)
+                std::copy(soa.begin() + c * size() + begin, soa.begin() + c * size() + begin + count, oldSoa.begin() + c * count);
+
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                const std::size_t from = order[k] - begin;
+                objects[begin + k] = oldObjects[from];
+                for (int c = 0; c < 4; ++c)
+                    soa[c * size() + begin + k] = oldSoa[c * count + from];
+                for (int c = 0; c < 3; ++c)
+                    centers[3 * (begin + k) + c] = oldCenters[3 * from + c];
+            }
+
+            return begin + count / 2;
+        }
+
+        /** \brief Construit le sous-arbre d'un noeud dont les objets sont deja places
+         */
+        void build(const std::size_t index, std::vector<float> &centers)
+        {
+            fit(nodes[index]);
+
+            int axis;
+            float split;
+            if (nodes[index].end - nodes[index].begin <= leafSize || !bestSplit(index, centers, axis, split))
+                return;
+
+            // Partition des objets, de leurs spheres et de leurs centres autour de la decoupe
+            std::size_t i = nodes[index].begin, j = nodes[index].end;
+            while (i < j)
+            {
+                if (centers[3 * i + axis] < split)
+                    ++i;
+                else
+                {
+                    --j;
+                    std::swap(objects[i], objects[j]);
+                    for (int c = 0; c < 4; ++c)
+                        std::swap(soa[c * size() + i], soa[c * size() + j]);
+                    for (int c = 0; c < 3; ++c)
+                        std::swap(centers[3 * i + c], centers[3 * j + c]);
+                }
+            }
+            if (i == nodes[index].begin || i == nodes[index].end)
+                i = median(index, centers, axis);
+
+            const std::uint32_t left = nodes.size();
+            Node child = nodes[index];
+            child.left = 0;
+            child.parent = index;
+
+            child.end = i;
+            nodes.push_back(child);
+            child.begin = i;
+            child.end = nodes[index].end;
+            nodes.push_back(child);
+            nodes[index].left = left;
+
+            build(left, centers);
+            build(left + 1, centers);
+        }
+
+        /** \brief Ajoute les objets de la hierarchie d'index begin a end
+         */
+        void accept(const std::size_t begin, const std::size_t end, std::vector<std::size_t> &visible) const
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                visible.push_back(objects[i]);
+        }
+
+    public:
+        /** \brief Construit une hierarchie vide
+         */
+        Bvh()
+        {
+        }
+
+        /** \brief Construit la hierarchie
+         *
+         * \param bounds Les spheres englobantes des objets
+         * \param count Le nombre d'objets
+         */
+        Bvh(const Sphere<real> *bounds, const std::size_t count)
+        {
+            build(bounds, count);
+        }
+
+        /** \brief Reconstruit la hierarchie
+         *
+         * \param bounds Les spheres englobantes des objets
+         * \param count Le nombre d'objets
+         */
+        void build(const Sphere<real> *bounds, const std::size_t count)
+        {
+            nodes.clear();
+            objects.resize(count);
+            leaves.resize(count);
+            soa.resize(4 * count);
+
+            std::vector<float> centers(3 * count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Point<real, 3> c = bounds[i].getCenter();
+                objects[i] = i;
+                for (int k = 0; k < 3; ++k)
+                    soa[k * count + i] = centers[3 * i + k] = c[k];
+                soa[3 * count + i] = bounds[i].getRadius();
+            }
+
+            if (count == 0)
+                return;
+
+            nodes.push_back(Node{{0, 0, 0}, {0, 0, 0}, 0, 0, 0, std::uint32_t(count)});
+            build(0, centers);
+
+            for (std::size_t n = 0; n < nodes.size(); ++n)
+                if (nodes[n].left == 0)
+                    for (std::size_t i = nodes[n].begin; i < nodes[n].end; ++i)
+                        leaves[objects[i]] = n;
+        }
+
+        /** \brief Retourne le nombre d'objets de la hierarchie
+         */
+        std::size_t num_objects() const
+        {
+            return size();
+        }
+
+        /** \brief Retourne le nombre de noeuds de la hierarchie
+         */
+        std::size_t num_nodes() const
+        {
+            return nodes.size();
+        }
+
+        /** \brief Met a jour la sphere englobante d'un objet qui s'est deplace
+         *
+         * Seules les boites de la feuille de l'objet et de ses ancetres sont
+         * recalculees, en s'arretant au premier ancetre inchange. La structure de
+         * l'arbre est conservee : apres de grands deplacements, build() retrouve
+         * une hierarchie efficace.
+         * \param object L'index de l'objet
+         * \param bound Sa nouvelle sphere englobante
+         */
+        void refit(const std::size_t object, const Sphere<real> &bound)
+        {
+            if (object >= size())
+                throw std::out_of_range("No such object");
+
+            std::size_t node = leaves[object];
+            const std::size_t i = std::find(objects.begin() + nodes[node].begin, objects.begin() + nodes[node].end, object) - objects.begin();
+            const Point<real, 3> c = bound.getCenter();
+
+            x()[i] = c[0];
+            y()[i] = c[1];
+            z()[i] = c[2];
+            radius()[i] = bound.getRadius();
+
+            while (fit(nodes[node]) && node != 0)
+                node = nodes[node].parent;
+        }
+
+        /** \brief Determine les objets dont la sphere englobante n'est pas en dehors du champ de vision
+         *
+         * Le resultat est celui de Frustum::outside sur toutes les spheres, aux
+         * arrondis pres pour une sphere tangente a un plan ; les feuilles sont
+         * testees par le noyau choisi a l'execution (math::dispatch), sur les
+         * seuls plans qui ne contiennent pas deja la feuille.
+         * \param f Le champ de vision
+         * \param visible Les index des objets visibles, remplace
+         */
+        void cull(const Frustum &f, std::vector<std::size_t> &visible) const
+        {
+            visible.clear();
+            if (nodes.empty())
+                return;
+
+            float eq[24];
+            f.equations(eq);
+
+            std::vector<std::pair<std::uint32_t, unsigned int>> stack(1, std::make_pair(0u, 0x3fu));
+            std::uint8_t outside[64];
+            float active[24];
+
+            while (!stack.empty())
+            {
+                const Node &node = nodes[stack.back().first];
+                unsigned int mask = stack.back().second;
+                stack.pop_back();
+
+                bool rejected = false;
+                for (int k = 0; k < 6 && !rejected; ++k)
+                {
+                    if (!(mask & (1u << k)))
+                        continue;
+
+                    // Sommets de la boite les plus loin et les plus pres du cote interieur
+                    const float *e = eq + 4 * k;
+                    float farthest = e[3], nearest = e[3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        farthest += e[c] * (e[c] > 0 ? node.max[c] : node.min[c]);
+                        nearest += e[c] * (e[c] > 0 ? node.min[c] : node.max[c]);
+                    }
+
+                    rejected = farthest < 0;
+                    if (nearest >= 0)
+                        mask &= ~(1u << k);
+                }
+
+                if (rejected)
+                    continue;
+
+                if (mask == 0)
+                    accept(node.begin, node.end, visible);
+                else if (node.left != 0)
+                {
+                    stack.push_back(std::make_pair(node.left + 1, mask));
+                    stack.push_back(std::make_pair(node.left, mask));
+                }
+                else
+                {
+                    std::size_t planeCount = 0;
+                    for (int k = 0; k < 6; ++k)
+                        if (mask & (1u << k))
+                            std::copy(eq + 4 * k, eq + 4 * k + 4, active + 4 * planeCount++);
+
+                    for (std::size_t first = node.begin; first < node.end; first += sizeof(outside))
+                    {
+                        const std::size_t count = std::min<std::size_t>(node.end - first, sizeof(outside));
+                        math::dispatch::kernels().spheres_outside(active, planeCount, x() + first, y() + first, z() + first,
+                                                                  radius() + first, outside, count);
+                        for (std::size_t i = 0; i < count; ++i)
+                            if (!outside[i])
+                                visible.push_back(objects[first + i]);
+                    }
+                }
+            }
+        }
+    };
+}
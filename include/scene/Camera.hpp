@@ -9,6 +9,8 @@
 #include "geometry/Triangle.hpp"
 
 #include "scene/Frustum.hpp"
+#include "scene/Bvh.hpp"
+#include "scene/LooseOctree.hpp"
 
 constexpr real nearPlaneDistance = -1;
 
@@ -105,7 +107,7 @@ public:
      * @param q
      */
     void turn(const Quaternion<real> &q) {
-        _actualRotSpeed += q;
+        _actualRotSpeed = q * _actualRotSpeed;
     }
 
     /**
@@ -163,6 +165,97 @@ public:
         return _fieldOfView.outside(s);
     }
 
+    /**
+     * @brief Verifie d'un coup si des spheres sont en dehors du champ de vision
+     * @param spheres Les spheres a tester
+     * @param count Le nombre de spheres
+     * @param result result[i] vaut 1 si la sphere i est en dehors du champ de vision, 0 sinon
+     */
+    void outsideFrustum(const Sphere<real> *spheres, size_t count, std::uint8_t *result) const {
+        _fieldOfView.outside(spheres, count, result);
+    }
+
+    /**
+     * @brief Verifie si une boite alignee est en dehors du champ de vision
+     * @param b La boite a tester
+     * @return true si la boite est entierement derriere l'un des plans du champ de vision
+     */
+    bool outsideFrustum(const AABB<real> &b) const {
+        return _fieldOfView.outside(b);
+    }
+
+    /**
+     * @brief Verifie si une boite orientee est en dehors du champ de vision
+     * @param b La boite a tester
+     * @return true si la boite est entierement derriere l'un des plans du champ de vision
+     */
+    bool outsideFrustum(const OBB<real> &b) const {
+        return _fieldOfView.outside(b);
+    }
+
+    /**
+     * @brief Verifie d'un coup si des boites alignees sont en dehors du champ de vision
+     * @param boxes Les boites a tester
+     * @param count Le nombre de boites
+     * @param result result[i] vaut 1 si la boite i est en dehors du champ de vision, 0 sinon
+     */
+    void outsideFrustum(const AABB<real> *boxes, size_t count, std::uint8_t *result) const {
+        _fieldOfView.outside(boxes, count, result);
+    }
+
+    /**
+     * @brief Verifie d'un coup si des boites orientees sont en dehors du champ de vision
+     * @param boxes Les boites a tester
+     * @param count Le nombre de boites
+     * @param result result[i] vaut 1 si la boite i est en dehors du champ de vision, 0 sinon
+     */
+    void outsideFrustum(const OBB<real> *boxes, size_t count, std::uint8_t *result) const {
+        _fieldOfView.outside(boxes, count, result);
+    }
+
+    /**
+     * @brief Determine les objets d'une hierarchie de volumes englobants qui ne
+     * sont pas en dehors du champ de vision
+     * @param objects La hierarchie construite sur les spheres englobantes des objets
+     * @param visible Les index des objets visibles
+     */
+    void visibleObjects(const Bvh &objects, std::vector<std::size_t> &visible) const {
+        objects.cull(_fieldOfView, visible);
+    }
+
+    /**
+     * @brief Determine les objets d'un octree lache qui ne sont pas en dehors
+     * du champ de vision
+     * @param objects L'octree indexant les spheres englobantes des objets
+     * @param visible Les index des objets visibles
+     */
+    void visibleObjects(const LooseOctree &objects, std::vector<std::size_t> &visible) const {
+        objects.cull(_fieldOfView, visible);
+    }
+
+    /**
+     * @brief Exprime le champ de vision dans le repere local d'un objet, pour
+     * tester ses donnees non transformees
+     * @param world La transformation du repere local de l'objet vers le repere du monde
+     * @return Le champ de vision dans le repere local
+     */
+    Frustum localFrustum(const Affine3x4<real> &world) const {
+        return _fieldOfView.local(world);
+    }
+
+    /**
+     * @brief Verifie si les instances d'un objet sont en dehors du champ de vision,
+     * la sphere englobante partagee etant testee dans le repere local de chacune
+     * @param bound La sphere englobante de l'objet, dans son repere local
+     * @param worlds La transformation monde de chaque instance
+     * @param count Le nombre d'instances
+     * @param result result[i] vaut 1 si l'instance i est en dehors du champ de vision, 0 sinon
+     */
+    void outsideFrustum(const Sphere<real> &bound, const Affine3x4<real> *worlds, size_t count, std::uint8_t *result) const {
+        for (size_t i = 0; i < count; ++i)
+            result[i] = _fieldOfView.local(worlds[i]).outside(bound);
+    }
+
     /**
      * @brief
      * @param t
@@ -182,6 +275,41 @@ public:
         return _fieldOfView.inter(ls);
     }
 
+    /**
+     * @brief Calcule d'un coup la partie visible de segments
+     * @param segments Les segments a decouper
+     * @param result Les parties visibles ; les segments invisibles sont omis
+     */
+    void visible_parts(const std::vector<LineSegment<real, 3>> &segments, std::vector<LineSegment<real, 3>> &result) const {
+        _fieldOfView.clip(segments, result);
+    }
+
+    /**
+     * @brief Projette des segments sur l'ecran, (-focale / z) * x et (-focale / z) * y,
+     * avec le noyau choisi a l'execution (math::dispatch)
+     * @param segments Les segments a projeter
+     * @param result Les segments projetes, dans le meme ordre
+     */
+    void project(const std::vector<LineSegment<real, 3>> &segments, std::vector<LineSegment<real, 2>> &result) const {
+        const size_t count = 2 * segments.size();
+
+        std::vector<real> soa(5 * count);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const Point<real, 3> b = segments[i].get_begin(), e = segments[i].get_end();
+            for (int c = 0; c < 3; ++c) {
+                soa[c * count + 2 * i] = b[c];
+                soa[c * count + 2 * i + 1] = e[c];
+            }
+        }
+
+        real *x = soa.data() + 3 * count, *y = soa.data() + 4 * count;
+        math::dispatch::kernels().project(_focalLength, soa.data(), soa.data() + count, soa.data() + 2 * count, x, y, count);
+
+        result.clear();
+        for (size_t i = 0; i < segments.size(); ++i)
+            result.push_back(LineSegment<real, 2>(Point<real, 2>{x[2 * i], y[2 * i]}, Point<real, 2>{x[2 * i + 1], y[2 * i + 1]}));
+    }
+
     /**
      * @brief
      */
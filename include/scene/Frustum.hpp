@@ -2,11 +2,21 @@
 
 #include "geometry/Point.hpp"
 #include "geometry/Sphere.hpp"
+#include "geometry/AABB.hpp"
+#include "geometry/OBB.hpp"
 #include "geometry/Plane.hpp"
 #include "geometry/LineSegment.hpp"
+#include "geometry/Affine3x4.hpp"
+#include "math/Dispatch.hpp"
+#include "math/Packet.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 using namespace geometry;
 
@@ -28,8 +38,35 @@ private:
     Plane<real> _right; /**< Plan de droite */
     Plane<real> _top; /**< Plan du haut */
     Plane<real> _bottom; /**< Plan du bas */
+    real _lanes[4][8]; /**< Coefficients des equations, un plan par voie, pour packet() */
+
+    /**
+     * @brief Range les coefficients des six plans dans les voies de _lanes, les
+     * deux voies restantes recevant un plan sans normale, devant lequel tout se trouve
+     */
+    void fillLanes() {
+        const Plane<real> *planes[] = {&_near, &_far, &_left, &_right, &_top, &_bottom};
+
+        for (int c = 0; c < 4; ++c) {
+            for (int k = 0; k < 6; ++k)
+                _lanes[c][k] = planes[k]->GetEquation()[c];
+            _lanes[c][6] = _lanes[c][7] = c == 3 ? std::numeric_limits<real>::max() : 0;
+        }
+    }
 
 public:
+    /**
+     * @brief Range les equations des six plans, quatre coefficients par plan,
+     * pour les noyaux de math::dispatch
+     */
+    void equations(float *eq) const {
+        const Plane<real> *planes[] = {&_near, &_far, &_left, &_right, &_top, &_bottom};
+
+        for (int k = 0; k < 6; ++k)
+            for (int c = 0; c < 4; ++c)
+                eq[4 * k + c] = planes[k]->GetEquation()[c];
+    }
+
     /**
      * @brief Construit un champ de vision a l'aide de ses six plans
      * @param near Le plan proche
@@ -41,26 +78,29 @@ public:
      */
     Frustum(const Plane<real> &near, const Plane<real> &far, const Plane<real> &left, const Plane<real> &right, const Plane<real> &top, const Plane<real> &bottom) :
         _near(near), _far(far), _left(left), _right(right), _top(top), _bottom(bottom) {
+        fillLanes();
     }
 
-    /**
-     * @brief Constructeur par recopie
-     * @param f Le frustum a recopier
-     */
-    Frustum(const Frustum &f) : _near(f._near), _far(f._far), _left(f._left), _right(f._right), _top(f._top), _bottom(f._bottom) {
-    }
-    
     /**
      * @brief Constructeur par défaut 
      */
-    Frustum()
+    constexpr Frustum() : _lanes{}
     {
     }
 
     /**
-     * @brief Destructeur
+     * @brief Exprime le champ de vision dans le repere local d'un objet
+     *
+     * Les tests d'un objet place par world contre le champ de vision peuvent
+     * alors porter sur ses sommets et ses volumes englobants non transformes,
+     * partages par toutes ses instances : six plans sont transformes par
+     * instance au lieu de chacun de ses sommets.
+     * @param world La transformation du repere local de l'objet vers le repere du monde
+     * @return Le champ de vision dans le repere local
      */
-    ~Frustum() {
+    Frustum local(const Affine3x4<real> &world) const {
+        return Frustum(world.inverseTransform(_near), world.inverseTransform(_far), world.inverseTransform(_left),
+                       world.inverseTransform(_right), world.inverseTransform(_top), world.inverseTransform(_bottom));
     }
 
     /**
@@ -81,6 +121,177 @@ public:
                s.behind(_right) || s.behind(_top) || s.behind(_bottom);
     }
 
+    /**
+     * @brief Verifie d'un coup si des spheres sont en dehors du champ de vision
+     *
+     * Le test est fait par le noyau choisi a l'execution (math::dispatch). Une
+     * sphere n'est en dehors que si elle est entierement derriere l'un des plans.
+     * @param spheres Les spheres a tester
+     * @param count Le nombre de spheres
+     * @param result result[i] vaut 1 si la sphere i est en dehors du champ de vision, 0 sinon
+     */
+    void outside(const Sphere<real> *spheres, const std::size_t count, std::uint8_t *result) const {
+        float eq[24];
+        equations(eq);
+
+        std::vector<float> soa(4 * count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Point<real, 3> c = spheres[i].getCenter();
+            soa[i] = c[0];
+            soa[count + i] = c[1];
+            soa[2 * count + i] = c[2];
+            soa[3 * count + i] = spheres[i].getRadius();
+        }
+
+        math::dispatch::kernels().spheres_outside(eq, 6, soa.data(), soa.data() + count, soa.data() + 2 * count,
+                                                  soa.data() + 3 * count, result, count);
+    }
+
+    /**
+     * @brief Range les six plans dans les voies d'un paquet, pour tester un
+     * volume contre tous les plans a la fois
+     *
+     * Les voies sont preparees a la construction : le paquet ne coute que
+     * quatre chargements.
+     */
+    math::PlanePacket<real, 8> packet() const {
+        typedef math::Packet<real, 8> packet;
+
+        return math::PlanePacket<real, 8>(math::Vec3Packet<real, 8>(packet::loadu(_lanes[0]), packet::loadu(_lanes[1]), packet::loadu(_lanes[2])),
+                                          packet::loadu(_lanes[3]));
+    }
+
+    /**
+     * @brief Verifie si une boite alignee est en dehors de plans ranges par packet()
+     *
+     * La boite est en dehors si son centre est derriere l'un des plans d'une
+     * distance superieure a la projection de ses demi-cotes sur la normale.
+     * @param planes Les plans du champ de vision
+     * @param b La boite a tester
+     * @return true si la boite est entierement derriere l'un des plans
+     */
+    static bool outside(const math::PlanePacket<real, 8> &planes, const AABB<real> &b) {
+        typedef math::Packet<real, 8> packet;
+        const math::Vector<real, 3> &e = b.getExtent();
+
+        const packet distance = planes.distance(math::Vec3Packet<real, 8>(b.getCenter()));
+        const packet reach = madd(abs(planes.normal.x), packet(e[0]),
+                                  madd(abs(planes.normal.y), packet(e[1]), abs(planes.normal.z) * packet(e[2])));
+        return (distance < -reach).any();
+    }
+
+    /**
+     * @brief Verifie si une boite orientee est en dehors de plans ranges par packet()
+     *
+     * La projection des demi-cotes sur la normale d'un plan est la somme des
+     * demi-cotes ponderes par la valeur absolue du cosinus de leur axe.
+     * @param planes Les plans du champ de vision
+     * @param b La boite a tester
+     * @return true si la boite est entierement derriere l'un des plans
+     */
+    static bool outside(const math::PlanePacket<real, 8> &planes, const OBB<real> &b) {
+        typedef math::Packet<real, 8> packet;
+        const math::Vector<real, 3> &e = b.getExtent();
+
+        packet reach(real(0));
+        for (unsigned int a = 0; a < 3; ++a) {
+            const Direction<real, 3> &u = b.getAxis(a);
+            const packet cosine = madd(planes.normal.x, packet(u[0]), madd(planes.normal.y, packet(u[1]), planes.normal.z * packet(u[2])));
+            reach = madd(abs(cosine), packet(e[a]), reach);
+        }
+
+        const packet distance = planes.distance(math::Vec3Packet<real, 8>(b.getCenter()));
+        return (distance < -reach).any();
+    }
+
+    /**
+     * @brief Verifie si une boite alignee est en dehors du champ de vision
+     * @return true si la boite est entierement derriere l'un des plans
+     */
+    bool outside( const AABB<real> & b) const {
+        return outside(packet(), b);
+    }
+
+    /**
+     * @brief Verifie si une boite orientee est en dehors du champ de vision
+     * @return true si la boite est entierement derriere l'un des plans
+     */
+    bool outside( const OBB<real> & b) const {
+        return outside(packet(), b);
+    }
+
+    /**
+     * @brief Verifie d'un coup si des boites alignees sont en dehors du champ de vision
+     * @param boxes Les boites a tester
+     * @param count Le nombre de boites
+     * @param result result[i] vaut 1 si la boite i est en dehors du champ de vision, 0 sinon
+     */
+    void outside(const AABB<real> *boxes, const std::size_t count, std::uint8_t *result) const {
+        const math::PlanePacket<real, 8> planes = packet();
+
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = outside(planes, boxes[i]);
+    }
+
+    /**
+     * @brief Verifie d'un coup si des boites orientees sont en dehors du champ de vision
+     * @param boxes Les boites a tester
+     * @param count Le nombre de boites
+     * @param result result[i] vaut 1 si la boite i est en dehors du champ de vision, 0 sinon
+     */
+    void outside(const OBB<real> *boxes, const std::size_t count, std::uint8_t *result) const {
+        const math::PlanePacket<real, 8> planes = packet();
+
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = outside(planes, boxes[i]);
+    }
+
+    /**
+     * @brief Calcule d'un coup la partie visible de segments
+     *
+     * Le decoupage est fait par le noyau choisi a l'execution (math::dispatch).
+     * @param segments Les segments a decouper
+     * @param result Les parties visibles, dans l'ordre ; les segments entierement
+     * en dehors du champ de vision sont omis
+     */
+    void clip(const std::vector<LineSegment<real, 3>> &segments, std::vector<LineSegment<real, 3>> &result) const {
+        const std::size_t count = segments.size();
+        float eq[24];
+        equations(eq);
+
+        std::vector<float> soa(8 * count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Point<real, 3> b = segments[i].get_begin(), e = segments[i].get_end();
+            for (int c = 0; c < 3; ++c) {
+                soa[c * count + i] = b[c];
+                soa[(3 + c) * count + i] = e[c];
+            }
+        }
+
+        float *t0 = soa.data() + 6 * count, *t1 = soa.data() + 7 * count;
+        math::dispatch::kernels().clip_segments(eq, 6, soa.data(), soa.data() + count, soa.data() + 2 * count,
+                                                soa.data() + 3 * count, soa.data() + 4 * count, soa.data() + 5 * count,
+                                                t0, t1, count);
+
+        result.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (t0[i] > t1[i])
+                continue;
+
+            const Point<real, 3> b = segments[i].get_begin(), e = segments[i].get_end();
+            Point<real, 3> first = b, last = e;
+            for (int c = 0; c < 3; ++c) {
+                // Les extremites conservees sont recopiees telles quelles
+                if (t0[i] > 0)
+                    first[c] = b[c] + t0[i] * (e[c] - b[c]);
+                if (t1[i] < 1)
+                    last[c] = b[c] + t1[i] * (e[c] - b[c]);
+            }
+
+            result.push_back(LineSegment<real, 3>(first, last));
+        }
+    }
+
     /**
      * @brief Retourne l'intersection du segment avec le champ de vision
      * @return l'intersection du segment avec le champ de vision
@@ -289,4 +500,6 @@ public:
         return out;
     }
 };
+
+static_assert(std::is_trivially_copyable<Frustum>::value, "Frustum must be trivially copyable");
 }
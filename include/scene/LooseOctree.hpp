@@ -0,0 +1,458 @@
+#pragma once
+
+#include "geometry/Point.hpp"
+#include "geometry/Direction.hpp"
+#include "geometry/Sphere.hpp"
+#include "scene/Frustum.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace scene
+{
+    /** @class LooseOctree
+     *
+     * Octree lache indexant les spheres englobantes d'objets qui se deplacent.
+     *
+     * Chaque cellule de demi-cote h a une boite lache de demi-cote 2h : un objet
+     * de rayon r <= h dont le centre est dans la cellule tient dans sa boite. La
+     * profondeur d'un objet ne depend donc que de son rayon et sa cellule que de
+     * son centre, ce qui donne une insertion, une suppression et un deplacement
+     * en temps constant (la profondeur etant bornee), sans reequilibrage ; un
+     * objet deplace reste dans sa cellule tant que sa boite lache le contient.
+     * Les objets dont le centre sort du monde sont ranges a la racine, toujours testee.
+     *
+     * Les cellules videes ne sont pas liberees mais ignorees par les requetes,
+     * grace au nombre d'objets de leur sous-arbre.
+     */
+    class LooseOctree
+    {
+    public:
+        static constexpr std::uint32_t none = std::uint32_t(-1); /**< Cellule d'un objet absent */
+
+    private:
+        struct Node
+        {
+            float center[3]; /**< Centre de la cellule */
+            float half; /**< Demi-cote de la cellule, la boite lache ayant le double */
+            unsigned int level; /**< Profondeur de la cellule */
+            std::uint32_t parent; /**< Parent, none pour la racine */
+            std::uint32_t children[8]; /**< Enfants, 0 si absents (la racine n'est l'enfant de personne) */
+            std::size_t count; /**< Nombre d'objets du sous-arbre */
+            std::vector<std::uint32_t> objects; /**< Objets ranges dans la cellule */
+        };
+
+        struct Entry
+        {
+            float sphere[4]; /**< Centre et rayon de la sphere englobante */
+            std::uint32_t node; /**< Cellule de l'objet, none s'il est absent */
+            std::uint32_t slot; /**< Position de l'objet dans la cellule */
+        };
+
+        std::vector<Node> nodes; /**< Cellules, la racine en premier */
+        std::vector<Entry> entries; /**< Objets, par index */
+        unsigned int depth; /**< Profondeur maximale */
+        std::size_t size_; /**< Nombre d'objets indexes */
+
+        static void entry(const Sphere<real> &s, Entry &e)
+        {
+            const Point<real, 3> c = s.getCenter();
+            e.sphere[0] = c[0];
+            e.sphere[1] = c[1];
+            e.sphere[2] = c[2];
+            e.sphere[3] = s.getRadius();
+        }
+
+        /** \brief Profondeur la plus grande dont les cellules ont un demi-cote au moins egal au rayon
+         */
+        unsigned int level(const float radius) const
+        {
+            if (!(radius > 0))
+                return depth;
+            return std::min<float>(depth, std::max(0.f, std::floor(std::log2(nodes[0].half / radius))));
+        }
+
+        /** \brief Indique si une sphere peut rester dans une cellule : sa profondeur
+         * est celle de la sphere et sa boite lache la contient
+         */
+        bool fits(const Node &n, const float *sphere) const
+        {
+            if (n.level == 0 || n.level != level(sphere[3]))
+                return false;
+
+            for (int c = 0; c < 3; ++c)
+                if (std::fabs(sphere[c] - n.center[c]) + sphere[3] > 2 * n.half)
+                    return false;
+            return true;
+        }
+
+        /** \brief Trouve, en la creant au besoin, la cellule d'une sphere
+         */
+        std::uint32_t cell(const float *sphere)
+        {
+            const Node &root = nodes[0];
+            const float world = root.half;
+            const unsigned int d = level(sphere[3]);
+
+            unsigned int coords[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                const float p = (sphere[c] - (root.center[c] - world)) / (2 * world);
+                if (!(p >= 0 && p < 1))
+                    return 0;
+                coords[c] = std::min((1u << d) - 1, (unsigned int) (p * (1u << d)));
+            }
+
+            std::uint32_t node = 0;
+            for (unsigned int bit = d; bit-- > 0;)
+            {
+                const unsigned int child = ((coords[0] >> bit) & 1) | (((coords[1] >> bit) & 1) << 1) | (((coords[2] >> bit) & 1) << 2);
+
+                if (nodes[node].children[child] == 0)
+                {
+                    Node n;
+                    n.half = nodes[node].half * 0.5f;
+                    n.level = nodes[node].level + 1;
+                    for (int c = 0; c < 3; ++c)
+                        n.center[c] = nodes[node].center[c] + (child & (1 << c) ? n.half : -n.half);
+                    n.parent = node;
+                    std::fill(n.children, n.children + 8, 0);
+                    n.count = 0;
+
+                    nodes.push_back(n);
+                    nodes[node].children[child] = nodes.size() - 1;
+                }
+                node = nodes[node].children[child];
+            }
+            return node;
+        }
+
+        void link(const std::size_t object, const std::uint32_t node)
+        {
+            Entry &e = entries[object];
+            e.node = node;
+            e.slot = nodes[node].objects.size();
+            nodes[node].objects.push_back(object);
+
+            for (std::uint32_t n = node; n != none; n = nodes[n].parent)
+                ++nodes[n].count;
+        }
+
+        void unlink(const std::size_t object)
+        {
+            Entry &e = entries[object];
+            std::vector<std::uint32_t> &objects = nodes[e.node].objects;
+
+            objects[e.slot] = objects.back();
+            entries[objects.back()].slot = e.slot;
+            objects.pop_back();
+
+            for (std::uint32_t n = e.node; n != none; n = nodes[n].parent)
+                --nodes[n].count;
+            e.node = none;
+        }
+
+        Entry &find(const std::size_t object)
+        {
+            if (!contains(object))
+                throw std::out_of_range("No such object");
+            return entries[object];
+        }
+
+        /** \brief Distance au carre d'un point a la boite lache d'une cellule
+         */
+        static float distance2(const Node &n, const float *p)
+        {
+            float d2 = 0;
+            for (int c = 0; c < 3; ++c)
+            {
+                const float d = std::max(0.f, std::fabs(p[c] - n.center[c]) - 2 * n.half);
+                d2 += d * d;
+            }
+            return d2;
+        }
+
+        /** \brief Indique si une demi-droite rencontre la boite lache d'une cellule
+         */
+        static bool hits(const Node &n, const float *origin, const float *inverse)
+        {
+            float enter = 0, leave = std::numeric_limits<float>::max();
+            for (int c = 0; c < 3; ++c)
+            {
+                float t0 = (n.center[c] - 2 * n.half - origin[c]) * inverse[c];
+                float t1 = (n.center[c] + 2 * n.half - origin[c]) * inverse[c];
+                if (t0 > t1)
+                    std::swap(t0, t1);
+
+                // Rayon parallele aux faces : 0 * inf donne NaN, le rayon passe si l'origine est entre les faces
+                if (t0 != t0 || t1 != t1)
+                {
+                    if (std::fabs(origin[c] - n.center[c]) > 2 * n.half)
+                        return false;
+                    continue;
+                }
+                enter = std::max(enter, t0);
+                leave = std::min(leave, t1);
+            }
+            return enter <= leave;
+        }
+
+    public:
+        /** \brief Construit un octree vide
+         *
+         * \param center Le centre du monde
+         * \param half Le demi-cote du monde
+         * \param depth La profondeur maximale des cellules, a choisir pour que les plus
+         * profondes contiennent quelques objets : des cellules trop fines allongent les requetes
+         */
+        LooseOctree(const Point<real, 3> &center, const real half, const unsigned int depth = 8) : depth(std::min(depth, 20u)), size_(0)
+        {
+            if (!(half > 0))
+                throw std::invalid_argument("The world must not be empty");
+
+            Node root;
+            for (int c = 0; c < 3; ++c)
+                root.center[c] = center[c];
+            root.half = half;
+            root.level = 0;
+            root.parent = none;
+            std::fill(root.children, root.children + 8, 0);
+            root.count = 0;
+            nodes.push_back(root);
+        }
+
+        /** \brief Retourne le nombre d'objets indexes
+         */
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        /** \brief Retourne le nombre de cellules creees
+         */
+        std::size_t num_nodes() const
+        {
+            return nodes.size();
+        }
+
+        /** \brief Indique si un objet est indexe
+         *
+         * \param object L'index de l'objet
+         */
+        bool contains(const std::size_t object) const
+        {
+            return object < entries.size() && entries[object].node != none;
+        }
+
+        /** \brief Indexe un objet
+         *
+         * \param object L'index de l'objet, choisi par l'appelant
+         * \param bound Sa sphere englobante
+         */
+        void insert(const std::size_t object, const Sphere<real> &bound)
+        {
+            if (contains(object))
+                throw std::invalid_argument("Object already indexed");
+
+            if (object >= entries.size())
+            {
+                Entry e;
+                e.node = none;
+                entries.resize(object + 1, e);
+            }
+
+            entry(bound, entries[object]);
+            link(object, cell(entries[object].sphere));
+            ++size_;
+        }
+
+        /** \brief Retire un objet de l'index
+         *
+         * \param object L'index de l'objet
+         */
+        void remove(const std::size_t object)
+        {
+            find(object);
+            unlink(object);
+            --size_;
+        }
+
+        /** \brief Deplace un objet, qui ne change de cellule que s'il sort de sa boite lache
+         *
+         * \param object L'index de l'objet
+         * \param bound Sa nouvelle sphere englobante
+         */
+        void move(const std::size_t object, const Sphere<real> &bound)
+        {
+            Entry &e = find(object);
+            entry(bound, e);
+            if (fits(nodes[e.node], e.sphere))
+                return;
+
+            const std::uint32_t node = cell(e.sphere);
+            if (node != e.node)
+            {
+                unlink(object);
+                link(object, node);
+            }
+        }
+
+        /** \brief Obtient la sphere englobante d'un objet
+         *
+         * \param object L'index de l'objet
+         */
+        Sphere<real> bound(const std::size_t object) const
+        {
+            if (!contains(object))
+                throw std::out_of_range("No such object");
+
+            const float *s = entries[object].sphere;
+            return Sphere<real>(Point<real, 3>{s[0], s[1], s[2]}, s[3]);
+        }
+
+        /** \brief Determine les objets dont la sphere englobante n'est pas en dehors du champ de vision
+         *
+         * Le resultat est celui de Frustum::outside sur chaque sphere ; une cellule
+         * entierement du cote interieur d'un plan ne le teste plus pour ses enfants.
+         * \param f Le champ de vision
+         * \param visible Les index des objets visibles, remplace
+         */
+        void cull(const Frustum &f, std::vector<std::size_t> &visible) const
+        {
+            visible.clear();
+
+            float eq[24];
+            f.equations(eq);
+
+            std::vector<std::pair<std::uint32_t, unsigned int>> stack(1, std::make_pair(0u, 0x3fu));
+            while (!stack.empty())
+            {
+                const std::uint32_t index = stack.back().first;
+                const Node &node = nodes[index];
+                unsigned int mask = stack.back().second;
+                stack.pop_back();
+
+                // La racine contient aussi les objets sortis du monde, sa boite n'est pas testee
+                bool rejected = false;
+                for (int k = 0; k < 6 && !rejected && index != 0; ++k)
+                {
+                    if (!(mask & (1u << k)))
+                        continue;
+
+                    const float *e = eq + 4 * k;
+                    const float centered = e[0] * node.center[0] + e[1] * node.center[1] + e[2] * node.center[2] + e[3];
+                    const float extent = 2 * node.half * (std::fabs(e[0]) + std::fabs(e[1]) + std::fabs(e[2]));
+
+                    rejected = centered + extent < 0;
+                    if (centered - extent >= 0)
+                        mask &= ~(1u << k);
+                }
+
+                if (rejected)
+                    continue;
+
+                for (const std::uint32_t object : node.objects)
+                {
+                    const float *s = entries[object].sphere;
+                    bool outside = false;
+                    for (int k = 0; k < 6 && !outside; ++k)
+                        if (mask & (1u << k))
+                            outside = eq[4 * k] * s[0] + eq[4 * k + 1] * s[1] + eq[4 * k + 2] * s[2] + eq[4 * k + 3] < -s[3];
+                    if (!outside)
+                        visible.push_back(object);
+                }
+
+                for (const std::uint32_t child : node.children)
+                    if (child != 0 && nodes[child].count != 0)
+                        stack.push_back(std::make_pair(child, mask));
+            }
+        }
+
+        /** \brief Determine les objets dont la sphere englobante rencontre une sphere
+         *
+         * \param s La sphere
+         * \param result Les index des objets, remplace
+         */
+        void query(const Sphere<real> &s, std::vector<std::size_t> &result) const
+        {
+            result.clear();
+
+            const Point<real, 3> c = s.getCenter();
+            const float center[3] = {c[0], c[1], c[2]};
+            const float radius = s.getRadius();
+
+            std::vector<std::uint32_t> stack(1, 0);
+            while (!stack.empty())
+            {
+                const std::uint32_t index = stack.back();
+                const Node &node = nodes[index];
+                stack.pop_back();
+
+                if (index != 0 && distance2(node, center) > radius * radius)
+                    continue;
+
+                for (const std::uint32_t object : node.objects)
+                {
+                    const float *o = entries[object].sphere;
+                    const float dx = o[0] - center[0], dy = o[1] - center[1], dz = o[2] - center[2];
+                    if (dx * dx + dy * dy + dz * dz <= (o[3] + radius) * (o[3] + radius))
+                        result.push_back(object);
+                }
+
+                for (const std::uint32_t child : node.children)
+                    if (child != 0 && nodes[child].count != 0)
+                        stack.push_back(child);
+            }
+        }
+
+        /** \brief Determine les objets dont la sphere englobante rencontre une demi-droite
+         *
+         * \param origin L'origine de la demi-droite
+         * \param direction Sa direction, non nulle
+         * \param result Les index des objets, remplace
+         */
+        void query(const Point<real, 3> &origin, const Direction<real, 3> &direction, std::vector<std::size_t> &result) const
+        {
+            result.clear();
+
+            const float o[3] = {origin[0], origin[1], origin[2]};
+            const float d[3] = {direction[0], direction[1], direction[2]};
+            const float dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+            if (!(dd > 0))
+                throw std::invalid_argument("The direction must not be null");
+
+            const float inverse[3] = {1 / d[0], 1 / d[1], 1 / d[2]};
+
+            std::vector<std::uint32_t> stack(1, 0);
+            while (!stack.empty())
+            {
+                const std::uint32_t index = stack.back();
+                const Node &node = nodes[index];
+                stack.pop_back();
+
+                if (index != 0 && !hits(node, o, inverse))
+                    continue;
+
+                for (const std::uint32_t object : node.objects)
+                {
+                    // Distance au carre du centre a la demi-droite, comparee au rayon
+                    const float *s = entries[object].sphere;
+                    const float v[3] = {s[0] - o[0], s[1] - o[1], s[2] - o[2]};
+                    const float vv = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+                    const float along = std::max(0.f, v[0] * d[0] + v[1] * d[1] + v[2] * d[2]);
+                    if (vv - along * along / dd <= s[3] * s[3])
+                        result.push_back(object);
+                }
+
+                for (const std::uint32_t child : node.children)
+                    if (child != 0 && nodes[child].count != 0)
+                        stack.push_back(child);
+            }
+        }
+    };
+}
@@ -3,10 +3,18 @@
 #include "geometry/Point.hpp"
 #include "geometry/Triangle.hpp"
 #include "geometry/Sphere.hpp"
+#include "geometry/VertexStream.hpp"
+#include "geometry/QuantizedVertexStream.hpp"
+#include "geometry/Transformation.hpp"
+#include "geometry/Affine3x4.hpp"
+#include "geometry/BoundingSphere.hpp"
+#include "geometry/AABB.hpp"
+#include "geometry/OBB.hpp"
 
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 using namespace math;
 using namespace geometry;
@@ -15,39 +23,60 @@ namespace scene
 {
     class Object3D
     {
+    public:
+        /** \brief Volumes englobants d'un objet
+         */
+        enum BoundingVolume
+        {
+            sphere_volume, /**< Sphere englobante */
+            box_volume, /**< Boite alignee sur les axes */
+            oriented_box_volume /**< Boite orientee selon les axes principaux des sommets */
+        };
+
     private:
         string nom; /**< Nom de l'objet */
         Vector<float, 3> position; /**< Position de l'objet */
-        std::vector<Point<float, 3>> vertex; /**< Sommets de l'objet */
+        VertexStream<float> vertex; /**< Sommets de l'objet, stockes coordonnee par coordonnee, vide si quantized */
+        QuantizedVertexStream<float> quantizedVertex; /**< Sommets quantifies sur 16 bits */
+        bool quantized = false; /**< Indique si les sommets sont stockes sous forme quantifiee */
         std::vector<Triangle<float>> faces; /**< Faces de l'objet */
+        bool tight = false; /**< Indique si la sphere englobante est la sphere minimale plutot que celle de Ritter */
+        mutable bool boundsValid = false; /**< Indique si les volumes englobants en cache correspondent aux sommets */
+        mutable Sphere<float> sphere; /**< Sphere englobante en cache */
+        mutable Point<float, 3> boxMin; /**< Coin minimal de la boite englobante en cache */
+        mutable Point<float, 3> boxMax; /**< Coin maximal de la boite englobante en cache */
+        mutable OBB<float> orientedBox; /**< Boite orientee en cache */
+        mutable BoundingVolume tightest = sphere_volume; /**< Volume englobant en cache le plus petit */
 
         /** \brief Calcul une sphere de base pour l'algorithme de Ritter
          *
+         * \param points Les sommets de l'objet
          * \return une sphere de base pour l'algorithme de Ritter
          */
-        Sphere<float> sphereFromDistantPoint() const
+        Sphere<float> sphereFromDistantPoint(const VertexStream<float> &points) const
         {
             int minx = 0, miny = 0, minz = 0, maxx = 0, maxy = 0, maxz = 0;
+            const float *x = points.x(), *y = points.y(), *z = points.z();
 
-            for (int i = 0; i < vertex.size(); ++i)
+            for (int i = 0; i < points.size(); ++i)
             {
-                if (vertex[i][0] < vertex[minx][0])
+                if (x[i] < x[minx])
                     minx = i;
-                if (vertex[i][1] < vertex[miny][1])
+                if (y[i] < y[miny])
                     miny = i;
-                if (vertex[i][2] < vertex[minz][2])
+                if (z[i] < z[minz])
                     minz = i;
-                if (vertex[i][0] > vertex[maxx][0])
+                if (x[i] > x[maxx])
                     maxx = i;
-                if (vertex[i][1] > vertex[maxy][1])
+                if (y[i] > y[maxy])
                     maxy = i;
-                if (vertex[i][2] > vertex[maxz][2])
+                if (z[i] > z[maxz])
                     maxz = i;
             }
 
-            float dist2x = dot(vertex[maxx] - vertex[minx], vertex[maxx] - vertex[minx]);
-            float dist2y = dot(vertex[maxy] - vertex[miny], vertex[maxy] - vertex[miny]);
-            float dist2z = dot(vertex[maxz] - vertex[minz], vertex[maxz] - vertex[minz]);
+            float dist2x = dot(points[maxx] - points[minx], points[maxx] - points[minx]);
+            float dist2y = dot(points[maxy] - points[miny], points[maxy] - points[miny]);
+            float dist2z = dot(points[maxz] - points[minz], points[maxz] - points[minz]);
 
             int min = minx, max = maxx;
 
@@ -63,19 +92,20 @@ namespace scene
                 max = maxz;
             }
 
-            Point<float, 3> center((vertex[min] + vertex[max]) * 0.5f);
-            return Sphere<float>( center, std::sqrt( dot( vertex[max] - center, vertex[max] - center ) ) );
+            Point<float, 3> center((points[min] + points[max]) * 0.5f);
+            return Sphere<float>( center, std::sqrt( dot( points[max] - center, points[max] - center ) ) );
         }
 
         /** \brief Agrandit la sphere de collision afin qu'elle englobe la totalité des points de l'objet
          *
+         * \param points Les sommets de l'objet
          * \param s Sphere& La sphere a agrandir
          */
-        void growSphere(Sphere<float> &s) const
+        void growSphere(const VertexStream<float> &points, Sphere<float> &s) const
         {
-            for (int i = 0; i < vertex.size(); ++i)
+            for (int i = 0; i < points.size(); ++i)
             {
-                math::Vector<float, 3> vec = vertex[i] - s.getCenter();
+                math::Vector<float, 3> vec = points[i] - s.getCenter();
                 float dist2 = dot(vec, vec);
 
                 if (dist2 > s.getRadius() * s.getRadius())
@@ -90,13 +120,62 @@ namespace scene
             }
         }
 
+        /** \brief Recalcule les volumes englobants s'ils ne correspondent plus aux sommets
+         *
+         * Les sommets n'etant modifies que par la construction et quantize(), le
+         * cache n'est invalide que par ces operations : ajouter ou retirer une
+         * face ne change pas les sommets.
+         */
+        void updateBounds() const
+        {
+            if (boundsValid)
+                return;
+
+            const VertexStream<float> points = quantized ? quantizedVertex.decode() : VertexStream<float>();
+            const VertexStream<float> &v = quantized ? points : vertex;
+
+            if (v.empty())
+            {
+                sphere = Sphere<float>();
+                boxMin = boxMax = Point<float, 3>();
+                orientedBox = OBB<float>();
+                tightest = sphere_volume;
+            }
+            else
+            {
+                if (tight)
+                    sphere = BoundingSphere<float>::compute(v);
+                else
+                {
+                    sphere = sphereFromDistantPoint(v);
+                    growSphere(v, sphere);
+                }
+
+                const float *coords[] = {v.x(), v.y(), v.z()};
+                for (int c = 0; c < 3; ++c)
+                {
+                    boxMin[c] = *std::min_element(coords[c], coords[c] + v.size());
+                    boxMax[c] = *std::max_element(coords[c], coords[c] + v.size());
+                }
+                orientedBox = OBB<float>::fromPoints(v);
+
+                const float r = sphere.getRadius();
+                const float volumes[] = {4 * std::acos(-1.f) / 3 * r * r * r, AABB<float>::fromCorners(boxMin, boxMax).volume(),
+                                         orientedBox.volume()};
+                tightest = BoundingVolume(std::min_element(volumes, volumes + 3) - volumes);
+            }
+            boundsValid = true;
+        }
+
     public:
 
         Object3D()
         {
         }
 
-        Object3D(const Object3D &o) : vertex(o.vertex), faces(o.faces)
+        Object3D(const Object3D &o) : vertex(o.vertex), quantizedVertex(o.quantizedVertex), quantized(o.quantized), faces(o.faces),
+            tight(o.tight), boundsValid(o.boundsValid), sphere(o.sphere), boxMin(o.boxMin), boxMax(o.boxMax),
+            orientedBox(o.orientedBox), tightest(o.tightest)
         {
             
         }
@@ -111,15 +190,206 @@ namespace scene
 
         }
 
-        /** \brief Calcule la sphere englobante de l'objet en utilisant l'algorithme de Ritter
+        /** \brief Accede aux sommets de l'objet
+         *
+         * \return Les sommets, stockes coordonnee par coordonnee (vide si l'objet est quantifie)
+         */
+        const VertexStream<float> &vertices() const
+        {
+            return vertex;
+        }
+
+        /** \brief Accede aux sommets quantifies de l'objet
+         *
+         * \return Les sommets quantifies (vide si l'objet n'est pas quantifie)
+         */
+        const QuantizedVertexStream<float> &quantized_vertices() const
+        {
+            return quantizedVertex;
+        }
+
+        /** \brief Retourne le nombre de sommets de l'objet
+         *
+         * \return Le nombre de sommets
+         */
+        unsigned int num_vertices() const
+        {
+            return quantized ? quantizedVertex.size() : vertex.size();
+        }
+
+        /** \brief Obtient un sommet, decode si l'objet est quantifie
+         *
+         * \param n L'index du sommet
+         * \return Le sommet correspondant a l'index
+         */
+        Point<float, 3> vertex_at(const unsigned int n) const
+        {
+            if (n >= num_vertices())
+                throw(std::invalid_argument("index out of bound"));
+
+            return quantized ? quantizedVertex[n] : vertex[n];
+        }
+
+        /** \brief Indique si les sommets sont stockes sous forme quantifiee
+         */
+        bool is_quantized() const
+        {
+            return quantized;
+        }
+
+        /** \brief Quantifie les sommets sur 16 bits par rapport a la boite englobante de l'objet
+         * et libere le stockage flottant, divisant par deux la memoire des sommets
+         */
+        void quantize()
+        {
+            if (quantized)
+                return;
+
+            quantizedVertex = QuantizedVertexStream<float>(vertex);
+            vertex = VertexStream<float>();
+            quantized = true;
+            boundsValid = false;
+        }
+
+        /** \brief Transforme les sommets de l'objet, le decodage etant integre au noyau si l'objet est quantifie
+         *
+         * \param t La transformation a appliquer
+         * \param result Les sommets transformes
+         */
+        void transform_vertices(const Transformation<float> &t, VertexStream<float> &result) const
+        {
+            if (quantized)
+                t.transform(quantizedVertex, result);
+            else
+                t.transform(vertex, result);
+        }
+
+        /** \brief Transforme les sommets de l'objet par une transformation affine compacte
+         *
+         * \param t La transformation a appliquer
+         * \param result Les sommets transformes
+         */
+        void transform_vertices(const Affine3x4<float> &t, VertexStream<float> &result) const
+        {
+            transform_vertices(t.toTransformation(), result);
+        }
+
+        /** \brief Obtient la sphere englobante de l'objet, calculee par l'algorithme de Ritter (ou
+         * minimale, voir tighten_bsphere) a la premiere demande puis gardee en cache tant que les
+         * sommets ne changent pas
          *
          * \return La sphere englobante
          */
         Sphere<float> bsphere() const
         {
-            Sphere<float> s = sphereFromDistantPoint();
-            growSphere(s);
-            return s;
+            updateBounds();
+            return sphere;
+        }
+
+        /** \brief Remplace la sphere englobante de Ritter par la sphere minimale, calculee immediatement
+         *
+         * A appeler au chargement : le calcul, plus long que celui de Ritter sur
+         * de petits objets, n'est refait que si les sommets changent. Une sphere
+         * plus petite evite de dessiner des objets en dehors du champ de vision.
+         */
+        void tighten_bsphere()
+        {
+            if (!tight)
+            {
+                tight = true;
+                boundsValid = false;
+            }
+            updateBounds();
+        }
+
+        /** \brief Obtient la sphere englobante de l'objet place dans le monde
+         *
+         * \param world La transformation du repere de l'objet vers le repere du monde
+         * \return La sphere englobante en cache, transformee
+         */
+        Sphere<float> bsphere(const Affine3x4<float> &world) const
+        {
+            updateBounds();
+            return world.transform(sphere);
+        }
+
+        /** \brief Obtient la boite englobante de l'objet, alignee sur les axes et gardee en cache
+         *
+         * \param min Le coin minimal de la boite
+         * \param max Le coin maximal de la boite
+         */
+        void bbox(Point<float, 3> &min, Point<float, 3> &max) const
+        {
+            updateBounds();
+            min = boxMin;
+            max = boxMax;
+        }
+
+        /** \brief Obtient la boite englobante de l'objet place dans le monde
+         *
+         * \param world La transformation du repere de l'objet vers le repere du monde
+         * \param min Le coin minimal de la boite transformee, alignee sur les axes du monde
+         * \param max Le coin maximal de la boite transformee
+         */
+        void bbox(const Affine3x4<float> &world, Point<float, 3> &min, Point<float, 3> &max) const
+        {
+            updateBounds();
+            world.transformBox(boxMin, boxMax, min, max);
+        }
+
+        /** \brief Obtient la boite englobante de l'objet, alignee sur les axes et gardee en cache
+         *
+         * \return La boite englobante
+         */
+        AABB<float> aabb() const
+        {
+            updateBounds();
+            return AABB<float>::fromCorners(boxMin, boxMax);
+        }
+
+        /** \brief Obtient la boite englobante de l'objet place dans le monde
+         *
+         * \param world La transformation du repere de l'objet vers le repere du monde
+         * \return La boite transformee, alignee sur les axes du monde
+         */
+        AABB<float> aabb(const Affine3x4<float> &world) const
+        {
+            return aabb().transform(world);
+        }
+
+        /** \brief Obtient la boite englobante orientee de l'objet, selon les axes
+         * principaux de ses sommets, calculee a la premiere demande puis gardee en cache
+         *
+         * \return La boite orientee
+         */
+        OBB<float> obb() const
+        {
+            updateBounds();
+            return orientedBox;
+        }
+
+        /** \brief Obtient la boite englobante orientee de l'objet place dans le monde
+         *
+         * \param world La transformation du repere de l'objet vers le repere du monde, une similitude
+         * \return La boite orientee transformee
+         */
+        OBB<float> obb(const Affine3x4<float> &world) const
+        {
+            updateBounds();
+            return orientedBox.transform(world);
+        }
+
+        /** \brief Indique le volume englobant de l'objet le plus petit, donc celui
+         * qui rejette le mieux l'objet quand il est en dehors du champ de vision
+         *
+         * Les volumes sont compares dans le repere de l'objet ; une similitude
+         * conserve leur ordre, sauf pour la boite alignee qui grossit en tournant.
+         * \return Le volume englobant le plus petit
+         */
+        BoundingVolume tightest_volume() const
+        {
+            updateBounds();
+            return tightest;
         }
 
         /** \brief Obtient une face spécifique
@@ -152,10 +422,10 @@ namespace scene
          */
         void add_face(unsigned int f1, unsigned int f2, unsigned int f3)
         {
-            if (f1 > vertex.size() || f2 > vertex.size() || f3 > vertex.size())
+            if (f1 >= num_vertices() || f2 >= num_vertices() || f3 >= num_vertices())
                 throw(std::invalid_argument("One of the argument is out of bound"));
 
-            Triangle<float> t(vertex[f1], vertex[f2], vertex[f3]);
+            Triangle<float> t(vertex_at(f1), vertex_at(f2), vertex_at(f3));
 
             faces.push_back(t);
         }
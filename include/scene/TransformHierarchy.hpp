@@ -0,0 +1,179 @@
+#pragma once
+
+#include "geometry/Affine3x4.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace scene
+{
+    /** @class TransformHierarchy
+     *
+     * Hierarchie de transformations : chaque noeud a une transformation locale,
+     * relative a son parent, et une transformation monde mise en cache.
+     *
+     * Modifier une transformation locale marque seulement le noeud ; update()
+     * recalcule les transformations monde des sous-arbres marques et d'eux seuls,
+     * un noeud qui ne bouge pas ne coutant rien. Un parent etant toujours cree
+     * avant ses enfants, les noeuds sont ranges dans l'ordre de parcours.
+     */
+    class TransformHierarchy
+    {
+    public:
+        static constexpr std::size_t none = std::size_t(-1); /**< Parent des racines */
+
+    private:
+        std::vector<std::size_t> parents; /**< Parent de chaque noeud, none pour une racine */
+        std::vector<std::vector<std::size_t>> children; /**< Enfants de chaque noeud */
+        std::vector<geometry::Affine3x4<float>> locals; /**< Transformations relatives au parent */
+        std::vector<geometry::Affine3x4<float>> worlds; /**< Transformations monde, valides apres update() */
+        std::vector<bool> dirty; /**< Indique si la transformation monde doit etre recalculee */
+        std::vector<std::size_t> pending; /**< Noeuds marques depuis le dernier update() */
+
+        void check(const std::size_t node) const
+        {
+            if (node >= parents.size())
+                throw std::out_of_range("No such node");
+        }
+
+        void mark(const std::size_t node)
+        {
+            if (!dirty[node])
+            {
+                dirty[node] = true;
+                pending.push_back(node);
+            }
+        }
+
+    public:
+        /** \brief Ajoute un noeud
+         *
+         * \param local La transformation relative au parent
+         * \param parent Le parent, none pour une racine
+         * \return L'index du noeud
+         */
+        std::size_t add(const geometry::Affine3x4<float> &local, const std::size_t parent = none)
+        {
+            if (parent != none)
+                check(parent);
+
+            const std::size_t node = parents.size();
+            parents.push_back(parent);
+            children.push_back(std::vector<std::size_t>());
+            locals.push_back(local);
+            worlds.push_back(local);
+            dirty.push_back(false);
+
+            if (parent != none)
+                children[parent].push_back(node);
+            mark(node);
+
+            return node;
+        }
+
+        /** \brief Retourne le nombre de noeuds
+         */
+        std::size_t size() const
+        {
+            return parents.size();
+        }
+
+        /** \brief Obtient le parent d'un noeud
+         *
+         * \param node L'index du noeud
+         * \return Le parent, none pour une racine
+         */
+        std::size_t parent(const std::size_t node) const
+        {
+            check(node);
+            return parents[node];
+        }
+
+        /** \brief Obtient la transformation locale d'un noeud
+         *
+         * \param node L'index du noeud
+         * \return La transformation relative au parent
+         */
+        const geometry::Affine3x4<float> &local(const std::size_t node) const
+        {
+            check(node);
+            return locals[node];
+        }
+
+        /** \brief Modifie la transformation locale d'un noeud, ses descendants etant recalcules au prochain update()
+         *
+         * \param node L'index du noeud
+         * \param t La nouvelle transformation relative au parent
+         */
+        void setLocal(const std::size_t node, const geometry::Affine3x4<float> &t)
+        {
+            check(node);
+            locals[node] = t;
+            mark(node);
+        }
+
+        /** \brief Indique si la transformation monde d'un noeud doit etre recalculee
+         *
+         * \param node L'index du noeud
+         * \return true si le noeud ou l'un de ses ancetres a ete modifie depuis le dernier update()
+         */
+        bool isDirty(const std::size_t node) const
+        {
+            check(node);
+
+            for (std::size_t n = node; n != none; n = parents[n])
+                if (dirty[n])
+                    return true;
+            return false;
+        }
+
+        /** \brief Obtient la transformation monde d'un noeud
+         *
+         * \param node L'index du noeud
+         * \return La transformation monde calculee au dernier update()
+         */
+        const geometry::Affine3x4<float> &world(const std::size_t node) const
+        {
+            check(node);
+            return worlds[node];
+        }
+
+        /** \brief Recalcule les transformations monde des sous-arbres modifies
+         *
+         * Un noeud marque dont un ancetre l'est aussi est traite avec le sous-arbre
+         * de cet ancetre : les noeuds marques sont parcourus par index croissant.
+         * \return Le nombre de transformations monde recalculees
+         */
+        std::size_t update()
+        {
+            std::size_t updated = 0;
+            std::vector<std::size_t> stack;
+
+            std::sort(pending.begin(), pending.end());
+            for (std::size_t root : pending)
+            {
+                if (!dirty[root])
+                    continue;
+
+                stack.push_back(root);
+                while (!stack.empty())
+                {
+                    const std::size_t node = stack.back();
+                    stack.pop_back();
+
+                    const std::size_t p = parents[node];
+                    worlds[node] = p == none ? locals[node] : locals[node].concat(worlds[p]);
+                    dirty[node] = false;
+                    ++updated;
+
+                    stack.insert(stack.end(), children[node].begin(), children[node].end());
+                }
+            }
+            pending.clear();
+
+            return updated;
+        }
+    };
+}
@@ -28,23 +28,62 @@ private:
     Gui* _gui;
     Camera* _camera;
     vector<Object3D> _objectList;
+    Bvh _hierarchy; /**< Hierarchie des spheres englobantes des objets, pour le rejet par le champ de vision */
+    bool _stale; /**< Indique si des objets ont ete ajoutes depuis la construction de la hierarchie */
+    bool _dynamic; /**< Indique si les objets sont indexes par l'octree plutot que par la hierarchie */
+    LooseOctree _octree; /**< Index des objets qui se deplacent, mis a jour en temps constant */
     Direction<real, 3> _move;
     Direction<real, 3> _axe;
 public:
-    Scene(Gui * gui, vector<Object3D>& objectList) : _objectList(objectList){
+    static constexpr real worldHalf = 1024; /**< Demi-cote du monde indexe par l'octree, les objets au-dela etant ranges a sa racine */
+
+    Scene(Gui * gui, vector<Object3D>& objectList, bool dynamic = false) : _objectList(objectList), _stale(false), _dynamic(dynamic),
+        _octree(Point<real, 3>{0, 0, 0}, worldHalf) {
         if (gui == nullptr)
             throw(invalid_argument("Gui musn't be null"));
         _gui = gui;
         _camera = new Camera(_gui->get_win_width(), _gui->get_win_height(), 1, Direction<real, 3>{0, 0, -1});
+        buildHierarchy();
     }
     virtual ~Scene() {
         delete _camera;
         delete _gui;
     }
 
+    /** \brief Ajoute un objet a la scene
+     *
+     * En mode dynamique, l'objet est insere dans l'octree en temps constant.
+     * Sinon la hierarchie n'est reconstruite qu'au prochain update(), une seule
+     * fois pour tous les objets ajoutes depuis.
+     */
     void addObject(Object3D &o)
     {
         _objectList.push_back(o);
+        if (_dynamic)
+            _octree.insert(_objectList.size() - 1, o.bsphere());
+        else
+            _stale = true;
+    }
+
+    /** \brief Reconstruit l'index des spheres englobantes des objets
+     */
+    void buildHierarchy()
+    {
+        vector<Sphere<real>> bounding;
+        for (size_t i = 0; i < _objectList.size(); ++i)
+            bounding.push_back(_objectList[i].bsphere());
+
+        if (!_dynamic)
+        {
+            _hierarchy.build(bounding.data(), bounding.size());
+            _stale = false;
+        }
+        else
+            for (size_t i = 0; i < bounding.size(); ++i)
+                if (_octree.contains(i))
+                    _octree.move(i, bounding[i]);
+                else
+                    _octree.insert(i, bounding[i]);
     }
 
     virtual
@@ -97,68 +136,46 @@ public:
 }
 void scene::Scene::draw() const
 {
-    vector<int> deleted;
-    
-    // Suppression des objets invisibles
-    for (int i = 0; i < _objectList.size(); ++i)
-    {
-        Sphere<real> bounding = _objectList[i].bsphere();
-        if (_camera->outsideFrustum(bounding))
-            deleted.push_back(i);
-    }
-    
-    if (deleted.size() == _objectList.size())
+    // Suppression des objets invisibles, par sous-arbres entiers de l'index
+    vector<size_t> objects;
+    if (_dynamic)
+        _camera->visibleObjects(_octree, objects);
+    else
+        _camera->visibleObjects(_hierarchy, objects);
+    if (objects.empty())
         return;
     
     vector<LineSegment<real, 3>> ligne;
-    for (int i = 0; i < _objectList.size(); ++i)
+    for (size_t i : objects)
     {
-        if (std::find(deleted.begin(), deleted.end(), i) == deleted.end())
+        // L'index ne connait que les spheres : un objet allonge ou penche est
+        // encore teste avec sa boite, quand elle l'englobe mieux
+        const Object3D &o = _objectList[i];
+        if ((o.tightest_volume() == Object3D::box_volume && _camera->outsideFrustum(o.aabb()))
+            || (o.tightest_volume() == Object3D::oriented_box_volume && _camera->outsideFrustum(o.obb())))
             continue;
-        
+
         for (int j = 0; j < _objectList[i].num_faces(); ++j)
         {
             Triangle<real> face = _objectList[i].face(j);
             if (!_camera->sees(face))
                 continue;
                 
-            LineSegment<real, 3> p0p1(face.get_p0(), face.get_p1());
-            LineSegment<real, 3> p0p2(face.get_p0(), face.get_p2());
-            LineSegment<real, 3> p1p2(face.get_p1(), face.get_p2());
-
-            try {
-                ligne.push_back(_camera->visible_part(p0p1));
-            } catch (invalid_argument &e) {
-                
-            }
-            
-            try {
-                ligne.push_back(_camera->visible_part(p0p2));
-            } catch (invalid_argument &e) {
-                
-            }
-            
-            try {
-                ligne.push_back(_camera->visible_part(p1p2));
-            } catch (invalid_argument &e) {
-                
-            }
+            ligne.push_back(LineSegment<real, 3>(face.get_p0(), face.get_p1()));
+            ligne.push_back(LineSegment<real, 3>(face.get_p0(), face.get_p2()));
+            ligne.push_back(LineSegment<real, 3>(face.get_p1(), face.get_p2()));
         }
     }
     
-    if (ligne.size() == 0)
+    vector<LineSegment<real, 3>> visible;
+    _camera->visible_parts(ligne, visible);
+    if (visible.size() == 0)
         return;
     
-    for (int i = 0; i < ligne.size(); ++i)
-    {
-        LineSegment<real, 2> proj(
-            Point<real, 2>{(- _camera->GetFocalLength() / ligne[i].get_begin()[2]) * ligne[i].get_begin()[0],
-            (- _camera->GetFocalLength() / ligne[i].get_begin()[2]) * ligne[i].get_begin()[1]},
-            Point<real, 2>{(- _camera->GetFocalLength() / ligne[i].get_end()[2]) * ligne[i].get_end()[0],
-            (- _camera->GetFocalLength() / ligne[i].get_end()[2]) * ligne[i].get_end()[1]}
-        );
-        _gui->render_line(proj.get_begin(), proj.get_end(), white);
-    }
+    vector<LineSegment<real, 2>> proj;
+    _camera->project(visible, proj);
+    for (int i = 0; i < proj.size(); ++i)
+        _gui->render_line(proj[i].get_begin(), proj[i].get_end(), white);
 }
 
 void scene::Scene::press_a()
@@ -272,6 +289,8 @@ void scene::Scene::release_zx()
 
 void scene::Scene::update()
 {
+    if (_stale)
+        buildHierarchy();
     _camera->move(_move.to_unit());
     _camera->update();
 }
@@ -1,4 +1,5 @@
 #include "Scene.hpp"
+#include "math/Dispatch.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -55,6 +56,7 @@ Object3D readGeoFile(const string & name)
     }
 
     file.close();
+    o.tighten_bsphere();
     return o;
 }
 
@@ -62,8 +64,13 @@ int main(int argc, char **argv)
 {
     if (argc == 1) {
         cerr << "Usage : " << *argv << " <file 1> ... <file n>" << endl;
+        cerr << "        " << *argv << " --print-kernels" << endl;
         exit(1);
     }
+    if (string(argv[1]) == "--print-kernels") {
+        math::dispatch::print_kernels(cout);
+        return 0;
+    }
     vector<Object3D> o;
     for (int i = 1; i < argc; ++i)
         o.push_back(readGeoFile(string(argv[i])));
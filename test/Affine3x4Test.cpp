@@ -0,0 +1,13 @@
+#include "Affine3x4Test.hpp"
+
+int main(void)
+{
+    TestSuite *suite = Affine3x4Test::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
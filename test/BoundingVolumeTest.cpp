@@ -0,0 +1,13 @@
+#include "BoundingVolumeTest.hpp"
+
+int main(void)
+{
+    TestSuite *suite = BoundingVolumeTest::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
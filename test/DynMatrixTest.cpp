@@ -0,0 +1,13 @@
+#include "DynMatrixTest.hpp"
+
+int main(void)
+{
+    TestSuite *suite = DynMatrixTest::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
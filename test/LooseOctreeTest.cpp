@@ -0,0 +1,13 @@
+#include "LooseOctreeTest.hpp"
+
+int main(void)
+{
+    TestSuite *suite = LooseOctreeTest::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
@@ -73,13 +73,55 @@ void MatrixTest::testDirMulWithScalar()
 
 void MatrixTest::testInverse()
 {
-    Matrix<int, 3, 3> matrix {{2, -1, 0}, {-1, 2, -1}, {0, -1, 2}};
-    Matrix<float, 3, 3> expected {{3.0f/4, 1.0f/2, 1.0f/4}, {1.0f/2, 1.0f, 1.0f/2}, {1.0f/4, 1.0f/2, 3.0f/4}};
-    Matrix<float, 3, 3> result = matrix.inverse();
+    Matrix<int, 3, 3, RoundTo2Decimals> matrix {{2, -1, 0}, {-1, 2, -1}, {0, -1, 2}};
+    Matrix<float, 3, 3, RoundTo2Decimals> expected {{3.0f/4, 1.0f/2, 1.0f/4}, {1.0f/2, 1.0f, 1.0f/2}, {1.0f/4, 1.0f/2, 3.0f/4}};
+    Matrix<float, 3, 3, RoundTo2Decimals> result = matrix.inverse();
 
     CPPUNIT_ASSERT_EQUAL(expected, result);
 }
 
+void MatrixTest::testInverse4x4()
+{
+    Mat44r matrix {{1, 0, 2, 0}, {0, 2, 0, 1}, {0, 0, 4, 0}, {1, 0, 0, 2}};
+    Mat44r expected {{1, 0, -0.5f, 0}, {0.25f, 0.5f, -0.125f, -0.25f}, {0, 0, 0.25f, 0}, {-0.5f, 0, 0.25f, 0.5f}};
+    Mat44r cofactor = matrix.cofactor_inverse();
+    Mat44r gaussJordan = matrix.gauss_jordan_inverse();
+
+    CPPUNIT_ASSERT_EQUAL(expected, cofactor);
+    CPPUNIT_ASSERT_EQUAL(expected, gaussJordan);
+
+    Mat44r singular {{1, 2, 3, 4}, {2, 4, 6, 8}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+
+    try
+    {
+        singular.inverse();
+        CPPUNIT_FAIL("domain_error not launched");
+    }
+    catch (std::domain_error &e)
+    {
+    }
+}
+
+void MatrixTest::testInverseAffine()
+{
+    Mat44r affine {{2, 0, 0, 1}, {0, 4, 0, 2}, {0, 0, 0.5f, 3}, {0, 0, 0, 1}};
+    Mat44r expectedAffine {{0.5f, 0, 0, -0.5f}, {0, 0.25f, 0, -0.5f}, {0, 0, 2, -6}, {0, 0, 0, 1}};
+    Mat44r expectedNormal {{0.5f, 0, 0, 0}, {0, 0.25f, 0, 0}, {0, 0, 2, 0}, {0, 0, 0, 1}};
+    Mat44r affineInverse = affine.inverse_affine();
+    Mat44r normal = affine.inverse_transpose();
+
+    CPPUNIT_ASSERT_EQUAL(expectedAffine, affineInverse);
+    CPPUNIT_ASSERT_EQUAL(expectedNormal, normal);
+
+    Mat44r rigid {{0, -1, 0, 1}, {1, 0, 0, 2}, {0, 0, 1, 3}, {0, 0, 0, 1}};
+    Mat44r expectedRigid {{0, 1, 0, -2}, {-1, 0, 0, 1}, {0, 0, 1, -3}, {0, 0, 0, 1}};
+    Mat44r rigidInverse = rigid.inverse_rigid();
+    Mat44r cofactor = rigid.cofactor_inverse();
+
+    CPPUNIT_ASSERT_EQUAL(expectedRigid, rigidInverse);
+    CPPUNIT_ASSERT_EQUAL(expectedRigid, cofactor);
+}
+
 void MatrixTest::testIsNull()
 {
     Matrix<float, 2, 2> m1 {{NAN, 0}, {0, 0}};
@@ -101,8 +143,14 @@ void MatrixTest::testMultWithScalar()
 {
     Matrix<int, 3, 3> m1 {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
     Matrix<int, 3, 3> expected {{2, 4, 6}, {8, 10, 12}, {14, 16, 18}};
+    Matrix<int, 3, 3> result = m1 * 2;
+
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+
+    Matrix<int, 3, 3> combined = m1 + m1 * 2 + 2 * m1;
+    Matrix<int, 3, 3> expectedCombined {{5, 10, 15}, {20, 25, 30}, {35, 40, 45}};
 
-    CPPUNIT_ASSERT_EQUAL(expected, m1 * 2);
+    CPPUNIT_ASSERT_EQUAL(expectedCombined, combined);
 }
 
 void MatrixTest::testMulWithVector()
@@ -113,6 +161,19 @@ void MatrixTest::testMulWithVector()
     Matrix<int, 2, 1> result = matrice * vecteur;
 
     CPPUNIT_ASSERT_EQUAL(expected, result);
+
+    Mat44r transformation {{1, 0, 0, 2}, {0, 2, 0, -1}, {0, 0, 1, 3}, {1, 1, 1, 1}};
+    Vec4r point {1, 2, 3, 1};
+    Matrix<real, 4, 1> expectedPoint {{3}, {3}, {6}, {7}};
+    Vec4r expectedRow {2, 5, 4, 10};
+
+    CPPUNIT_ASSERT_EQUAL(expectedPoint, transformation * point);
+    CPPUNIT_ASSERT(expectedRow == point * transformation);
+
+    Vector<int, 2> ligne {1, 2};
+    Vector<int, 3> expectedLigne {9, 8, -2};
+
+    CPPUNIT_ASSERT(expectedLigne == ligne * matrice);
 }
 
 void MatrixTest::testMulWithMatrix()
@@ -120,6 +181,58 @@ void MatrixTest::testMulWithMatrix()
     Matrix<int, 2, 3> m1 {{1, 2, 0}, {4, 3, -1}};
     Matrix<int, 3, 2> m2 {{5, 1}, {2, 3}, {3, 4}};
     Matrix<int, 2, 2> expected {{9, 7}, {23, 9}};
+
+    CPPUNIT_ASSERT_EQUAL(expected, m1 * m2);
+
+    Mat44r translation {{1, 0, 0, 1}, {0, 1, 0, 2}, {0, 0, 1, 3}, {0, 0, 0, 1}};
+    Mat44r scaling {{2, 0, 0, 0}, {0, 2, 0, 0}, {0, 0, 2, 0}, {0, 0, 0, 1}};
+    Mat44r expectedTransform {{2, 0, 0, 1}, {0, 2, 0, 2}, {0, 0, 2, 3}, {0, 0, 0, 1}};
+
+    CPPUNIT_ASSERT_EQUAL(expectedTransform, translation * scaling);
+
+    Mat44r rotation {{0, -1, 0, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+    Mat44r expectedChain {{0, -2, 0, 1}, {2, 0, 0, 2}, {0, 0, 2, 3}, {0, 0, 0, 1}};
+
+    CPPUNIT_ASSERT_EQUAL(expectedChain, translation * scaling * rotation);
+
+    Matrix<real, 4, 2> columns {{1, 0}, {0, 1}, {1, 1}, {0, 0}};
+    Matrix<real, 4, 2> expectedColumns {{2, 1}, {-2, 2}, {2, 2}, {0, 0}};
+
+    Matrix<real, 4, 2> offset {{0, 1}, {-2, 0}};
+
+    Matrix<real, 4, 2> shifted = scaling * columns + offset;
+
+    CPPUNIT_ASSERT_EQUAL(expectedColumns, shifted);
+
+    Matrix<int, 3, 4> m3 {{1, 2, 3, 4}, {0, 1, 0, 1}, {-1, 0, 2, 0}};
+    Matrix<int, 4, 2> m4 {{1, 0}, {0, 1}, {1, 1}, {2, -1}};
+    Matrix<int, 3, 2> expected32 {{12, 1}, {2, 0}, {1, 2}};
+
+    CPPUNIT_ASSERT_EQUAL(expected32, m3 * m4);
+
+    Matrix<int, 5, 5> identity5 {{1}, {0, 1}, {0, 0, 1}, {0, 0, 0, 1}, {0, 0, 0, 0, 1}};
+    Matrix<int, 5, 5> m5 {{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {1, 1, 1, 1, 1}, {0, 2, 0, 2, 0}, {5, 4, 3, 2, 1}};
+
+    CPPUNIT_ASSERT_EQUAL(m5, m5 * identity5);
+    CPPUNIT_ASSERT_EQUAL(m5, identity5 * m5);
+}
+
+void MatrixTest::testRowColumnView()
+{
+    Matrix<int, 2, 3> matrice {{1, 2, 0}, {4, 3, -1}};
+
+    CPPUNIT_ASSERT(matrice.row(1)[0] == 4);
+    CPPUNIT_ASSERT(matrice.row(1)[2] == -1);
+    CPPUNIT_ASSERT(matrice.column(1)[0] == 2);
+    CPPUNIT_ASSERT(matrice.column(1)[1] == 3);
+    CPPUNIT_ASSERT(matrice.column(2).size() == 2);
+
+    matrice.column(2)[1] = 7;
+    matrice[0][1] = 5;
+
+    CPPUNIT_ASSERT(matrice.at(1, 2) == 7);
+    CPPUNIT_ASSERT(matrice.at(0, 1) == 5);
+    CPPUNIT_ASSERT(matrice.data()[5] == 7);
 }
 
 void MatrixTest::testOutStreamOperator()
@@ -140,6 +253,8 @@ TestSuite *MatrixTest::suite()
     TestSuite *suit = new TestSuite();
     suit->addTest(new TestCaller<MatrixTest>("testAddition", &MatrixTest::testAddition));
     suit->addTest(new TestCaller<MatrixTest>("testInverse", &MatrixTest::testInverse));
+    suit->addTest(new TestCaller<MatrixTest>("testInverse4x4", &MatrixTest::testInverse4x4));
+    suit->addTest(new TestCaller<MatrixTest>("testInverseAffine", &MatrixTest::testInverseAffine));
     suit->addTest(new TestCaller<MatrixTest>("testAt", &MatrixTest::testAt));
     suit->addTest(new TestCaller<MatrixTest>("testDirAccessor", &MatrixTest::testDirAccessor));
     suit->addTest(new TestCaller<MatrixTest>("testDirAddition", &MatrixTest::testDirAddition));
@@ -150,6 +265,7 @@ TestSuite *MatrixTest::suite()
     suit->addTest(new TestCaller<MatrixTest>("testMulWithMatrix", &MatrixTest::testMulWithMatrix));
     suit->addTest(new TestCaller<MatrixTest>("testMulWithVector", &MatrixTest::testMulWithVector));
     suit->addTest(new TestCaller<MatrixTest>("testOutStreamOperator", &MatrixTest::testOutStreamOperator));
+    suit->addTest(new TestCaller<MatrixTest>("testRowColumnView", &MatrixTest::testRowColumnView));
     suit->addTest(new TestCaller<MatrixTest>("testTranspose", &MatrixTest::testTranspose));
 
     return suit;
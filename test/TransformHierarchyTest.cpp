@@ -0,0 +1,13 @@
+#include "TransformHierarchyTest.hpp"
+
+int main(void)
+{
+    TestSuite *suite = TransformHierarchyTest::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
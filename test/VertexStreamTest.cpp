@@ -0,0 +1,13 @@
+#include "VertexStreamTest.hpp"
+
+int main(void)
+{
+    TestSuite *suite = VertexStreamTest::suite();
+    TextUi::TestRunner runner;
+
+    runner.addTest(suite);
+
+    runner.run();
+
+    return runner.result().testFailuresTotal();
+}
\ No newline at end of file
@@ -5,14 +5,29 @@
 //
 // Tests libmatrix.
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <iostream>
 #include "unit_test.h"
+#include "math/Dispatch.hpp"
 #include "math/Matrix.hpp"
+#include "math/Packet.hpp"
 #include "math/Vector.hpp"
 
-using namespace math;
+using math::Vector;
+using math::RoundTo2Decimals;
+
+// Les valeurs attendues sont arrondies au centieme
+using Vec2i = Vector<int, 2, RoundTo2Decimals>;
+using Vec3i = Vector<int, 3, RoundTo2Decimals>;
+using Vec4i = Vector<int, 4, RoundTo2Decimals>;
+using Vec2r = Vector<real, 2, RoundTo2Decimals>;
+using Vec3r = Vector<real, 3, RoundTo2Decimals>;
+using Vec4r = Vector<real, 4, RoundTo2Decimals>;
 
 int test_is_null()
 {
@@ -283,6 +298,277 @@ int test_cross()
 
     return run_tests( "cross( Vector, Vector )", test_vec );
 }
+
+int test_expression()
+{
+    Vec3r a { 1.0f, 2.0f, 3.0f };
+    Vec3r b { 0.5f, 0.5f, 0.5f };
+    Vec3r c { 2.0f, 0.0f, -1.0f };
+    Vec3r d { 0.5f, 4.5f, 7.5f };
+    Vec3r r = a * 2.0f + b - c;
+    Vec3r alias { 1.0f, 1.0f, 1.0f };
+    alias = alias + alias * 2.0f;
+    TestVector test_vec
+    {
+        { "a * 2 + b - c == d", r == d },
+        { "alias = alias + alias * 2", alias == Vec3r { 3.0f, 3.0f, 3.0f } },
+        { "-(a + b) == -a - b", -(a + b) == -a - b },
+        { "(a + b) * c == dot( a, c ) + dot( b, c )", (a + b) * c == dot( a, c ) + dot( b, c ) }
+    };
+
+    return run_tests( "expression", test_vec );
+}
+
+int test_fast_math()
+{
+    float rsqrt_error { 0 };
+    for( float x { 1e-3f }; x < 1e3f; x *= 1.01f )
+        rsqrt_error = std::max( rsqrt_error, std::fabs( math::FastMath::rsqrt( x ) * std::sqrt( x ) - 1 ) );
+
+    float sincos_error { 0 };
+    for( float x { -10.0f }; x < 10.0f; x += 0.001f )
+    {
+        float s, c;
+        math::FastMath::sincos( x, s, c );
+        sincos_error = std::max( sincos_error, std::max( std::fabs( s - std::sin( x ) ), std::fabs( c - std::cos( x ) ) ) );
+    }
+
+    std::vector<math::Vec3r> v
+    {
+        { 1, 0, 0 }, { 0, 2, 0 }, { 3, 4, 0 }, { 1, 1, 1 },
+        { -2, 5, 7 }, { 0.1f, 0.2f, -0.3f }, { 100, -50, 25 }
+    };
+    std::vector<math::Vec3r> unit( v );
+    math::normalize( unit.data(), unit.size() );
+
+    float normalize_error { 0 };
+    for( unsigned int i { 0 }; i < v.size(); ++i )
+        for( unsigned int j { 0 }; j < 3; ++j )
+            normalize_error = std::max( normalize_error, std::fabs( unit[i][j] - v[i][j] / v[i].norm() ) );
+
+    TestVector test_vec
+    {
+        { "FastMath::rsqrt relative error < 1e-6", rsqrt_error < 1e-6f },
+        { "FastMath::sincos error < 2e-6", sincos_error < 2e-6f },
+        { "normalize( Vec3r *, count ) error < 1e-6", normalize_error < 1e-6f },
+    };
+
+    return run_tests( "fast math", test_vec );
+}
+
+// Construits a la compilation
+constexpr math::Vec3r constant_vector( 1, 2, 3 );
+constexpr math::Vec4i constant_padded( 4, 5 );
+constexpr math::Mat44r constant_identity( math::Identity4r );
+
+int test_constexpr()
+{
+    bool identity { true };
+    for( unsigned int i { 0 }; i < 4; ++i )
+        for( unsigned int j { 0 }; j < 4; ++j )
+            identity = identity && constant_identity( i, j ) == ( i == j ? 1 : 0 ) && math::Identity4i( i, j ) == ( i == j ? 1 : 0 );
+
+    std::vector<math::Vec3r> copies( 3, constant_vector );
+    copies.reserve( 1000 );
+
+    TestVector test_vec
+    {
+        { "constexpr Vec3r( 1, 2, 3 )", constant_vector[0] == 1 && constant_vector[1] == 2 && constant_vector[2] == 3 },
+        { "constexpr Vec4i( 4, 5 )", constant_padded[0] == 4 && constant_padded[1] == 5 && constant_padded[2] == 0 && constant_padded[3] == 0 },
+        { "constexpr Identity4r, Identity4i", identity },
+        { "std::vector<Vec3r> reallocation", copies[2] == constant_vector },
+    };
+
+    return run_tests( "constexpr", test_vec );
+}
+
+// Compare chaque voie d'un paquet au calcul scalaire equivalent
+template<unsigned int W>
+bool check_packet_lanes( const std::vector<math::Vec3r> & a, const std::vector<math::Vec3r> & b )
+{
+    typedef math::Vec3Packet<real, W> V;
+    const V pa { V::gather( a.data() ) }, pb { V::gather( b.data() ) };
+    const math::Packet<real, W> dots { dot( pa, pb ) };
+    const V crosses { cross( pa, pb ) };
+
+    bool ok { true };
+    for( unsigned int i { 0 }; i < W; ++i )
+    {
+        ok = ok && std::fabs( dots[i] - a[i] * b[i] ) < 1e-5f;
+        ok = ok && math::Vec3r( crosses[i] - a[i].cross( b[i] ) ).norm() < 1e-5f;
+    }
+    return ok;
+}
+
+int test_packet()
+{
+    std::vector<math::Vec3r> a, b;
+    for( unsigned int i { 0 }; i < 8; ++i )
+    {
+        a.push_back( math::Vec3r( 0.5f * i - 1, 2.0f - i, 0.25f * i * i ) );
+        b.push_back( math::Vec3r( 1.0f + i, -0.5f * i, 3.0f - 0.1f * i ) );
+    }
+
+    // Chargement et ecriture coordonnee par coordonnee, alignes
+    alignas( 64 ) real x[8], y[8], z[8];
+    for( unsigned int i { 0 }; i < 8; ++i )
+    {
+        x[i] = a[i][0];
+        y[i] = a[i][1];
+        z[i] = a[i][2];
+    }
+    const math::Vec3x8 loaded { math::Vec3x8::load( x, y, z ) };
+    alignas( 64 ) real out[3][8];
+    ( loaded * 2.0f ).store( out[0], out[1], out[2] );
+    bool soa { true };
+    for( unsigned int i { 0 }; i < 8; ++i )
+        soa = soa && loaded[i] == a[i] && out[0][i] == 2 * x[i] && out[1][i] == 2 * y[i] && out[2][i] == 2 * z[i];
+
+    // Plan x + 2y + 2z - 3 = 0, normalise
+    const math::Vec4r equation( 1.0f / 3, 2.0f / 3, 2.0f / 3, -1 );
+    const math::PlanePacket<real, 8> plane { equation };
+    const math::Packet<real, 8> distances { plane.distance( loaded ) };
+    const math::Mask<real, 8> behind { plane.behind( loaded, 0.5f ) };
+    bool planes { true };
+    for( unsigned int i { 0 }; i < 8; ++i )
+    {
+        const float d { equation[0] * a[i][0] + equation[1] * a[i][1] + equation[2] * a[i][2] + equation[3] };
+        planes = planes && std::fabs( distances[i] - d ) < 1e-5f && behind[i] == ( d < -0.5f );
+    }
+
+    // Matrice diffusee : (p, 1) * M comme Transformation
+    const math::Mat44r m { { 0, 1, 0, 0 }, { -1, 0, 0, 0 }, { 0, 0, 2, 0 }, { 1, 2, 3, 1 } };
+    const math::Vec3x4 moved { math::Mat44Packet<real, 4>( m ).point( math::Vec3x4::gather( a.data() ) ) };
+    bool transform { true };
+    for( unsigned int i { 0 }; i < 4; ++i )
+    {
+        const math::Vec4r h { math::Vec4r( a[i][0], a[i][1], a[i][2], 1 ) * m };
+        transform = transform && moved[i] == math::Vec3r( h[0], h[1], h[2] );
+    }
+
+    // Masques et selection
+    const math::Packet<real, 8> lanes { math::Packet<real, 8>::loadu( x ) };
+    const math::Mask<real, 8> negative { lanes < 0.0f };
+    const math::Packet<real, 8> clamped { select( negative, math::Packet<real, 8>( 0.0f ), lanes ) };
+    bool masks { negative.bits() == 0x3 && negative.any() && !negative.all() && ( ~negative ).bits() == 0xfc
+                 && ( negative | ~negative ).all() && ( negative & ~negative ).none() };
+    for( unsigned int i { 0 }; i < 8; ++i )
+        masks = masks && clamped[i] == std::max( x[i], 0.0f ) && max( lanes, 0.0f )[i] == clamped[i];
+
+    const math::Packet<double, 3> generic { math::Packet<double, 3>( 4.0 ) * 2.0 - 1.0 };
+    const math::Packet<int, 5> integers { math::Packet<int, 5>( -3 ) };
+
+    TestVector test_vec
+    {
+        { "Vec3x4 dot, cross", check_packet_lanes<4>( a, b ) },
+        { "Vec3x8 dot, cross", check_packet_lanes<8>( a, b ) },
+        { "Vec3Packet<double, 3> dot, cross", check_packet_lanes<3>( a, b ) },
+        { "Vec3x8::load, store", soa },
+        { "PlanePacket::distance, behind", planes },
+        { "Mat44Packet::point", transform },
+        { "Mask, select, max", masks },
+        { "Packet<double, 3>, Packet<int, 5>", generic[2] == 7.0 && abs( integers )[4] == 3 && ( integers < 0 ).all() },
+    };
+
+    return run_tests( "packets", test_vec );
+}
+
+// Resultats de tous les noyaux de math::dispatch pour un meme jeu de donnees
+struct DispatchOutput
+{
+    std::vector<float> x, y, z, t0, t1, px, py;
+    std::vector<std::uint8_t> outside;
+
+    bool operator==( const DispatchOutput & o ) const
+    {
+        return same( x, o.x ) && same( y, o.y ) && same( z, o.z ) && same( t0, o.t0 ) && same( t1, o.t1 )
+               && same( px, o.px ) && same( py, o.py ) && outside == o.outside;
+    }
+
+    // Egalite au bit pres
+    static bool same( const std::vector<float> & a, const std::vector<float> & b )
+    {
+        return a.size() == b.size() && std::memcmp( a.data(), b.data(), a.size() * sizeof( float ) ) == 0;
+    }
+};
+
+DispatchOutput run_kernels( const math::dispatch::KernelTable & k, const std::vector<float> & in, const float * planes, const std::size_t count )
+{
+    const float mat[16] { 0.5f, 1, 0, 0, -1, 0.25f, 0, 0, 0, 0.1f, 2, 0, 1, 2, -3, 1 };
+    const float * bx { in.data() }, * by { bx + count }, * bz { by + count };
+    const float * ex { bz + count }, * ey { ex + count }, * ez { ey + count };
+
+    DispatchOutput out;
+    out.x.resize( count ), out.y.resize( count ), out.z.resize( count );
+    out.t0.resize( count ), out.t1.resize( count ), out.px.resize( count ), out.py.resize( count );
+    out.outside.resize( count );
+
+    k.transform_points( mat, bx, by, bz, out.x.data(), out.y.data(), out.z.data(), count );
+    k.spheres_outside( planes, 6, ex, ey, ez, bx, out.outside.data(), count );
+    k.clip_segments( planes, 6, bx, by, bz, ex, ey, ez, out.t0.data(), out.t1.data(), count );
+    k.project( 1.5f, bx, by, ez, out.px.data(), out.py.data(), count );
+
+    return out;
+}
+
+int test_dispatch()
+{
+    using math::dispatch::Isa;
+
+    // Boite [-1, 1]^3 decrite par six plans orientes vers l'interieur
+    const float planes[24] { 1, 0, 0, 1, -1, 0, 0, 1, 0, 1, 0, 1, 0, -1, 0, 1, 0, 0, 1, 1, 0, 0, -1, 1 };
+
+    // 6 coordonnees par element ; 37 elements pour tester les restes de chaque largeur
+    const std::size_t count { 37 };
+    std::vector<float> in( 6 * count );
+    for( std::size_t i { 0 }; i < in.size(); ++i )
+        in[i] = std::sin( 0.7f * i ) * 2.5f + ( i % 7 == 0 ? 0.5f : 0.0f );
+
+    const math::dispatch::KernelTable & scalar { math::dispatch::table( Isa::scalar ) };
+    const DispatchOutput reference { run_kernels( scalar, in, planes, count ) };
+
+    // Cas verifies a la main avec la version scalaire
+    const float bx[] { 0, -3, 0, 2 }, by[] { 0, 0, 0, 2 }, bz[] { 0, 0, 0, 2 };
+    const float ex[] { 0.5f, 3, 0, 3 }, ey[] { 0, 0, 0, 3 }, ez[] { 0, 0, 4, 3 };
+    float t0[4], t1[4];
+    scalar.clip_segments( planes, 6, bx, by, bz, ex, ey, ez, t0, t1, 4 );
+    const bool clip { t0[0] == 0 && t1[0] == 1 && std::fabs( t0[1] - 1.0f / 3 ) < 1e-6f && std::fabs( t1[1] - 2.0f / 3 ) < 1e-6f
+                      && t0[2] == 0 && t1[2] == 0.25f && t0[3] > t1[3] };
+
+    const float radius[] { 0.5f, 2.5f, 0.5f, 1 };
+    std::uint8_t outside[4];
+    scalar.spheres_outside( planes, 6, ex, ey, ez, radius, outside, 4 );
+    const bool spheres { outside[0] == 0 && outside[1] == 0 && outside[2] == 1 && outside[3] == 1 };
+
+    float px[4], py[4];
+    scalar.project( 2, ex, ey, ez, px, py, 4 );
+    const bool project { px[2] == 0 && px[3] == -2 && py[3] == -2 };
+
+    TestVector test_vec
+    {
+        { "scalar clip_segments", clip },
+        { "scalar spheres_outside", spheres },
+        { "scalar project", project },
+        { "kernels() supported", math::dispatch::supported( math::dispatch::kernels().isa ) },
+    };
+
+    // Chaque variante supportee est imposee et doit reproduire la version scalaire au bit pres
+    const Isa initial { math::dispatch::kernels().isa };
+    for( Isa isa : { Isa::sse2, Isa::avx2, Isa::avx512 } )
+    {
+        if( !math::dispatch::select( isa ) )
+        {
+            std::cout << "(" << math::dispatch::name( isa ) << " not supported) ";
+            continue;
+        }
+        test_vec.push_back( { std::string( math::dispatch::name( isa ) ) + " == scalar",
+                              math::dispatch::kernels().isa == isa && run_kernels( math::dispatch::kernels(), in, planes, count ) == reference } );
+    }
+    math::dispatch::select( initial );
+
+    return run_tests( "dispatch", test_vec );
+}
+
 int main()
 {
     int failures { 0 };
@@ -298,6 +584,11 @@ int main()
     failures += test_dot1();
     failures += test_dot2();
     failures += test_cross();
+    failures += test_expression();
+    failures += test_fast_math();
+    failures += test_constexpr();
+    failures += test_packet();
+    failures += test_dispatch();
     failures += test_operator_putout();
 
     if( failures > 0 )